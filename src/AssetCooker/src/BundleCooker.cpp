@@ -0,0 +1,283 @@
+#include "BundleCooker.h"
+#include "SkylinePacker.h"
+#include <Core/AssetBundleFormat.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <numeric>
+
+using namespace AssetBundleFormat;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+struct Placement
+{
+  uint32_t atlasIndex;
+  uint32_t x;
+  uint32_t y;
+};
+
+struct Atlas
+{
+  uint32_t width{0};
+  uint32_t height{0};
+  std::vector<uint8_t> pixels{};
+};
+
+uint32_t nextPowerOfTwo(uint32_t value)
+{
+  uint32_t result = 1;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
+/**
+ * Copies the sprite into the atlas and repeats its edge pixels into the
+ * padding so that bilinear filtering doesn't bleed neighbouring sprites.
+ */
+void blit(AssetCooker::Image const & image, Atlas & atlas, uint32_t x,
+          uint32_t y, uint32_t padding)
+{
+  uint32_t const paddedHeight = image.height + 2 * padding;
+  for (uint32_t row = 0; row < paddedHeight; ++row)
+  {
+    uint32_t const sourceRow =
+        std::min(image.height - 1, row > padding ? row - padding : 0u);
+    uint8_t const * pSourceRow = &image.pixels[size_t(sourceRow) * image.width * 4];
+    uint8_t * pTarget = &atlas.pixels[(size_t(y + row) * atlas.width + x) * 4];
+    for (uint32_t i = 0; i < padding; ++i, pTarget += 4)
+      std::copy(pSourceRow, pSourceRow + 4, pTarget);
+    pTarget = std::copy(pSourceRow, pSourceRow + size_t(image.width) * 4, pTarget);
+    uint8_t const * pLastPixel = pSourceRow + (size_t(image.width) - 1) * 4;
+    for (uint32_t i = 0; i < padding; ++i, pTarget += 4)
+      std::copy(pLastPixel, pLastPixel + 4, pTarget);
+  }
+}
+
+void writeZeros(std::ofstream & file, uint64_t count)
+{
+  static char const zeros[4096] = {};
+  while (count > 0)
+  {
+    uint64_t const chunk = std::min<uint64_t>(count, sizeof(zeros));
+    file.write(zeros, static_cast<std::streamsize>(chunk));
+    count -= chunk;
+  }
+}
+
+bool writeUvTable(std::string const & filename,
+                  std::vector<AssetCooker::SpriteSource> const & sprites,
+                  std::vector<SpriteEntry> const & entries)
+{
+  std::ofstream file(filename);
+  if (!file)
+    return false;
+  file << "name,hash,atlas,x,y,width,height,u0,v0,u1,v1\n";
+  for (size_t i = 0; i < sprites.size(); ++i)
+  {
+    SpriteEntry const & entry = entries[i];
+    file << sprites[i].name << ',' << entry.nameHash << ',' << entry.atlasIndex
+         << ',' << entry.x << ',' << entry.y << ',' << entry.width << ','
+         << entry.height << ',' << entry.u0 << ',' << entry.v0 << ','
+         << entry.u1 << ',' << entry.v1 << '\n';
+  }
+  return static_cast<bool>(file);
+}
+
+} // namespace
+
+bool AssetCooker::cookBundle(std::vector<SpriteSource> const & sprites,
+                             CookOptions const & options,
+                             std::string const & bundleFilename,
+                             CookStatistics & statistics, std::string & error)
+{
+  statistics = CookStatistics();
+  statistics.numberOfSprites = sprites.size();
+  uint32_t const padding = options.padding;
+  if (options.atlasSize == 0 || options.atlasSize > MAXIMUM_ATLAS_SIZE ||
+      uint64_t{2} * padding >= options.atlasSize)
+  {
+    error = "The atlas size must be between 1 and " +
+            std::to_string(MAXIMUM_ATLAS_SIZE) +
+            " and larger than twice the padding.";
+    return false;
+  }
+
+  // pack the tallest sprites first, that's what the skyline is good at
+  Clock::time_point start = Clock::now();
+  std::vector<size_t> order(sprites.size());
+  std::iota(order.begin(), order.end(), size_t(0));
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    Image const & imageA = sprites[a].image;
+    Image const & imageB = sprites[b].image;
+    if (imageA.height != imageB.height)
+      return imageA.height > imageB.height;
+    return imageA.width > imageB.width;
+  });
+
+  std::vector<std::unique_ptr<SkylinePacker>> packers;
+  std::vector<Placement> placements(sprites.size());
+  for (size_t index : order)
+  {
+    Image const & image = sprites[index].image;
+    if (image.width == 0 || image.height == 0 ||
+        image.width > 0xffff || image.height > 0xffff)
+    {
+      error = "Sprite '" + sprites[index].name + "' has an invalid size.";
+      return false;
+    }
+    uint32_t const width = image.width + 2 * padding;
+    uint32_t const height = image.height + 2 * padding;
+    if (width > options.atlasSize || height > options.atlasSize)
+    {
+      error = "Sprite '" + sprites[index].name + "' doesn't fit into an atlas.";
+      return false;
+    }
+    Placement & placement = placements[index];
+    bool isPlaced = false;
+    for (size_t i = 0; i < packers.size() && !isPlaced; ++i)
+    {
+      isPlaced = packers[i]->insert(width, height, placement.x, placement.y);
+      placement.atlasIndex = static_cast<uint32_t>(i);
+    }
+    if (!isPlaced)
+    {
+      packers.emplace_back(
+          new SkylinePacker(options.atlasSize, options.atlasSize));
+      packers.back()->insert(width, height, placement.x, placement.y);
+      placement.atlasIndex = static_cast<uint32_t>(packers.size() - 1);
+    }
+  }
+  statistics.packSeconds = secondsSince(start);
+
+  // compose the atlases, the last one is usually only partially filled
+  start = Clock::now();
+  std::vector<Atlas> atlases(packers.size());
+  uint64_t usedArea = 0;
+  uint64_t totalArea = 0;
+  for (size_t i = 0; i < atlases.size(); ++i)
+  {
+    atlases[i].width = options.atlasSize;
+    atlases[i].height = std::min(
+        options.atlasSize, nextPowerOfTwo(packers[i]->getUsedHeight()));
+    atlases[i].pixels.assign(size_t(atlases[i].width) * atlases[i].height * 4,
+                             0);
+    usedArea += static_cast<uint64_t>(packers[i]->getOccupancy() *
+                                      options.atlasSize * options.atlasSize);
+    totalArea += uint64_t(atlases[i].width) * atlases[i].height;
+  }
+  std::vector<SpriteEntry> entries(sprites.size());
+  for (size_t i = 0; i < sprites.size(); ++i)
+  {
+    Image const & image = sprites[i].image;
+    Placement const & placement = placements[i];
+    Atlas & atlas = atlases[placement.atlasIndex];
+    blit(image, atlas, placement.x, placement.y, padding);
+
+    SpriteEntry & entry = entries[i];
+    entry = SpriteEntry();
+    entry.nameHash = hashName(sprites[i].name.data(), sprites[i].name.size());
+    entry.atlasIndex = placement.atlasIndex;
+    entry.x = static_cast<uint16_t>(placement.x + padding);
+    entry.y = static_cast<uint16_t>(placement.y + padding);
+    entry.width = static_cast<uint16_t>(image.width);
+    entry.height = static_cast<uint16_t>(image.height);
+    entry.u0 = float(entry.x) / float(atlas.width);
+    entry.v0 = float(entry.y) / float(atlas.height);
+    entry.u1 = float(entry.x + entry.width) / float(atlas.width);
+    entry.v1 = float(entry.y + entry.height) / float(atlas.height);
+  }
+  statistics.composeSeconds = secondsSince(start);
+  statistics.numberOfAtlases = atlases.size();
+  statistics.occupancy = totalArea > 0 ? double(usedArea) / double(totalArea) : 0.0;
+
+  if (!options.uvTableFilename.empty() &&
+      !writeUvTable(options.uvTableFilename, sprites, entries))
+  {
+    error = "Couldn't write the UV table '" + options.uvTableFilename + "'.";
+    return false;
+  }
+
+  // the runtime looks sprites up with a binary search over the hashes
+  std::sort(entries.begin(), entries.end(),
+            [](SpriteEntry const & a, SpriteEntry const & b) {
+              return a.nameHash < b.nameHash;
+            });
+  for (size_t i = 1; i < entries.size(); ++i)
+  {
+    if (entries[i - 1].nameHash == entries[i].nameHash)
+    {
+      error = "Two sprites share the same name hash.";
+      return false;
+    }
+  }
+
+  // lay out and write the bundle
+  start = Clock::now();
+  Header header = Header();
+  header.magic = MAGIC;
+  header.version = VERSION;
+  header.numberOfAtlases = static_cast<uint32_t>(atlases.size());
+  header.numberOfSprites = static_cast<uint32_t>(entries.size());
+  header.atlasTableOffset = align(sizeof(Header), TABLE_ALIGNMENT);
+  header.spriteTableOffset =
+      align(header.atlasTableOffset + atlases.size() * sizeof(AtlasEntry),
+            TABLE_ALIGNMENT);
+  uint64_t offset = header.spriteTableOffset + entries.size() * sizeof(SpriteEntry);
+  std::vector<AtlasEntry> atlasEntries(atlases.size());
+  for (size_t i = 0; i < atlases.size(); ++i)
+  {
+    AtlasEntry & entry = atlasEntries[i];
+    entry = AtlasEntry();
+    entry.width = atlases[i].width;
+    entry.height = atlases[i].height;
+    entry.pixelFormat = PIXEL_FORMAT_RGBA8;
+    entry.dataOffset = align(offset, DATA_ALIGNMENT);
+    entry.dataSize = atlases[i].pixels.size();
+    offset = entry.dataOffset + entry.dataSize;
+  }
+  header.fileSize = offset;
+
+  std::ofstream file(bundleFilename, std::ios::binary | std::ios::trunc);
+  if (!file)
+  {
+    error = "Couldn't open '" + bundleFilename + "' for writing.";
+    return false;
+  }
+  uint64_t position = 0;
+  auto writeAt = [&](uint64_t target, void const * pData, size_t size) {
+    writeZeros(file, target - position);
+    file.write(static_cast<char const *>(pData),
+               static_cast<std::streamsize>(size));
+    position = target + size;
+  };
+  writeAt(0, &header, sizeof(header));
+  writeAt(header.atlasTableOffset, atlasEntries.data(),
+          atlasEntries.size() * sizeof(AtlasEntry));
+  writeAt(header.spriteTableOffset, entries.data(),
+          entries.size() * sizeof(SpriteEntry));
+  for (size_t i = 0; i < atlases.size(); ++i)
+  {
+    writeAt(atlasEntries[i].dataOffset, atlases[i].pixels.data(),
+            atlases[i].pixels.size());
+  }
+  file.close();
+  if (!file)
+  {
+    error = "Couldn't write '" + bundleFilename + "'.";
+    return false;
+  }
+  statistics.writeSeconds = secondsSince(start);
+  statistics.fileSize = header.fileSize;
+  return true;
+}
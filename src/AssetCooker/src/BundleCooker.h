@@ -0,0 +1,67 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Packs decoded sprites into texture atlases and writes them, together with
+ * the sprite lookup table, into a single bundle file that the runtime maps
+ * with AssetBundle.
+ */
+
+#pragma once
+
+#include "Image.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AssetCooker
+{
+
+struct SpriteSource
+{
+  /** The name the runtime uses to look the sprite up. */
+  std::string name{};
+
+  Image image{};
+};
+
+struct CookOptions
+{
+  /** The maximum width and height of an atlas. */
+  uint32_t atlasSize{2048};
+
+  /** The border around each sprite filled with its edge pixels. */
+  uint32_t padding{1};
+
+  /** If not empty a CSV file with all sprite rectangles and UVs is written. */
+  std::string uvTableFilename{};
+};
+
+struct CookStatistics
+{
+  size_t numberOfSprites{0};
+
+  size_t numberOfAtlases{0};
+
+  uint64_t fileSize{0};
+
+  /** Covered area of all atlases relative to their total area. */
+  double occupancy{0.0};
+
+  double packSeconds{0.0};
+
+  double composeSeconds{0.0};
+
+  double writeSeconds{0.0};
+};
+
+/**
+ * Cooks the sprites into the bundle file.
+ * Returns false and sets the error message if cooking failed.
+ */
+bool cookBundle(std::vector<SpriteSource> const & sprites,
+                CookOptions const & options,
+                std::string const & bundleFilename,
+                CookStatistics & statistics, std::string & error);
+
+} // namespace AssetCooker
@@ -0,0 +1,240 @@
+#include "Image.h"
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+namespace
+{
+
+std::string getExtension(std::string const & filename)
+{
+  size_t const dot = filename.find_last_of('.');
+  if (dot == std::string::npos)
+    return std::string();
+  std::string extension = filename.substr(dot + 1);
+  std::transform(extension.begin(), extension.end(), extension.begin(),
+                 [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+  return extension;
+}
+
+bool readFile(std::string const & filename, std::vector<uint8_t> & data)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+    return false;
+  data.assign(std::istreambuf_iterator<char>(file),
+              std::istreambuf_iterator<char>());
+  return true;
+}
+
+/** Reads the next whitespace separated token of a netpbm header. */
+bool readToken(std::vector<uint8_t> const & data, size_t & pos,
+               std::string & token)
+{
+  token.clear();
+  while (pos < data.size())
+  {
+    if (data[pos] == '#')
+    {
+      while (pos < data.size() && data[pos] != '\n')
+        ++pos;
+    }
+    else if (std::isspace(data[pos]))
+    {
+      ++pos;
+    }
+    else
+    {
+      break;
+    }
+  }
+  while (pos < data.size() && !std::isspace(data[pos]))
+  {
+    token.push_back(static_cast<char>(data[pos]));
+    ++pos;
+  }
+  return !token.empty();
+}
+
+/** Parses a decimal header value, returns false if it's malformed. */
+bool parseNumber(std::string const & token, uint32_t & value)
+{
+  char const * pEnd = token.data() + token.size();
+  std::from_chars_result const result =
+      std::from_chars(token.data(), pEnd, value);
+  return result.ec == std::errc() && result.ptr == pEnd;
+}
+
+/** Netpbm sizes are limited like TGA ones, so pixel counts can't overflow. */
+bool isValidSize(uint32_t width, uint32_t height)
+{
+  return width > 0 && width <= 0xffff && height > 0 && height <= 0xffff;
+}
+
+bool loadPpm(std::vector<uint8_t> const & data, AssetCooker::Image & image)
+{
+  size_t pos = 0;
+  std::string token;
+  if (!readToken(data, pos, token) || token != "P6")
+    return false;
+  uint32_t values[3];
+  for (uint32_t & value : values)
+  {
+    if (!readToken(data, pos, token) || !parseNumber(token, value))
+      return false;
+  }
+  ++pos; // single whitespace before the raster
+  if (values[2] != 255 || !isValidSize(values[0], values[1]))
+    return false;
+  image.width = values[0];
+  image.height = values[1];
+  size_t const numberOfPixels = size_t(image.width) * image.height;
+  if (pos + numberOfPixels * 3 > data.size())
+    return false;
+  image.pixels.resize(numberOfPixels * 4);
+  for (size_t i = 0; i < numberOfPixels; ++i)
+  {
+    image.pixels[i * 4 + 0] = data[pos + i * 3 + 0];
+    image.pixels[i * 4 + 1] = data[pos + i * 3 + 1];
+    image.pixels[i * 4 + 2] = data[pos + i * 3 + 2];
+    image.pixels[i * 4 + 3] = 255;
+  }
+  return true;
+}
+
+bool loadPam(std::vector<uint8_t> const & data, AssetCooker::Image & image)
+{
+  size_t pos = 0;
+  std::string token;
+  if (!readToken(data, pos, token) || token != "P7")
+    return false;
+  uint32_t depth = 0;
+  uint32_t maxValue = 0;
+  while (readToken(data, pos, token) && token != "ENDHDR")
+  {
+    std::string value;
+    if (!readToken(data, pos, value))
+      return false;
+    uint32_t * pTarget = nullptr;
+    if (token == "WIDTH")
+      pTarget = &image.width;
+    else if (token == "HEIGHT")
+      pTarget = &image.height;
+    else if (token == "DEPTH")
+      pTarget = &depth;
+    else if (token == "MAXVAL")
+      pTarget = &maxValue;
+    if (pTarget != nullptr && !parseNumber(value, *pTarget))
+      return false;
+  }
+  ++pos; // newline after ENDHDR
+  if (maxValue != 255 || (depth != 3 && depth != 4) ||
+      !isValidSize(image.width, image.height))
+    return false;
+  size_t const numberOfPixels = size_t(image.width) * image.height;
+  if (pos + numberOfPixels * depth > data.size())
+    return false;
+  image.pixels.resize(numberOfPixels * 4);
+  for (size_t i = 0; i < numberOfPixels; ++i)
+  {
+    uint8_t const * pSource = &data[pos + i * depth];
+    image.pixels[i * 4 + 0] = pSource[0];
+    image.pixels[i * 4 + 1] = pSource[1];
+    image.pixels[i * 4 + 2] = pSource[2];
+    image.pixels[i * 4 + 3] = depth == 4 ? pSource[3] : 255;
+  }
+  return true;
+}
+
+bool loadTga(std::vector<uint8_t> const & data, AssetCooker::Image & image)
+{
+  if (data.size() < 18)
+    return false;
+  uint8_t const idLength = data[0];
+  uint8_t const colorMapType = data[1];
+  uint8_t const imageType = data[2];
+  uint32_t const width = data[12] | (data[13] << 8);
+  uint32_t const height = data[14] | (data[15] << 8);
+  uint8_t const bitsPerPixel = data[16];
+  bool const isTopToBottom = (data[17] & 0x20) != 0;
+  if (colorMapType != 0 || (imageType != 2 && imageType != 10) ||
+      (bitsPerPixel != 24 && bitsPerPixel != 32))
+    return false;
+
+  size_t const bytesPerPixel = bitsPerPixel / 8;
+  size_t const numberOfPixels = size_t(width) * height;
+  size_t pos = 18 + idLength;
+  image.width = width;
+  image.height = height;
+  image.pixels.resize(numberOfPixels * 4);
+
+  auto storePixel = [&](size_t index, uint8_t const * pSource) {
+    // TGA stores BGR(A) with the bottom row first unless flagged otherwise
+    size_t const row = index / width;
+    size_t const column = index % width;
+    size_t const targetRow = isTopToBottom ? row : height - 1 - row;
+    uint8_t * pTarget = &image.pixels[(targetRow * width + column) * 4];
+    pTarget[0] = pSource[2];
+    pTarget[1] = pSource[1];
+    pTarget[2] = pSource[0];
+    pTarget[3] = bytesPerPixel == 4 ? pSource[3] : 255;
+  };
+
+  size_t index = 0;
+  while (index < numberOfPixels)
+  {
+    size_t count = 1;
+    bool isRun = false;
+    if (imageType == 10)
+    {
+      if (pos >= data.size())
+        return false;
+      isRun = (data[pos] & 0x80) != 0;
+      count = (data[pos] & 0x7f) + 1u;
+      ++pos;
+    }
+    count = std::min(count, numberOfPixels - index);
+    if (isRun)
+    {
+      if (pos + bytesPerPixel > data.size())
+        return false;
+      for (size_t i = 0; i < count; ++i)
+        storePixel(index++, &data[pos]);
+      pos += bytesPerPixel;
+    }
+    else
+    {
+      if (pos + count * bytesPerPixel > data.size())
+        return false;
+      for (size_t i = 0; i < count; ++i, pos += bytesPerPixel)
+        storePixel(index++, &data[pos]);
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+bool AssetCooker::isSupportedImage(std::string const & filename)
+{
+  std::string const extension = getExtension(filename);
+  return extension == "ppm" || extension == "pam" || extension == "tga";
+}
+
+bool AssetCooker::loadImage(std::string const & filename, Image & image)
+{
+  std::vector<uint8_t> data;
+  if (!readFile(filename, data))
+    return false;
+  std::string const extension = getExtension(filename);
+  if (extension == "ppm")
+    return loadPpm(data, image);
+  if (extension == "pam")
+    return loadPam(data, image);
+  if (extension == "tga")
+    return loadTga(data, image);
+  return false;
+}
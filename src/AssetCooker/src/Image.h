@@ -0,0 +1,39 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Minimal source image loading for the cooker. Only formats that need no
+ * third party decoder are supported: binary PPM (P6), PAM (P7) with RGB or
+ * RGB_ALPHA tuples and uncompressed or RLE compressed true color TGA.
+ * All images are converted to RGBA8.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace AssetCooker
+{
+
+struct Image
+{
+  uint32_t width{0};
+
+  uint32_t height{0};
+
+  /** Tightly packed RGBA8 pixels, top row first. */
+  std::vector<uint8_t> pixels{};
+};
+
+/**
+ * Loads the image file into the given image.
+ * Returns false if the file could not be read or the format is unsupported.
+ */
+bool loadImage(std::string const & filename, Image & image);
+
+/** Returns true if the file extension belongs to a supported image format. */
+bool isSupportedImage(std::string const & filename);
+
+} // namespace AssetCooker
@@ -0,0 +1,112 @@
+#include "SkylinePacker.h"
+#include <algorithm>
+#include <limits>
+
+AssetCooker::SkylinePacker::SkylinePacker(uint32_t width, uint32_t height)
+    : m_width(width), m_height(height)
+{
+  m_skyline.push_back(Segment{0, 0, width});
+}
+
+bool AssetCooker::SkylinePacker::insert(uint32_t width, uint32_t height,
+                                        uint32_t & x, uint32_t & y)
+{
+  uint32_t bestTop = std::numeric_limits<uint32_t>::max();
+  uint32_t bestWidth = std::numeric_limits<uint32_t>::max();
+  size_t bestIndex = m_skyline.size();
+  for (size_t i = 0; i < m_skyline.size(); ++i)
+  {
+    uint32_t top = 0;
+    if (fits(i, width, height, top))
+    {
+      top += height;
+      // prefer the lowest top edge, then the narrowest segment
+      if (top < bestTop || (top == bestTop && m_skyline[i].width < bestWidth))
+      {
+        bestTop = top;
+        bestWidth = m_skyline[i].width;
+        bestIndex = i;
+      }
+    }
+  }
+  if (bestIndex == m_skyline.size())
+    return false;
+
+  x = m_skyline[bestIndex].x;
+  y = bestTop - height;
+  addSegment(bestIndex, x, y, width, height);
+  m_usedHeight = std::max(m_usedHeight, bestTop);
+  m_usedArea += uint64_t(width) * height;
+  return true;
+}
+
+uint32_t AssetCooker::SkylinePacker::getUsedHeight() const
+{
+  return m_usedHeight;
+}
+
+double AssetCooker::SkylinePacker::getOccupancy() const
+{
+  return double(m_usedArea) / (double(m_width) * double(m_height));
+}
+
+bool AssetCooker::SkylinePacker::fits(size_t index, uint32_t width,
+                                      uint32_t height, uint32_t & y) const
+{
+  uint32_t const x = m_skyline[index].x;
+  if (x + width > m_width)
+    return false;
+  // the rectangle rests on the highest segment it spans
+  uint32_t widthLeft = width;
+  y = m_skyline[index].y;
+  while (widthLeft > 0)
+  {
+    if (index == m_skyline.size())
+      return false;
+    y = std::max(y, m_skyline[index].y);
+    if (y + height > m_height)
+      return false;
+    widthLeft -= std::min(widthLeft, m_skyline[index].width);
+    ++index;
+  }
+  return true;
+}
+
+void AssetCooker::SkylinePacker::addSegment(size_t index, uint32_t x,
+                                            uint32_t y, uint32_t width,
+                                            uint32_t height)
+{
+  m_skyline.insert(m_skyline.begin() + index, Segment{x, y + height, width});
+
+  // shrink or remove the segments now covered by the new one
+  uint32_t const right = x + width;
+  size_t i = index + 1;
+  while (i < m_skyline.size() && m_skyline[i].x < right)
+  {
+    uint32_t const segmentRight = m_skyline[i].x + m_skyline[i].width;
+    if (segmentRight <= right)
+    {
+      m_skyline.erase(m_skyline.begin() + i);
+    }
+    else
+    {
+      m_skyline[i].width = segmentRight - right;
+      m_skyline[i].x = right;
+      break;
+    }
+  }
+
+  // merge neighbouring segments of equal height
+  for (size_t j = 0; j + 1 < m_skyline.size();)
+  {
+    if (m_skyline[j].y == m_skyline[j + 1].y)
+    {
+      m_skyline[j].width += m_skyline[j + 1].width;
+      m_skyline.erase(m_skyline.begin() + j + 1);
+    }
+    else
+    {
+      ++j;
+    }
+  }
+}
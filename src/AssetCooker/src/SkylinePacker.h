@@ -0,0 +1,67 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Rectangle packer for a single texture atlas using the skyline
+ * bottom-left heuristic. The skyline is the upper contour of all placed
+ * rectangles. New rectangles are placed on the skyline segment that keeps
+ * their top edge lowest, which packs sprites sorted by height tightly at a
+ * cost linear in the number of skyline segments.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace AssetCooker
+{
+
+class SkylinePacker final
+{
+public:
+  SkylinePacker(uint32_t width, uint32_t height);
+
+  /**
+   * Places a rectangle of the given size and returns its position.
+   * If the rectangle doesn't fit anymore the method returns false.
+   */
+  bool insert(uint32_t width, uint32_t height, uint32_t & x, uint32_t & y);
+
+  /** Returns the lowest height that contains all placed rectangles. */
+  uint32_t getUsedHeight() const;
+
+  /** Returns the ratio of the covered area to the atlas area. */
+  double getOccupancy() const;
+
+private:
+  struct Segment
+  {
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+  };
+
+  /**
+   * Checks if the rectangle fits at the start of the given segment and
+   * returns the y coordinate it would be placed at.
+   */
+  bool fits(size_t index, uint32_t width, uint32_t height, uint32_t & y) const;
+
+  /** Adds the placed rectangle to the skyline. */
+  void addSegment(size_t index, uint32_t x, uint32_t y, uint32_t width,
+                  uint32_t height);
+
+  uint32_t m_width;
+
+  uint32_t m_height;
+
+  uint32_t m_usedHeight{0};
+
+  uint64_t m_usedArea{0};
+
+  std::vector<Segment> m_skyline{};
+};
+
+} // namespace AssetCooker
@@ -0,0 +1,264 @@
+#include "BundleCooker.h"
+#include "Image.h"
+#include <Core/AssetBundle.h>
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace AssetCooker;
+
+namespace fs = std::filesystem;
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+double millisecondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+/** Parses a decimal number, returns false if it's malformed or too large. */
+bool parseNumber(std::string const & text, uint32_t & value)
+{
+  char const * pEnd = text.data() + text.size();
+  std::from_chars_result const result =
+      std::from_chars(text.data(), pEnd, value);
+  return result.ec == std::errc() && result.ptr == pEnd;
+}
+
+void printUsage()
+{
+  std::cout << "Usage: AssetCooker [options] <output.bundle> <input>...\n"
+               "       AssetCooker --benchmark [numberOfSprites]\n"
+               "Inputs are image files (ppm, pam, tga) or directories that\n"
+               "are searched recursively. Sprites are named by their path\n"
+               "relative to the input directory without extension.\n"
+               "Options:\n"
+               "  --atlas-size <n>   maximum atlas width and height (2048),\n"
+               "                     at most 65535\n"
+               "  --padding <n>      extruded border around sprites (1)\n"
+               "  --uv-table <file>  also write the UV lookup table as CSV\n";
+}
+
+bool addSprite(fs::path const & file, std::string const & name,
+               std::vector<SpriteSource> & sprites)
+{
+  SpriteSource sprite;
+  sprite.name = name;
+  if (!loadImage(file.string(), sprite.image))
+  {
+    std::cout << "Couldn't load image '" << file.string() << "'." << std::endl;
+    return false;
+  }
+  sprites.push_back(std::move(sprite));
+  return true;
+}
+
+bool collectSprites(fs::path const & input, std::vector<SpriteSource> & sprites)
+{
+  if (fs::is_regular_file(input))
+  {
+    return addSprite(input, input.stem().generic_string(), sprites);
+  }
+  if (!fs::is_directory(input))
+  {
+    std::cout << "Input '" << input.string() << "' doesn't exist." << std::endl;
+    return false;
+  }
+  std::vector<fs::path> files;
+  for (auto const & entry : fs::recursive_directory_iterator(input))
+  {
+    if (entry.is_regular_file() && isSupportedImage(entry.path().string()))
+      files.push_back(entry.path());
+  }
+  // directory iteration order is unspecified, keep the bundle reproducible
+  std::sort(files.begin(), files.end());
+  for (fs::path const & file : files)
+  {
+    fs::path name = fs::relative(file, input);
+    name.replace_extension();
+    if (!addSprite(file, name.generic_string(), sprites))
+      return false;
+  }
+  return true;
+}
+
+void printStatistics(CookStatistics const & statistics)
+{
+  std::cout << "Cooked " << statistics.numberOfSprites << " sprites into "
+            << statistics.numberOfAtlases << " atlases, "
+            << statistics.fileSize / 1024 << " KiB, "
+            << static_cast<int>(statistics.occupancy * 100.0)
+            << "% occupancy." << std::endl;
+  std::cout << "  pack:    " << statistics.packSeconds * 1000.0 << " ms\n"
+            << "  compose: " << statistics.composeSeconds * 1000.0 << " ms\n"
+            << "  write:   " << statistics.writeSeconds * 1000.0 << " ms"
+            << std::endl;
+}
+
+/**
+ * Cooks a bundle of synthetic sprites and measures how long it takes to
+ * cook it and to open it and resolve every sprite at runtime.
+ */
+int runBenchmark(size_t numberOfSprites)
+{
+  std::mt19937 random(42);
+  std::uniform_int_distribution<uint32_t> size(8, 64);
+  std::vector<SpriteSource> sprites(numberOfSprites);
+  for (size_t i = 0; i < numberOfSprites; ++i)
+  {
+    SpriteSource & sprite = sprites[i];
+    sprite.name = "sprite_" + std::to_string(i);
+    sprite.image.width = size(random);
+    sprite.image.height = size(random);
+    sprite.image.pixels.resize(size_t(sprite.image.width) *
+                                   sprite.image.height * 4,
+                               static_cast<uint8_t>(i));
+  }
+
+  fs::path const filename =
+      fs::temp_directory_path() / "AssetCookerBenchmark.bundle";
+  CookOptions options;
+  CookStatistics statistics;
+  std::string error;
+  Clock::time_point start = Clock::now();
+  if (!cookBundle(sprites, options, filename.string(), statistics, error))
+  {
+    std::cout << error << std::endl;
+    return EXIT_FAILURE;
+  }
+  double const cookMilliseconds = millisecondsSince(start);
+  printStatistics(statistics);
+  std::cout << "  total:   " << cookMilliseconds << " ms" << std::endl;
+
+  size_t const iterations = 20;
+  double openMilliseconds = 0.0;
+  double lookupMilliseconds = 0.0;
+  double touchMilliseconds = 0.0;
+  uint64_t checksum = 0;
+  for (size_t iteration = 0; iteration < iterations; ++iteration)
+  {
+    AssetBundle bundle;
+    start = Clock::now();
+    if (!bundle.open(filename.string()))
+    {
+      std::cout << "Couldn't open the cooked bundle." << std::endl;
+      return EXIT_FAILURE;
+    }
+    openMilliseconds += millisecondsSince(start);
+
+    start = Clock::now();
+    for (SpriteSource const & sprite : sprites)
+    {
+      AssetBundleFormat::SpriteEntry const * pSprite =
+          bundle.findSprite(sprite.name);
+      if (pSprite == nullptr)
+      {
+        std::cout << "Sprite '" << sprite.name << "' is missing." << std::endl;
+        return EXIT_FAILURE;
+      }
+      checksum += pSprite->x;
+    }
+    lookupMilliseconds += millisecondsSince(start);
+
+    // what an upload would read: every page of every atlas
+    start = Clock::now();
+    for (size_t i = 0; i < bundle.getNumberOfAtlases(); ++i)
+    {
+      uint8_t const * pPixels =
+          static_cast<uint8_t const *>(bundle.getAtlasPixels(i));
+      uint64_t const size = bundle.getAtlas(i).dataSize;
+      for (uint64_t offset = 0; offset < size; offset += 4096)
+        checksum += pPixels[offset];
+    }
+    touchMilliseconds += millisecondsSince(start);
+  }
+  std::cout << "Load (average of " << iterations << " runs):\n"
+            << "  open:    " << openMilliseconds / iterations << " ms\n"
+            << "  lookup:  " << lookupMilliseconds / iterations << " ms for "
+            << numberOfSprites << " sprites\n"
+            << "  touch:   " << touchMilliseconds / iterations
+            << " ms for all atlas pages\n"
+            << "  (checksum " << checksum << ")" << std::endl;
+  fs::remove(filename);
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+  std::vector<std::string> arguments(argv + 1, argv + argc);
+  if (!arguments.empty() && arguments[0] == "--benchmark")
+  {
+    uint32_t numberOfSprites = 10000;
+    if (arguments.size() > 1 && !parseNumber(arguments[1], numberOfSprites))
+    {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    return runBenchmark(numberOfSprites);
+  }
+
+  CookOptions options;
+  std::vector<std::string> positional;
+  for (size_t i = 0; i < arguments.size(); ++i)
+  {
+    std::string const & argument = arguments[i];
+    bool const hasValue = i + 1 < arguments.size();
+    bool isValid = true;
+    if (argument == "--atlas-size" && hasValue)
+      isValid = parseNumber(arguments[++i], options.atlasSize) &&
+                options.atlasSize > 0 &&
+                options.atlasSize <= AssetBundleFormat::MAXIMUM_ATLAS_SIZE;
+    else if (argument == "--padding" && hasValue)
+      isValid = parseNumber(arguments[++i], options.padding);
+    else if (argument == "--uv-table" && hasValue)
+      options.uvTableFilename = arguments[++i];
+    else if (argument.compare(0, 2, "--") == 0)
+    {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    else
+      positional.push_back(argument);
+    if (!isValid)
+    {
+      std::cout << "Invalid value '" << arguments[i] << "' for " << argument
+                << "." << std::endl;
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (positional.size() < 2)
+  {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+
+  std::vector<SpriteSource> sprites;
+  for (size_t i = 1; i < positional.size(); ++i)
+  {
+    if (!collectSprites(positional[i], sprites))
+      return EXIT_FAILURE;
+  }
+
+  CookStatistics statistics;
+  std::string error;
+  if (!cookBundle(sprites, options, positional[0], statistics, error))
+  {
+    std::cout << error << std::endl;
+    return EXIT_FAILURE;
+  }
+  printStatistics(statistics);
+  return EXIT_SUCCESS;
+}
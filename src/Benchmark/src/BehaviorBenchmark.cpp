@@ -0,0 +1,108 @@
+#include "Benchmarks.h"
+#include <Core/Behavior.h>
+#include <Core/SceneObject.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+
+namespace
+{
+
+/** The classic way: poll a cooldown timer in every update. */
+class PollingEnemy : public Component
+{
+public:
+  explicit PollingEnemy(double cooldown) : m_cooldown(cooldown) {}
+
+  void update(double deltaTime) override
+  {
+    m_timer += deltaTime;
+    if (m_timer >= m_cooldown)
+    {
+      m_timer = 0.0;
+      ++m_numberOfAttacks;
+    }
+  }
+
+  size_t m_numberOfAttacks{0};
+
+private:
+  double m_cooldown;
+
+  double m_timer{0.0};
+};
+
+/** The same logic as a behavior that sleeps through its cooldown. */
+class WaitingEnemy : public BehaviorComponent
+{
+public:
+  explicit WaitingEnemy(double cooldown) : m_cooldown(cooldown) {}
+
+  Behavior attack()
+  {
+    while (true)
+    {
+      co_await delay(m_cooldown);
+      ++m_numberOfAttacks;
+    }
+  }
+
+  size_t m_numberOfAttacks{0};
+
+private:
+  double m_cooldown;
+};
+
+} // namespace
+
+int Benchmark::runBehaviorBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfEnemies = getArgument(arguments, 0, 100000);
+  size_t const numberOfFrames = getArgument(arguments, 1, 600);
+  double const deltaTime = 1.0 / 60.0;
+
+  std::mt19937 random(7);
+  std::uniform_real_distribution<double> cooldown(2.0, 10.0);
+  std::unique_ptr<SceneObject> pPolling(new SceneObject());
+  std::unique_ptr<SceneObject> pWaiting(new SceneObject());
+  for (size_t i = 0; i < numberOfEnemies; ++i)
+  {
+    double const seconds = cooldown(random);
+    SceneObject * pObject = new SceneObject();
+    pObject->addComponent(new PollingEnemy(seconds));
+    pPolling->addChild(pObject);
+
+    pObject = new SceneObject();
+    WaitingEnemy * pEnemy = new WaitingEnemy(seconds);
+    pObject->addComponent(pEnemy);
+    pWaiting->addChild(pObject);
+    pEnemy->startBehavior(pEnemy->attack());
+  }
+
+  Clock::time_point start = Clock::now();
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    pPolling->update(deltaTime);
+  }
+  double const pollingMilliseconds = millisecondsSince(start);
+
+  size_t numberOfResumed = 0;
+  start = Clock::now();
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    BehaviorScheduler::getInstance().update(deltaTime);
+    numberOfResumed += BehaviorScheduler::getInstance().getNumberOfResumed();
+  }
+  double const waitingMilliseconds = millisecondsSince(start);
+
+  std::cout << numberOfEnemies << " enemies, " << numberOfFrames
+            << " frames\n"
+            << "polling update:     "
+            << pollingMilliseconds / double(numberOfFrames) << " ms/frame\n"
+            << "behavior scheduler: "
+            << waitingMilliseconds / double(numberOfFrames) << " ms/frame ("
+            << double(numberOfResumed) / double(numberOfFrames)
+            << " resumed per frame)" << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Headless benchmarks of the core subsystems. Every benchmark gets the
+ * remaining command line arguments and returns the process exit code.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace Benchmark
+{
+
+using Arguments = std::vector<std::string>;
+
+using Clock = std::chrono::steady_clock;
+
+/** Returns the milliseconds passed since the given time point. */
+inline double millisecondsSince(Clock::time_point start)
+{
+  return std::chrono::duration<double, std::milli>(Clock::now() - start)
+      .count();
+}
+
+/** Returns the argument at the index as number or the default value. */
+inline size_t getArgument(Arguments const & arguments, size_t index,
+                          size_t defaultValue)
+{
+  return index < arguments.size() ? std::stoul(arguments[index])
+                                  : defaultValue;
+}
+
+/**
+ * Serial versus pipelined frames with a null render backend.
+ * Arguments: [numberOfObjects] [numberOfFrames] [changedPercent]
+ */
+int runPipelineBenchmark(Arguments const & arguments);
+
+/**
+ * Polled cooldowns versus behaviors waiting in the timer wheel.
+ * Arguments: [numberOfEnemies] [numberOfFrames]
+ */
+int runBehaviorBenchmark(Arguments const & arguments);
+
+/**
+ * Agents updated every frame versus ten times as many throttled agents.
+ * Arguments: [numberOfAgents] [numberOfFrames] [budgetMicroseconds]
+ */
+int runThrottleBenchmark(Arguments const & arguments);
+
+/**
+ * Copying a hierarchy by hand versus instantiating it from a prefab.
+ * Arguments: [numberOfInstances] [objectsPerInstance]
+ */
+int runPrefabBenchmark(Arguments const & arguments);
+
+/**
+ * Walking the scene for matching objects versus a component query.
+ * Arguments: [numberOfObjects] [matchesPerThousand] [numberOfFrames]
+ */
+int runQueryBenchmark(Arguments const & arguments);
+
+/**
+ * Scalar versus AVX2 versus parallel simulation of a full particle emitter.
+ * Arguments: [numberOfParticles] [numberOfFrames] [grainSize]
+ */
+int runParticleBenchmark(Arguments const & arguments);
+
+/**
+ * Piles of boxes stepped on one thread and on all threads. Without a body
+ * count it runs 1k, 5k, 10k and 20k bodies.
+ * Arguments: [numberOfBodies] [numberOfSteps] [numberOfThreads]
+ */
+int runPhysicsBenchmark(Arguments const & arguments);
+
+/**
+ * Replicating moving objects to clients with delta compressed snapshots.
+ * Arguments: [numberOfObjects] [numberOfFrames] [numberOfClients]
+ * [movingPercent] [inprocess|udp]
+ */
+int runReplicationBenchmark(Arguments const & arguments);
+
+/**
+ * Capturing a scene every frame and rolling it back after simulating ahead.
+ * Arguments: [numberOfObjects] [numberOfFrames] [changedPercent]
+ */
+int runSnapshotBenchmark(Arguments const & arguments);
+
+/**
+ * Asynchronous logging from one and several threads compared to formatting
+ * and flushing synchronously, then decoding the binary log.
+ * Arguments: [numberOfFrames] [messagesPerFrame] [numberOfThreads]
+ */
+int runLoggingBenchmark(Arguments const & arguments);
+
+} // namespace Benchmark
@@ -0,0 +1,176 @@
+// messages of the physics category are compiled out in this file
+#define CORE_LOG_DISABLED_CATEGORIES (1 << CATEGORY_PHYSICS)
+
+#include "Benchmarks.h"
+#include <Core/LogReader.h>
+#include <Core/Logger.h>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+/** Logs a typical message per object and returns the nanoseconds per call. */
+double logFrames(size_t numberOfFrames, size_t messagesPerFrame)
+{
+  double nanoseconds = 0.0;
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    Benchmark::Clock::time_point const start = Benchmark::Clock::now();
+    for (size_t i = 0; i < messagesPerFrame; ++i)
+    {
+      CORE_LOG_INFO(CATEGORY_GAME, "frame {} object {} at {} {} named {}",
+                    frame, i, static_cast<float>(i) * 0.5f, -1.25, "enemy");
+    }
+    nanoseconds += Benchmark::millisecondsSince(start) * 1e6;
+
+    // the writer catches up between frames
+    Logger::getInstance().flush();
+  }
+  return nanoseconds / static_cast<double>(numberOfFrames * messagesPerFrame);
+}
+
+/** Returns the nanoseconds per call of filtered or compiled out messages. */
+template <class TFunction>
+double measureCalls(size_t numberOfCalls, TFunction const & function)
+{
+  Benchmark::Clock::time_point const start = Benchmark::Clock::now();
+  for (size_t i = 0; i < numberOfCalls; ++i)
+  {
+    function(i);
+  }
+  return Benchmark::millisecondsSince(start) * 1e6 /
+         static_cast<double>(numberOfCalls);
+}
+
+} // namespace
+
+int Benchmark::runLoggingBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfFrames = getArgument(arguments, 0, 200);
+  size_t const messagesPerFrame = getArgument(arguments, 1, 1000);
+  size_t const numberOfThreads = getArgument(arguments, 2, 4);
+  if (numberOfFrames == 0 || messagesPerFrame == 0 || numberOfThreads == 0)
+  {
+    std::cout << "Frames, messages and threads must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::filesystem::path const directory =
+      std::filesystem::temp_directory_path();
+  std::string const binaryName = (directory / "benchmark.plog").string();
+  std::string const textName = (directory / "benchmark.log").string();
+  Logger & logger = Logger::getInstance();
+  logger.setConsoleOutput(false);
+  if (!logger.openBinaryFile(binaryName))
+  {
+    std::cout << "Couldn't open '" << binaryName << "'." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // the same messages formatted synchronously and flushed line by line
+  double synchronous = 0.0;
+  {
+    std::ofstream file(textName);
+    Clock::time_point const start = Clock::now();
+    for (size_t i = 0; i < messagesPerFrame; ++i)
+    {
+      file << "frame " << 0 << " object " << i << " at "
+           << static_cast<float>(i) * 0.5f << " " << -1.25 << " named "
+           << "enemy" << std::endl;
+    }
+    synchronous = millisecondsSince(start) * 1e6 / messagesPerFrame;
+  }
+
+  double const oneThread = logFrames(numberOfFrames, messagesPerFrame);
+
+  std::vector<double> perThread(numberOfThreads);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numberOfThreads; ++t)
+  {
+    threads.emplace_back([&perThread, t, numberOfFrames, messagesPerFrame] {
+      perThread[t] = logFrames(numberOfFrames, messagesPerFrame);
+    });
+  }
+  double manyThreads = 0.0;
+  for (size_t t = 0; t < numberOfThreads; ++t)
+  {
+    threads[t].join();
+    manyThreads += perThread[t] / static_cast<double>(numberOfThreads);
+  }
+
+  // info messages are compiled in for every build type, so they reach the
+  // runtime filter
+  size_t const numberOfCalls = 10000000;
+  logger.setMinimumSeverity(SEVERITY_ERROR);
+  double const filtered = measureCalls(numberOfCalls, [](size_t i) {
+    CORE_LOG_INFO(CATEGORY_GAME, "filtered {}", i);
+  });
+  logger.setMinimumSeverity(SEVERITY_TRACE);
+  double const compiledOut = measureCalls(numberOfCalls, [](size_t i) {
+    CORE_LOG_ERROR(CATEGORY_PHYSICS, "compiled out {}", i);
+  });
+  logger.closeFiles();
+
+  // every message has to be decoded from the binary file
+  size_t const numberOfLogged =
+      numberOfFrames * messagesPerFrame * (numberOfThreads + 1);
+  size_t numberOfRead = 0;
+  size_t numberOfDropped = 0;
+  std::string lastLine;
+  LogReader reader;
+  Clock::time_point const start = Clock::now();
+  if (reader.open(binaryName))
+  {
+    LogEntry entry;
+    while (reader.read(entry))
+    {
+      if (entry.category == CATEGORY_GAME)
+      {
+        ++numberOfRead;
+        lastLine = entry.message;
+      }
+      else
+      {
+        numberOfDropped += std::stoull(entry.message);
+      }
+    }
+  }
+  double const decode = millisecondsSince(start);
+  std::string const expectedStart =
+      "frame " + std::to_string(numberOfFrames - 1) + " object " +
+      std::to_string(messagesPerFrame - 1) + " at ";
+  std::string const expectedEnd = " -1.25 named enemy";
+  // the last message is only known if nothing was dropped
+  bool const isLastCorrect =
+      numberOfDropped != 0 ||
+      (lastLine.rfind(expectedStart, 0) == 0 &&
+       lastLine.size() >= expectedEnd.size() &&
+       lastLine.compare(lastLine.size() - expectedEnd.size(),
+                        expectedEnd.size(), expectedEnd) == 0);
+
+  std::cout << numberOfFrames << " frames with " << messagesPerFrame
+            << " messages each, 1 and " << numberOfThreads << " threads"
+            << "\n  synchronous and flushed: " << synchronous
+            << " ns per message"
+            << "\n  one thread: " << oneThread << " ns per message"
+            << "\n  " << numberOfThreads << " threads: " << manyThreads
+            << " ns per message"
+            << "\n  filtered at runtime: " << filtered << " ns per call"
+            << "\n  compiled out: " << compiledOut << " ns per call"
+            << "\n  decoded " << numberOfRead << " of " << numberOfLogged
+            << " messages (" << numberOfDropped << " dropped) in " << decode
+            << " ms from " << std::filesystem::file_size(binaryName)
+            << " bytes" << "\n  last message: " << lastLine << std::endl;
+  std::filesystem::remove(binaryName);
+  std::filesystem::remove(textName);
+  return numberOfRead + numberOfDropped == numberOfLogged &&
+                 !reader.isTruncated() && isLastCorrect
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
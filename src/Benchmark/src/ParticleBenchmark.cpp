@@ -0,0 +1,81 @@
+#include "Benchmarks.h"
+#include <Core/JobSystem.h>
+#include <Core/ParticleEmitter.h>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+
+/** Runs the frames and returns the average update time. */
+double runFrames(ParticleEmitter & emitter, size_t numberOfFrames)
+{
+  double const deltaTime = 1.0 / 60.0;
+  Benchmark::Clock::time_point const start = Benchmark::Clock::now();
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    emitter.update(deltaTime);
+  }
+  return Benchmark::millisecondsSince(start) / numberOfFrames;
+}
+
+} // namespace
+
+int Benchmark::runParticleBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfParticles = getArgument(arguments, 0, 1000000);
+  size_t const numberOfFrames = getArgument(arguments, 1, 200);
+  size_t const grainSize = getArgument(arguments, 2, 65536);
+  if (numberOfParticles == 0 || numberOfFrames == 0)
+  {
+    std::cout << "The counts must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // particles live three seconds on average and are spawned faster than
+  // they die, so the emitter stays full and some die in every frame
+  ParticleEmitterSettings settings;
+  settings.capacity = numberOfParticles;
+  settings.rate = static_cast<float>(numberOfParticles) / 2.0f;
+  settings.spread = 10.0f;
+  settings.velocityY = 5.0f;
+  settings.velocityVariance = 2.0f;
+  settings.minimumLifetime = 2.0f;
+  settings.maximumLifetime = 4.0f;
+  settings.accelerationY = -9.81f;
+  settings.drag = 0.1f;
+
+  struct Mode
+  {
+    char const * name;
+    bool isVectorized;
+    size_t grainSize;
+  };
+  Mode const modes[] = {{"Scalar:   ", false, 0},
+                        {"AVX2:     ", true, 0},
+                        {"Parallel: ", true, grainSize}};
+  for (Mode const & mode : modes)
+  {
+    ParticleEmitter emitter;
+    emitter.setSettings(settings);
+    emitter.setVectorized(mode.isVectorized);
+    emitter.setParallelGrainSize(mode.grainSize);
+    if (mode.isVectorized && !emitter.isVectorized())
+    {
+      std::cout << mode.name << "AVX2 isn't available" << std::endl;
+      continue;
+    }
+    emitter.emit(numberOfParticles);
+    runFrames(emitter, 10); // warm up the caches
+    double const milliseconds = runFrames(emitter, numberOfFrames);
+    std::cout << mode.name << milliseconds << " ms per frame, "
+              << emitter.getNumberOfParticles() << " particles";
+    if (mode.grainSize > 0)
+    {
+      std::cout << ", " << JobSystem::getInstance().getNumberOfThreads()
+                << " threads";
+    }
+    std::cout << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,135 @@
+#include "Benchmarks.h"
+#include <Core/JobSystem.h>
+#include <Core/PhysicsWorld.h>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+/** The number of boxes per pile, ten columns of ten boxes. */
+size_t const BODIES_PER_PILE = 100;
+
+size_t const COLUMNS_PER_PILE = 10;
+
+struct Result
+{
+  double stepMilliseconds{0.0};
+  PhysicsStatistics statistics{};
+
+  /** A hash of all final positions to compare runs. */
+  uint64_t hash{0};
+};
+
+/**
+ * Drops piles of boxes side by side on a static ground, steps the world
+ * and removes everything again.
+ */
+Result simulate(size_t numberOfBodies, size_t numberOfSteps)
+{
+  PhysicsWorld & world = PhysicsWorld::getInstance();
+  size_t const numberOfPiles =
+      (numberOfBodies + BODIES_PER_PILE - 1) / BODIES_PER_PILE;
+  float const pileWidth = 1.1f * COLUMNS_PER_PILE + 4.0f;
+  std::vector<uint32_t> slots;
+
+  BodyDefinition ground;
+  ground.type = BODY_STATIC;
+  ground.shape = SHAPE_BOX;
+  ground.halfWidth = 0.5f * pileWidth * numberOfPiles + 10.0f;
+  ground.halfHeight = 0.5f;
+  slots.push_back(world.createBody());
+  world.setDefinition(slots.back(), ground);
+  world.editMotion(slots.back()).positionX = ground.halfWidth - 10.0f;
+  world.setEnabled(slots.back(), true);
+
+  BodyDefinition box;
+  box.shape = SHAPE_BOX;
+  for (size_t i = 0; i < numberOfBodies; ++i)
+  {
+    size_t const pile = i / BODIES_PER_PILE;
+    size_t const column = i % COLUMNS_PER_PILE;
+    size_t const row = (i % BODIES_PER_PILE) / COLUMNS_PER_PILE;
+    slots.push_back(world.createBody());
+    world.setDefinition(slots.back(), box);
+    BodyMotion & motion = world.editMotion(slots.back());
+    // every other row is shifted, so the piles collapse a bit
+    motion.positionX = pile * pileWidth + column * 1.1f + (row % 2) * 0.3f;
+    motion.positionY = 1.0f + row * 1.05f;
+    world.setEnabled(slots.back(), true);
+  }
+
+  Result result;
+  Benchmark::Clock::time_point const start = Benchmark::Clock::now();
+  for (size_t step = 0; step < numberOfSteps; ++step)
+  {
+    world.step();
+  }
+  result.stepMilliseconds =
+      Benchmark::millisecondsSince(start) / numberOfSteps;
+  result.statistics = world.getStatistics();
+
+  result.hash = 14695981039346656037ull;
+  for (uint32_t slot : slots)
+  {
+    BodyMotion const & motion = world.getMotion(slot);
+    unsigned char bytes[sizeof(BodyMotion)];
+    std::memcpy(bytes, &motion, sizeof(BodyMotion));
+    for (unsigned char byte : bytes)
+    {
+      result.hash = (result.hash ^ byte) * 1099511628211ull;
+    }
+  }
+
+  // in reverse, so the next run gets the same slots in the same order
+  for (size_t i = slots.size(); i-- > 0;)
+  {
+    world.destroyBody(slots[i]);
+  }
+  return result;
+}
+
+} // namespace
+
+int Benchmark::runPhysicsBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfSteps = getArgument(arguments, 1, 240);
+  size_t const numberOfThreads = getArgument(arguments, 2, 0);
+  std::vector<size_t> sizes = {1000, 5000, 10000, 20000};
+  if (!arguments.empty())
+  {
+    sizes.assign(1, getArgument(arguments, 0, 0));
+  }
+  if (numberOfSteps == 0)
+  {
+    std::cout << "The number of steps must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool isDeterministic = true;
+  for (size_t numberOfBodies : sizes)
+  {
+    JobSystem::getInstance().setNumberOfThreads(1);
+    Result const serial = simulate(numberOfBodies, numberOfSteps);
+    JobSystem::getInstance().setNumberOfThreads(numberOfThreads);
+    Result const parallel = simulate(numberOfBodies, numberOfSteps);
+
+    PhysicsStatistics const & statistics = parallel.statistics;
+    std::cout << numberOfBodies << " bodies: " << serial.stepMilliseconds
+              << " ms per step on 1 thread, " << parallel.stepMilliseconds
+              << " ms on " << JobSystem::getInstance().getNumberOfThreads()
+              << " threads\n  last step: " << statistics.numberOfPairs
+              << " pairs, " << statistics.numberOfContacts << " contacts, "
+              << statistics.numberOfIslands << " islands, broadphase "
+              << statistics.broadphaseSeconds * 1000.0 << " ms, narrowphase "
+              << statistics.narrowphaseSeconds * 1000.0 << " ms, solver "
+              << statistics.solverSeconds * 1000.0 << " ms\n  "
+              << (serial.hash == parallel.hash ? "identical" : "DIFFERENT")
+              << " results" << std::endl;
+    isDeterministic = isDeterministic && serial.hash == parallel.hash;
+  }
+  return isDeterministic ? EXIT_SUCCESS : EXIT_FAILURE;
+}
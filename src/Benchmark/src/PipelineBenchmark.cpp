@@ -0,0 +1,151 @@
+#include "Benchmarks.h"
+#include <Core/FramePipeline.h>
+#include <Core/RenderComponent.h>
+#include <Core/SceneObject.h>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+/** Moves its sprite on a circle and burns some update time doing so. */
+class Mover : public Component
+{
+public:
+  explicit Mover(float phase) : m_phase(phase) {}
+
+  void update(double deltaTime) override
+  {
+    m_phase += static_cast<float>(deltaTime);
+    float x = 0.0f;
+    for (int i = 0; i < 64; ++i)
+    {
+      x += std::sin(m_phase + float(i));
+    }
+    if (m_isMoving)
+    {
+      RenderComponent * pRender = m_pRender;
+      pRender->setPosition(Vector2(x, std::cos(m_phase)));
+      pRender->setRotation(m_phase);
+    }
+  }
+
+  bool m_isMoving{false};
+
+  RenderComponent * m_pRender{nullptr};
+
+private:
+  float m_phase;
+};
+
+/**
+ * Null render backend: builds the vertices of all visible sprites as a real
+ * backend would before submitting them, but never talks to a GPU.
+ */
+class NullRenderer
+{
+public:
+  void render(RenderSnapshot const & snapshot)
+  {
+    m_vertices.clear();
+    for (DrawItem const & item : snapshot.items)
+    {
+      if (!item.isVisible)
+        continue;
+      float const c = std::cos(item.rotation);
+      float const s = std::sin(item.rotation);
+      for (int corner = 0; corner < 4; ++corner)
+      {
+        float const x = ((corner & 1) ? 0.5f : -0.5f) * item.scaleX;
+        float const y = ((corner & 2) ? 0.5f : -0.5f) * item.scaleY;
+        m_vertices.push_back(item.positionX + c * x - s * y);
+        m_vertices.push_back(item.positionY + s * x + c * y);
+      }
+    }
+  }
+
+private:
+  std::vector<float> m_vertices{};
+};
+
+struct Result
+{
+  double frameMilliseconds{0.0};
+  double extractMilliseconds{0.0};
+  double waitMilliseconds{0.0};
+  double extractedItems{0.0};
+};
+
+Result runFrames(SceneObject & root, size_t numberOfFrames, bool isPipelined)
+{
+  NullRenderer renderer;
+  FramePipeline pipeline(
+      [&renderer](RenderSnapshot const & snapshot) {
+        renderer.render(snapshot);
+      },
+      isPipelined);
+
+  // the first frame extracts everything, don't count it
+  root.update(0.016);
+  pipeline.submitFrame();
+  pipeline.waitForRenderer();
+
+  Result result;
+  Benchmark::Clock::time_point const start = Benchmark::Clock::now();
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    root.update(0.016);
+    pipeline.submitFrame();
+    FrameStatistics const & statistics = pipeline.getStatistics();
+    result.extractMilliseconds += statistics.extractSeconds * 1000.0;
+    result.waitMilliseconds += statistics.waitSeconds * 1000.0;
+    result.extractedItems += double(statistics.extractedItems);
+  }
+  pipeline.waitForRenderer();
+  result.frameMilliseconds = Benchmark::millisecondsSince(start);
+
+  result.frameMilliseconds /= double(numberOfFrames);
+  result.extractMilliseconds /= double(numberOfFrames);
+  result.waitMilliseconds /= double(numberOfFrames);
+  result.extractedItems /= double(numberOfFrames);
+  return result;
+}
+
+void printResult(char const * pName, Result const & result)
+{
+  std::cout << pName << ": " << result.frameMilliseconds << " ms/frame, "
+            << "extract " << result.extractMilliseconds << " ms ("
+            << result.extractedItems << " items), wait "
+            << result.waitMilliseconds << " ms" << std::endl;
+}
+
+} // namespace
+
+int Benchmark::runPipelineBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfObjects = getArgument(arguments, 0, 20000);
+  size_t const numberOfFrames = getArgument(arguments, 1, 200);
+  size_t const changedPercent = getArgument(arguments, 2, 10);
+
+  std::unique_ptr<SceneObject> pRoot(new SceneObject());
+  for (size_t i = 0; i < numberOfObjects; ++i)
+  {
+    SceneObject * pObject = new SceneObject();
+    RenderComponent * pRender = new RenderComponent();
+    Mover * pMover = new Mover(float(i));
+    pMover->m_pRender = pRender;
+    pMover->m_isMoving = (i % 100) < changedPercent;
+    pObject->addComponent(pRender);
+    pObject->addComponent(pMover);
+    pRoot->addChild(pObject);
+  }
+
+  std::cout << numberOfObjects << " objects, " << changedPercent
+            << "% changing per frame, " << numberOfFrames << " frames"
+            << std::endl;
+  printResult("serial   ", runFrames(*pRoot, numberOfFrames, false));
+  printResult("pipelined", runFrames(*pRoot, numberOfFrames, true));
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,103 @@
+#include "Benchmarks.h"
+#include <Core/DataComponent.h>
+#include <Core/Prefab.h>
+#include <Core/SceneObject.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+struct TransformData
+{
+  float positionX;
+  float positionY;
+  float rotation;
+  float scale;
+};
+
+class Transform : public DataComponent<Transform, TransformData>
+{
+};
+
+struct HealthData
+{
+  float health;
+  float armor;
+};
+
+class Health : public DataComponent<Health, HealthData>
+{
+};
+
+/**
+ * Builds nested groups of objects with numberOfObjects in total with
+ * addChild and addComponent, like game code would.
+ */
+std::unique_ptr<SceneObject> createHierarchy(size_t numberOfObjects)
+{
+  std::unique_ptr<SceneObject> pRoot(new SceneObject());
+  pRoot->addComponent(new Transform());
+  pRoot->addComponent(new Health());
+  SceneObject * pParent = pRoot.get();
+  for (size_t i = 1; i < numberOfObjects; ++i)
+  {
+    SceneObject * pChild = new SceneObject();
+    Transform * pTransform = new Transform();
+    pTransform->editData().positionX = static_cast<float>(i);
+    pChild->addComponent(pTransform);
+    pParent->addChild(pChild);
+    if (i % 4 == 0)
+    {
+      pParent = pChild;
+    }
+  }
+  return pRoot;
+}
+
+} // namespace
+
+int Benchmark::runPrefabBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfInstances = getArgument(arguments, 0, 10000);
+  size_t const numberOfObjects = getArgument(arguments, 1, 20);
+  if (numberOfInstances == 0 || numberOfObjects == 0)
+  {
+    std::cout << "The counts must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::unique_ptr<SceneObject> pTemplate = createHierarchy(numberOfObjects);
+
+  Clock::time_point start = Clock::now();
+  {
+    SceneObject world;
+    for (size_t i = 0; i < numberOfInstances; ++i)
+    {
+      world.addChild(createHierarchy(numberOfObjects).release());
+    }
+    double const milliseconds = millisecondsSince(start);
+    std::cout << "By hand:   " << milliseconds << " ms" << std::endl;
+  }
+
+  Prefab prefab;
+  if (!prefab.capture(*pTemplate))
+  {
+    std::cout << "The template couldn't be captured." << std::endl;
+    return EXIT_FAILURE;
+  }
+  start = Clock::now();
+  {
+    SceneObject world;
+    std::vector<SceneObject *> roots;
+    prefab.instantiate(numberOfInstances, roots, &world);
+    double const milliseconds = millisecondsSince(start);
+    std::cout << "Prefab:    " << milliseconds << " ms ("
+              << numberOfInstances * prefab.getNumberOfObjects()
+              << " objects, "
+              << numberOfInstances * prefab.getNumberOfComponents()
+              << " components)" << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,115 @@
+#include "Benchmarks.h"
+#include <Core/Component.h>
+#include <Core/ComponentQuery.h>
+#include <Core/SceneObject.h>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+class Physics : public Component
+{
+public:
+  float velocity{1.0f};
+};
+
+class Sprite : public Component
+{
+public:
+  float position{0.0f};
+};
+
+/** Adds the components of all matches in the subtree the slow way. */
+void walk(SceneObject & object, float & sum)
+{
+  Physics const * pPhysics = object.getComponent<Physics>();
+  Sprite const * pSprite = object.getComponent<Sprite>();
+  if (pPhysics != nullptr && pSprite != nullptr && object.isEnabled())
+  {
+    sum += pPhysics->velocity + pSprite->position;
+  }
+  for (size_t i = 0; i < object.getNumberOfChildren(); ++i)
+  {
+    walk(*object.getChild(i), sum);
+  }
+}
+
+} // namespace
+
+int Benchmark::runQueryBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfObjects = getArgument(arguments, 0, 100000);
+  size_t const matchesPerThousand = getArgument(arguments, 1, 10);
+  size_t const numberOfFrames = getArgument(arguments, 2, 100);
+  if (numberOfObjects == 0 || numberOfFrames == 0)
+  {
+    std::cout << "The counts must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // groups of ten objects below the root
+  SceneObject root;
+  SceneObject * pGroup = nullptr;
+  for (size_t i = 0; i < numberOfObjects; ++i)
+  {
+    if (i % 10 == 0)
+    {
+      pGroup = new SceneObject();
+      root.addChild(pGroup);
+    }
+    SceneObject * pObject = new SceneObject();
+    pObject->addComponent(new Physics());
+    if (i % 1000 < matchesPerThousand)
+    {
+      pObject->addComponent(new Sprite());
+    }
+    pGroup->addChild(pObject);
+  }
+
+  ComponentQuery query;
+  Clock::time_point start = Clock::now();
+  query.require<Physics>().require<Sprite>();
+  double const buildMilliseconds = millisecondsSince(start);
+
+  float walkSum = 0.0f;
+  start = Clock::now();
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    walk(root, walkSum);
+  }
+  double const walkMilliseconds = millisecondsSince(start) / numberOfFrames;
+
+  float querySum = 0.0f;
+  size_t const physics = query.getColumn<Physics>();
+  size_t const sprite = query.getColumn<Sprite>();
+  start = Clock::now();
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    for (size_t i = 0; i < query.getNumberOfObjects(); ++i)
+    {
+      querySum += query.getComponent<Physics>(i, physics)->velocity +
+                  query.getComponent<Sprite>(i, sprite)->position;
+    }
+  }
+  double const queryMilliseconds = millisecondsSince(start) / numberOfFrames;
+
+  // toggling objects keeps the matches up to date incrementally
+  start = Clock::now();
+  for (size_t i = 0; i < root.getNumberOfChildren(); ++i)
+  {
+    root.getChild(i)->setEnabled(false);
+    root.getChild(i)->setEnabled(true);
+  }
+  double const toggleMilliseconds = millisecondsSince(start);
+
+  std::cout << "Matches:   " << query.getNumberOfObjects() << " of "
+            << numberOfObjects << " objects\n"
+            << "Build:     " << buildMilliseconds << " ms\n"
+            << "Walk:      " << walkMilliseconds << " ms per frame\n"
+            << "Query:     " << queryMilliseconds << " ms per frame\n"
+            << "Toggle:    " << toggleMilliseconds << " ms for "
+            << 2 * root.getNumberOfChildren() << " groups" << std::endl;
+  return walkSum == querySum ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,305 @@
+#include "Benchmarks.h"
+#include <Core/RenderComponent.h>
+#include <Core/ReplicatedObject.h>
+#include <Core/ReplicationClient.h>
+#include <Core/ReplicationRegistry.h>
+#include <Core/ReplicationServer.h>
+#include <Core/ReplicationTransport.h>
+#include <Core/SceneObject.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+/** The range and precision of replicated positions. */
+float const WORLD_SIZE = 2000.0f;
+
+float const POSITION_PRECISION = 0.01f;
+
+/**
+ * The frames the acknowledgements of the lossy client are dropped, more
+ * than the 64 snapshots the server keeps, so it falls back to full states.
+ */
+size_t const LOST_ACKNOWLEDGEMENTS = 80;
+
+/** Replicates position, rotation, color and layer of render components. */
+void registerRenderComponent()
+{
+  ReplicationRegistry::getInstance()
+      .registerType<RenderComponent>()
+      .addFloat(
+          [](Component const & c) {
+            return static_cast<RenderComponent const &>(c).getPosition().x();
+          },
+          [](Component & c, float x) {
+            RenderComponent & render = static_cast<RenderComponent &>(c);
+            render.setPosition(Vector2(x, render.getPosition().y()));
+          },
+          -WORLD_SIZE, WORLD_SIZE, POSITION_PRECISION)
+      .addFloat(
+          [](Component const & c) {
+            return static_cast<RenderComponent const &>(c).getPosition().y();
+          },
+          [](Component & c, float y) {
+            RenderComponent & render = static_cast<RenderComponent &>(c);
+            render.setPosition(Vector2(render.getPosition().x(), y));
+          },
+          -WORLD_SIZE, WORLD_SIZE, POSITION_PRECISION)
+      .addAngle(
+          [](Component const & c) {
+            return static_cast<RenderComponent const &>(c).getRotation();
+          },
+          [](Component & c, float rotation) {
+            static_cast<RenderComponent &>(c).setRotation(rotation);
+          },
+          12)
+      .addInteger(
+          [](Component const & c) {
+            return static_cast<RenderComponent const &>(c).getColor();
+          },
+          [](Component & c, uint32_t color) {
+            static_cast<RenderComponent &>(c).setColor(color);
+          })
+      .addInteger(
+          [](Component const & c) {
+            return static_cast<uint32_t>(
+                static_cast<RenderComponent const &>(c).getLayer());
+          },
+          [](Component & c, uint32_t layer) {
+            static_cast<RenderComponent &>(c).setLayer(
+                static_cast<int32_t>(layer));
+          },
+          8);
+}
+
+/** A moving, replicated object of the server scene. */
+struct Mover
+{
+  SceneObject * pObject;
+  RenderComponent * pRender;
+  uint32_t networkId;
+  Vector2 velocity;
+};
+
+Mover createMover(SceneObject & root, std::mt19937 & random)
+{
+  std::uniform_real_distribution<float> position(-0.9f * WORLD_SIZE,
+                                                 0.9f * WORLD_SIZE);
+  std::uniform_real_distribution<float> speed(-2.0f, 2.0f);
+  Mover mover;
+  mover.pObject = new SceneObject();
+  ReplicatedObject * pReplicated = new ReplicatedObject();
+  mover.networkId = pReplicated->getNetworkId();
+  mover.pRender = new RenderComponent();
+  mover.pRender->setPosition(Vector2(position(random), position(random)));
+  mover.pRender->setColor(static_cast<uint32_t>(random()));
+  mover.pRender->setLayer(static_cast<int32_t>(random() % 8));
+  mover.velocity = Vector2(speed(random), speed(random));
+  mover.pObject->addComponent(pReplicated);
+  mover.pObject->addComponent(mover.pRender);
+  root.addChild(mover.pObject);
+  return mover;
+}
+
+/** One client with its scene and its end of the connection. */
+struct ClientSide
+{
+  std::unique_ptr<SceneObject> pRoot;
+  std::unique_ptr<ReplicationClient> pClient;
+  std::unique_ptr<ReplicationTransport> pServerEnd;
+  std::unique_ptr<ReplicationTransport> pClientEnd;
+};
+
+/** Connects both ends in process or over loopback UDP. */
+bool connect(ClientSide & side, bool isUdp)
+{
+  if (!isUdp)
+  {
+    InProcessTransport * pServerEnd = new InProcessTransport();
+    InProcessTransport * pClientEnd = new InProcessTransport();
+    InProcessTransport::connect(*pServerEnd, *pClientEnd);
+    side.pServerEnd.reset(pServerEnd);
+    side.pClientEnd.reset(pClientEnd);
+    return true;
+  }
+  UdpTransport * pServerEnd = new UdpTransport();
+  UdpTransport * pClientEnd = new UdpTransport();
+  side.pServerEnd.reset(pServerEnd);
+  side.pClientEnd.reset(pClientEnd);
+  return pServerEnd->open() && pClientEnd->open() &&
+         pServerEnd->setPeer("127.0.0.1", pClientEnd->getPort()) &&
+         pClientEnd->setPeer("127.0.0.1", pServerEnd->getPort());
+}
+
+/** Counts the server objects without a matching replica on the client. */
+size_t countMissing(ClientSide const & side, std::vector<Mover> const & movers,
+                    float & maximumError)
+{
+  size_t numberOfMissing = 0;
+  if (side.pClient->getNumberOfObjects() != movers.size())
+  {
+    ++numberOfMissing;
+  }
+  for (Mover const & mover : movers)
+  {
+    SceneObject * pReplica = side.pClient->getObject(mover.networkId);
+    RenderComponent const * pRender =
+        pReplica != nullptr ? pReplica->getComponent<RenderComponent>()
+                            : nullptr;
+    if (pRender == nullptr)
+    {
+      ++numberOfMissing;
+      continue;
+    }
+    Vector2 const error = pRender->getPosition() - mover.pRender->getPosition();
+    maximumError = std::max(maximumError, error.cwiseAbs().maxCoeff());
+  }
+  return numberOfMissing;
+}
+
+} // namespace
+
+int Benchmark::runReplicationBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfObjects = getArgument(arguments, 0, 10000);
+  size_t const numberOfFrames = getArgument(arguments, 1, 120);
+  size_t const numberOfClients = getArgument(arguments, 2, 4);
+  size_t const movingPercent = getArgument(arguments, 3, 20);
+  bool const isUdp = arguments.size() > 4 && arguments[4] == "udp";
+  if (numberOfObjects == 0 || numberOfFrames == 0 || numberOfClients == 0)
+  {
+    std::cout << "Objects, frames and clients must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  registerRenderComponent();
+  std::mt19937 random(7);
+  std::unique_ptr<SceneObject> pServerRoot(new SceneObject());
+  std::vector<Mover> movers;
+  for (size_t i = 0; i < numberOfObjects; ++i)
+  {
+    movers.push_back(createMover(*pServerRoot, random));
+  }
+
+  // one more client whose acknowledgements get lost for a while, it isn't
+  // timed
+  ReplicationServer server;
+  std::vector<ClientSide> clients(numberOfClients + 1);
+  for (ClientSide & side : clients)
+  {
+    if (!connect(side, isUdp))
+    {
+      std::cout << "The UDP sockets couldn't be opened." << std::endl;
+      return EXIT_FAILURE;
+    }
+    side.pRoot.reset(new SceneObject());
+    side.pClient.reset(new ReplicationClient(side.pRoot.get()));
+    server.addClient(side.pServerEnd.get());
+  }
+  ClientSide & lossy = clients.back();
+
+  // every frame some objects move and one object is replaced by a new one
+  size_t const numberOfMoving = numberOfObjects * movingPercent / 100;
+  float const deltaTime = 1.0f / 60.0f;
+  double captureMilliseconds = 0.0;
+  double encodeMilliseconds = 0.0;
+  double decodeMilliseconds = 0.0;
+  size_t fullBytes = 0;
+  size_t deltaBytes = 0;
+  std::vector<uint8_t> packet;
+  std::vector<uint8_t> lostAcknowledgement;
+  for (size_t frame = 0; frame <= numberOfFrames; ++frame)
+  {
+    for (size_t i = 0; i < numberOfMoving && frame > 0; ++i)
+    {
+      Mover & mover = movers[i];
+      mover.pRender->setPosition(mover.pRender->getPosition() +
+                                 mover.velocity * deltaTime);
+      mover.pRender->setRotation(mover.pRender->getRotation() +
+                                 deltaTime);
+    }
+    if (frame > 0)
+    {
+      size_t const replaced = random() % movers.size();
+      delete movers[replaced].pObject;
+      movers[replaced] = createMover(*pServerRoot, random);
+    }
+
+    Clock::time_point start = Clock::now();
+    server.captureSnapshot();
+    double const capture = millisecondsSince(start);
+
+    // the packet of the first client is encoded again to time it alone
+    start = Clock::now();
+    server.encode(0, packet);
+    double const encode = millisecondsSince(start);
+    server.update();
+
+    start = Clock::now();
+    for (size_t c = 0; c < numberOfClients; ++c)
+    {
+      clients[c].pClient->update(*clients[c].pClientEnd);
+    }
+    double const decode = millisecondsSince(start) / numberOfClients;
+
+    lossy.pClient->update(*lossy.pClientEnd);
+    if (frame > 0 && frame <= LOST_ACKNOWLEDGEMENTS)
+    {
+      while (lossy.pServerEnd->receive(lostAcknowledgement))
+      {
+      }
+    }
+
+    // the first frame sends the whole state and isn't averaged
+    if (frame == 0)
+    {
+      fullBytes = packet.size();
+      continue;
+    }
+    captureMilliseconds += capture;
+    encodeMilliseconds += encode;
+    decodeMilliseconds += decode;
+    deltaBytes += packet.size();
+  }
+
+  // every replica has to match its server object within the quantization
+  float maximumError = 0.0f;
+  size_t numberOfMissing = 0;
+  for (ClientSide const & side : clients)
+  {
+    numberOfMissing += countMissing(side, movers, maximumError);
+  }
+
+  double const frames = static_cast<double>(numberOfFrames);
+  double const scale = 10000.0 / numberOfObjects;
+  double const averageBytes = deltaBytes / frames;
+  std::cout << numberOfObjects << " objects, " << movingPercent
+            << "% moving, " << numberOfClients << " clients over "
+            << (isUdp ? "loopback UDP" : "in-process transports")
+            << "\n  full state: " << fullBytes << " bytes, delta: "
+            << averageBytes << " bytes per client and frame ("
+            << averageBytes * 60.0 * 8.0 / 1000.0 << " kbit/s at 60 Hz)"
+            << "\n  capture: " << captureMilliseconds / frames
+            << " ms per frame, " << captureMilliseconds / frames * scale
+            << " ms per 10k objects"
+            << "\n  encode: " << encodeMilliseconds / frames
+            << " ms per client and frame, "
+            << encodeMilliseconds / frames * scale << " ms per 10k objects"
+            << "\n  decode: " << decodeMilliseconds / frames
+            << " ms per client and frame"
+            << "\n  lossy client: " << lossy.pClient->getNumberOfObjects()
+            << " replicas of " << movers.size()
+            << " objects after losing the acknowledgements of "
+            << std::min(LOST_ACKNOWLEDGEMENTS, numberOfFrames) << " frames"
+            << "\n  largest position error " << maximumError << ", "
+            << numberOfMissing << " missing replicas" << std::endl;
+  return numberOfMissing == 0 && maximumError <= POSITION_PRECISION
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
@@ -0,0 +1,230 @@
+#include "Benchmarks.h"
+#include <Core/DataComponent.h>
+#include <Core/PhysicsWorld.h>
+#include <Core/RenderComponent.h>
+#include <Core/RigidBody.h>
+#include <Core/SceneObject.h>
+#include <Core/SceneSnapshot.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+struct MotionData
+{
+  float velocityX;
+  float velocityY;
+  float health;
+  uint32_t frame;
+};
+
+class Motion : public DataComponent<Motion, MotionData>
+{
+};
+
+/** An object of the simulated scene. */
+struct Unit
+{
+  SceneObject * pObject;
+  RenderComponent * pRender;
+  Motion * pMotion;
+};
+
+/** Builds groups of 100 units, each with a render and a motion component. */
+std::unique_ptr<SceneObject> createScene(size_t numberOfObjects,
+                                         std::vector<Unit> & units,
+                                         std::mt19937 & random)
+{
+  std::uniform_real_distribution<float> value(-100.0f, 100.0f);
+  std::unique_ptr<SceneObject> pRoot(new SceneObject());
+  SceneObject * pGroup = nullptr;
+  for (size_t i = 0; i < numberOfObjects; ++i)
+  {
+    if (i % 100 == 0)
+    {
+      pGroup = new SceneObject();
+      pRoot->addChild(pGroup);
+    }
+    Unit unit{new SceneObject(), new RenderComponent(), new Motion()};
+    unit.pRender->setPosition(Vector2(value(random), value(random)));
+    unit.pMotion->editData() = MotionData{value(random), value(random),
+                                          100.0f, 0};
+    unit.pObject->addComponent(unit.pRender);
+    unit.pObject->addComponent(unit.pMotion);
+    pGroup->addChild(unit.pObject);
+    units.push_back(unit);
+  }
+  return pRoot;
+}
+
+/** Moves the first numberOfMoving units one frame ahead. */
+void simulate(std::vector<Unit> const & units, size_t numberOfMoving)
+{
+  float const deltaTime = 1.0f / 60.0f;
+  for (size_t i = 0; i < numberOfMoving; ++i)
+  {
+    Unit const & unit = units[i];
+    MotionData & motion = unit.pMotion->editData();
+    unit.pRender->setPosition(
+        unit.pRender->getPosition() +
+        Vector2(motion.velocityX, motion.velocityY) * deltaTime);
+    motion.health -= deltaTime;
+    ++motion.frame;
+  }
+}
+
+/** Returns the number of units that differ from the expected states. */
+size_t countMismatches(std::vector<Unit> const & units,
+                       std::vector<Vector2> const & positions,
+                       std::vector<uint32_t> const & frames)
+{
+  size_t numberOfMismatches = 0;
+  for (size_t i = 0; i < units.size(); ++i)
+  {
+    if (units[i].pRender->getPosition() != positions[i] ||
+        units[i].pMotion->getData().frame != frames[i])
+    {
+      ++numberOfMismatches;
+    }
+  }
+  return numberOfMismatches;
+}
+
+} // namespace
+
+int Benchmark::runSnapshotBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfObjects = getArgument(arguments, 0, 10000);
+  size_t const numberOfFrames = getArgument(arguments, 1, 1000);
+  size_t const changedPercent = getArgument(arguments, 2, 10);
+  if (numberOfObjects == 0 || numberOfFrames == 0)
+  {
+    std::cout << "Objects and frames must be positive." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::mt19937 random(7);
+  std::vector<Unit> units;
+  std::unique_ptr<SceneObject> pRoot =
+      createScene(numberOfObjects, units, random);
+  size_t const numberOfMoving =
+      std::min(numberOfObjects, numberOfObjects * changedPercent / 100);
+
+  SceneSnapshot snapshot;
+  Clock::time_point start = Clock::now();
+  snapshot.capture(*pRoot);
+  double const firstCapture = millisecondsSince(start);
+
+  // every frame is captured, simulated ahead and rolled back once in four
+  std::vector<Vector2> positions(units.size());
+  std::vector<uint32_t> frames(units.size());
+  double captureMilliseconds = 0.0;
+  double restoreMilliseconds = 0.0;
+  size_t numberOfRestores = 0;
+  size_t copiedStates = 0;
+  size_t numberOfMismatches = 0;
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    start = Clock::now();
+    snapshot.capture(*pRoot);
+    captureMilliseconds += millisecondsSince(start);
+    copiedStates += snapshot.getNumberOfCopiedStates();
+
+    bool const isRollback = frame % 4 == 3;
+    if (isRollback)
+    {
+      for (size_t i = 0; i < units.size(); ++i)
+      {
+        positions[i] = units[i].pRender->getPosition();
+        frames[i] = units[i].pMotion->getData().frame;
+      }
+    }
+    simulate(units, numberOfMoving);
+    if (isRollback)
+    {
+      start = Clock::now();
+      snapshot.restore();
+      restoreMilliseconds += millisecondsSince(start);
+      copiedStates += snapshot.getNumberOfCopiedStates();
+      ++numberOfRestores;
+      numberOfMismatches += countMismatches(units, positions, frames);
+    }
+  }
+
+  // a rollback across structural changes: a unit is destroyed by restore,
+  // a removed component is attached again and a disabled object enabled
+  for (size_t i = 0; i < units.size(); ++i)
+  {
+    positions[i] = units[i].pRender->getPosition();
+    frames[i] = units[i].pMotion->getData().frame;
+  }
+  snapshot.capture(*pRoot);
+  units.front().pObject->addChild(new SceneObject());
+  units.back().pObject->removeComponent(units.back().pMotion);
+  units[units.size() / 2].pObject->setEnabled(false);
+  simulate(units, numberOfMoving);
+  start = Clock::now();
+  snapshot.restore();
+  double const structuralRestore = millisecondsSince(start);
+  bool const isStructureRestored =
+      units.front().pObject->isLeafNode() &&
+      units.back().pObject->getComponent<Motion>() == units.back().pMotion &&
+      units[units.size() / 2].pObject->isEnabled() &&
+      countMismatches(units, positions, frames) == 0;
+
+  // rigid bodies keep their motion in the physics world, a rollback puts
+  // the body and its render component back
+  SceneObject * pBody = new SceneObject();
+  RenderComponent * pBodyRender = new RenderComponent();
+  RigidBody * pRigidBody = new RigidBody();
+  pBody->addComponent(pBodyRender);
+  pBody->addComponent(pRigidBody);
+  pRigidBody->setVelocity(Vector2(3.0f, 4.0f));
+  pRoot->addChild(pBody);
+  PhysicsWorld::getInstance().step();
+  pBody->update(0.0);
+  snapshot.capture(*pRoot);
+  Vector2 const bodyPosition = pRigidBody->getPosition();
+  for (size_t step = 0; step < 10; ++step)
+  {
+    PhysicsWorld::getInstance().step();
+    pBody->update(0.0);
+  }
+  snapshot.restore();
+  pBody->update(0.0);
+  bool const isBodyRestored = pRigidBody->getPosition() == bodyPosition &&
+                              pBodyRender->getPosition() == bodyPosition &&
+                              bodyPosition != Vector2(0.0f, 0.0f);
+
+  double const captures = static_cast<double>(numberOfFrames);
+  double const restores = static_cast<double>(std::max<size_t>(
+      numberOfRestores, 1));
+  std::cout << numberOfObjects << " objects, " << snapshot.getNumberOfObjects()
+            << " in the snapshot with " << snapshot.getNumberOfComponents()
+            << " components and " << snapshot.getStateSize()
+            << " bytes of state, " << changedPercent << "% changed per frame"
+            << "\n  first capture: " << firstCapture << " ms"
+            << "\n  capture: " << captureMilliseconds / captures << " ms"
+            << "\n  restore: " << restoreMilliseconds / restores << " ms"
+            << "\n  capture and restore: "
+            << captureMilliseconds / captures + restoreMilliseconds / restores
+            << " ms"
+            << "\n  copied states: "
+            << static_cast<double>(copiedStates) / (captures + restores)
+            << " per capture or restore"
+            << "\n  structural restore: " << structuralRestore << " ms, "
+            << (isStructureRestored ? "restored" : "NOT restored")
+            << "\n  rigid body: "
+            << (isBodyRestored ? "restored" : "NOT restored")
+            << "\n  " << numberOfMismatches << " mismatches after rollbacks"
+            << std::endl;
+  return numberOfMismatches == 0 && isStructureRestored && isBodyRestored
+             ? EXIT_SUCCESS
+             : EXIT_FAILURE;
+}
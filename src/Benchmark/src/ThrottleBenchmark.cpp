@@ -0,0 +1,118 @@
+#include "Benchmarks.h"
+#include <Core/Component.h>
+#include <Core/SceneObject.h>
+#include <Core/UpdateScheduler.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+namespace
+{
+
+/** An agent whose thinking takes a fixed amount of work. */
+class Agent : public Component
+{
+public:
+  void update(double deltaTime) override
+  {
+    // the work mustn't depend on the delta time to be comparable
+    float x = m_state;
+    for (int i = 0; i < 200; ++i)
+    {
+      x = std::sin(x + 0.01f);
+    }
+    m_state = x;
+    m_time += deltaTime;
+  }
+
+private:
+  float m_state{0.0f};
+
+  double m_time{0.0};
+};
+
+struct Result
+{
+  double averageMilliseconds{0.0};
+  double maximumMilliseconds{0.0};
+  double deviationMilliseconds{0.0};
+};
+
+/** Runs the frames and measures the update time of each one. */
+Result runFrames(SceneObject & root, size_t numberOfFrames)
+{
+  double const deltaTime = 1.0 / 60.0;
+  std::vector<double> times;
+  for (size_t frame = 0; frame < numberOfFrames; ++frame)
+  {
+    Benchmark::Clock::time_point const start = Benchmark::Clock::now();
+    root.update(deltaTime);
+    UpdateScheduler::getInstance().update(deltaTime);
+    times.push_back(Benchmark::millisecondsSince(start));
+  }
+  Result result;
+  for (double time : times)
+  {
+    result.averageMilliseconds += time;
+    result.maximumMilliseconds = std::max(result.maximumMilliseconds, time);
+  }
+  result.averageMilliseconds /= double(times.size());
+  for (double time : times)
+  {
+    double const difference = time - result.averageMilliseconds;
+    result.deviationMilliseconds += difference * difference;
+  }
+  result.deviationMilliseconds =
+      std::sqrt(result.deviationMilliseconds / double(times.size()));
+  return result;
+}
+
+std::unique_ptr<SceneObject> createAgents(size_t numberOfAgents,
+                                          double frequency)
+{
+  std::unique_ptr<SceneObject> pRoot(new SceneObject());
+  for (size_t i = 0; i < numberOfAgents; ++i)
+  {
+    SceneObject * pObject = new SceneObject();
+    Agent * pAgent = new Agent();
+    pAgent->setUpdateFrequency(frequency);
+    pObject->addComponent(pAgent);
+    pRoot->addChild(pObject);
+  }
+  return pRoot;
+}
+
+void printResult(char const * pName, Result const & result)
+{
+  std::cout << pName << ": " << result.averageMilliseconds
+            << " ms/frame average, " << result.maximumMilliseconds
+            << " ms max, " << result.deviationMilliseconds << " ms deviation"
+            << std::endl;
+}
+
+} // namespace
+
+int Benchmark::runThrottleBenchmark(Arguments const & arguments)
+{
+  size_t const numberOfAgents = getArgument(arguments, 0, 2000);
+  size_t const numberOfFrames = getArgument(arguments, 1, 300);
+  size_t const budgetMicroseconds = getArgument(arguments, 2, 0);
+  UpdateScheduler::getInstance().setFrameBudget(
+      double(budgetMicroseconds) * 1e-6);
+
+  std::cout << numberOfFrames << " frames at 60 Hz" << std::endl;
+  {
+    std::unique_ptr<SceneObject> pRoot = createAgents(numberOfAgents, 0.0);
+    std::cout << numberOfAgents << " agents every frame" << std::endl;
+    printResult("  every frame", runFrames(*pRoot, numberOfFrames));
+  }
+  {
+    std::unique_ptr<SceneObject> pRoot =
+        createAgents(numberOfAgents * 10, 6.0);
+    std::cout << numberOfAgents * 10 << " agents at 6 Hz" << std::endl;
+    printResult("  throttled  ", runFrames(*pRoot, numberOfFrames));
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,34 @@
+#include "Benchmarks.h"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <map>
+
+using namespace Benchmark;
+
+int main(int argc, char ** argv)
+{
+  std::map<std::string, std::function<int(Arguments const &)>> const
+      benchmarks = {{"pipeline", runPipelineBenchmark},
+                    {"behavior", runBehaviorBenchmark},
+                    {"throttle", runThrottleBenchmark},
+                    {"prefab", runPrefabBenchmark},
+                    {"query", runQueryBenchmark},
+                    {"particle", runParticleBenchmark},
+                    {"physics", runPhysicsBenchmark},
+                    {"replication", runReplicationBenchmark},
+                    {"snapshot", runSnapshotBenchmark},
+                    {"logging", runLoggingBenchmark}};
+
+  if (argc < 2 || benchmarks.count(argv[1]) == 0)
+  {
+    std::cout << "Usage: Benchmark <name> [arguments]\nBenchmarks:";
+    for (auto const & benchmark : benchmarks)
+    {
+      std::cout << ' ' << benchmark.first;
+    }
+    std::cout << std::endl;
+    return EXIT_FAILURE;
+  }
+  return benchmarks.at(argv[1])(Arguments(argv + 2, argv + argc));
+}
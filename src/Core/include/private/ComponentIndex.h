@@ -0,0 +1,75 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Keeps a list of the attached components of every type and forwards scene
+ * changes to the component queries that care about them. Scene objects and
+ * components report their changes here, the lists let new queries find
+ * their matches without walking the scene.
+ */
+
+#pragma once
+
+#include "ComponentQueryImpl.h"
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+class ComponentIndex final
+{
+public:
+  static ComponentIndex & getInstance();
+
+  ComponentIndex(ComponentIndex const &) = delete;
+
+  ComponentIndex & operator=(ComponentIndex const &) = delete;
+
+  /** Call after the component was added to its scene object. */
+  void attach(Component & component, size_t typeId);
+
+  /** Returns the list of the type for attaching many components at once. */
+  std::vector<Component *> & getList(size_t typeId);
+
+  /**
+   * Adds the attached component to the list of its type without updating
+   * queries. Call onObjectChanged for the scene objects once all their
+   * components are attached.
+   */
+  static void attach(Component & component, size_t typeId,
+                     std::vector<Component *> & list);
+
+  /** Call after the component was removed from the scene object. */
+  void detach(Component & component, SceneObject & object);
+
+  /** Removes the component from the lists without updating queries. */
+  void remove(Component & component);
+
+  /** Call after the component was enabled or disabled. */
+  void onComponentChanged(Component & component);
+
+  /** Call after the scene object was enabled, disabled or moved. */
+  void onObjectChanged(SceneObject & object);
+
+  /** Call before the scene object and its components are destroyed. */
+  void onObjectDestroyed(SceneObject const & object);
+
+  /** Returns all attached components of the type. */
+  std::vector<Component *> const & getComponents(size_t typeId) const;
+
+  /** Starts forwarding changes of the query's types to the query. */
+  void addQuery(ComponentQuery::Impl * pQuery);
+
+  void removeQuery(ComponentQuery::Impl * pQuery);
+
+private:
+  ComponentIndex();
+
+  /** The attached components of every type. */
+  std::unordered_map<size_t, std::vector<Component *>> m_components{};
+
+  std::vector<ComponentQuery::Impl *> m_queries{};
+
+  /** The queries that require or exclude each type. */
+  std::unordered_map<size_t, std::vector<ComponentQuery::Impl *>>
+      m_queriesByType{};
+};
@@ -0,0 +1,72 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The private implementation of component queries. The component index
+ * asks it to reconsider scene objects whenever they change.
+ */
+
+#pragma once
+
+#include "Core/ComponentQuery.h"
+#include <unordered_map>
+#include <vector>
+
+class ComponentQuery::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  void require(size_t typeId);
+
+  void exclude(size_t typeId);
+
+  size_t getNumberOfObjects() const;
+
+  SceneObject * getObject(size_t index) const;
+
+  size_t getColumn(size_t typeId) const;
+
+  Component * getComponent(size_t index, size_t column) const;
+
+  void parallelFor(size_t grainSize,
+                   JobSystem::RangeFunction const & function) const;
+
+  /** The required types followed by the excluded ones. */
+  std::vector<size_t> getTypes() const;
+
+  /** Adds or removes the scene object depending on whether it matches. */
+  void evaluate(SceneObject & object);
+
+  /** Removes the scene object if it's a match. */
+  void remove(SceneObject const & object);
+
+private:
+  /** Searches all matches again after the types changed. */
+  void rebuild();
+
+  std::vector<size_t> m_required{};
+
+  std::vector<size_t> m_excluded{};
+
+  std::vector<SceneObject *> m_objects{};
+
+  /** The required components of all matches, one row per match. */
+  std::vector<Component *> m_components{};
+
+  /** The row of each matching scene object. */
+  std::unordered_map<SceneObject const *, size_t> m_rows{};
+
+  /** The components of the object that is evaluated. */
+  std::vector<Component *> m_candidate{};
+};
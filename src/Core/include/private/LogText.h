@@ -0,0 +1,27 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Formatting of logged messages, shared by the writer thread of the logger
+ * and the log reader so that text files and decoded binary files look the
+ * same.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Appends the format with every {} replaced by the next encoded argument.
+ * {{ and }} are written as single braces, surplus arguments are appended.
+ * Returns false if the arguments are malformed.
+ */
+bool appendMessage(std::string & text, char const * pFormat,
+                   size_t formatLength, uint8_t const * pArguments,
+                   size_t argumentSize);
+
+/** Appends the timestamp, severity, category and thread of a line. */
+void appendLinePrefix(std::string & text, uint64_t timestamp, uint32_t thread,
+                      uint8_t severity, uint8_t category);
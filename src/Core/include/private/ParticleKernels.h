@@ -0,0 +1,61 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The simulation kernels of particle emitters. Every kernel integrates a
+ * range of particles and writes the indices of the particles that died to
+ * the given array in ascending order. Ranges start at multiples of
+ * PARTICLE_LANES and the arrays are padded to whole vectors, so kernels may
+ * process the last vector of a range completely.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** The number of floats processed at once by the vectorized kernels. */
+size_t const PARTICLE_LANES = 8;
+
+/** The structure of arrays of all particles of an emitter. */
+struct ParticleArrays
+{
+  float * positionX;
+  float * positionY;
+  float * velocityX;
+  float * velocityY;
+
+  /** The remaining lifetime in seconds, a particle dies at zero. */
+  float * life;
+};
+
+/** The constants of one simulation step. */
+struct ParticleStep
+{
+  float deltaTime;
+  float accelerationX;
+  float accelerationY;
+
+  /** The factor the velocity is multiplied with per step. */
+  float damping;
+};
+
+/** Integrates [begin, end) and returns the number of dead particles. */
+using ParticleKernel = size_t (*)(ParticleArrays const & particles,
+                                  size_t begin, size_t end,
+                                  ParticleStep const & step, uint32_t * pDead);
+
+size_t integrateParticlesScalar(ParticleArrays const & particles, size_t begin,
+                                size_t end, ParticleStep const & step,
+                                uint32_t * pDead);
+
+/** Only available if hasAvx2ParticleKernel returns true. */
+size_t integrateParticlesAvx2(ParticleArrays const & particles, size_t begin,
+                              size_t end, ParticleStep const & step,
+                              uint32_t * pDead);
+
+/**
+ * Returns true if the AVX2 kernel was compiled in and the processor
+ * supports it.
+ */
+bool hasAvx2ParticleKernel();
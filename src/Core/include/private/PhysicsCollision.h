@@ -0,0 +1,74 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Contact generation between the shapes of the physics world. Box versus
+ * box clips the incident edge against the reference face like Box2D Lite,
+ * circles are tested analytically. Every contact point gets a feature id
+ * that identifies the edges or vertices it came from, so that the impulses
+ * of the last step can be reused for the same points (warm starting).
+ */
+
+#pragma once
+
+#include "Core/MathTypes.h"
+#include "Core/PhysicsWorld.h"
+#include <cstdint>
+
+/** A shape placed in the world. */
+struct CollisionShape
+{
+  ShapeType type;
+
+  Vector2 position;
+
+  /** The columns are the local axes of the shape. */
+  Matrix2 rotation;
+
+  /** The half extents of boxes, the radius of circles is x. */
+  Vector2 halfExtents;
+};
+
+struct ContactPoint
+{
+  Vector2 position;
+
+  /** Negative while the shapes overlap. */
+  float separation;
+
+  uint32_t feature;
+
+  /** The impulses accumulated by the solver. */
+  float normalImpulse;
+  float tangentImpulse;
+
+  /** Solver data computed before the iterations. */
+  Vector2 r1;
+  Vector2 r2;
+  float massNormal;
+  float massTangent;
+  float bias;
+};
+
+/** The contact points between two bodies. */
+struct Manifold
+{
+  uint32_t bodyA;
+  uint32_t bodyB;
+  uint32_t numberOfPoints;
+
+  /** Points from body A to body B. */
+  Vector2 normal;
+
+  float friction;
+  float restitution;
+
+  ContactPoint points[2];
+};
+
+/**
+ * Computes the contact points between the shapes with the normal pointing
+ * from a to b. Returns the number of points, zero if they don't touch.
+ */
+uint32_t collide(CollisionShape const & a, CollisionShape const & b,
+                 Vector2 & normal, ContactPoint * pPoints);
@@ -0,0 +1,132 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The replicated state of one frame and its bit packed delta encoding.
+ * Snapshots hold the quantized field values of all replicated objects
+ * sorted by network id, so server and client compare exactly the values
+ * that are sent. A packet contains
+ *
+ *  - the sequence of the snapshot, the sequence of the baseline it is
+ *    relative to or NO_BASELINE and the number of registered types,
+ *  - the ids of the objects that were removed since the baseline and
+ *  - the objects that are new or changed. New objects have their type mask
+ *    and all values, changed objects a bit per value telling if it changed
+ *    and the change as small difference or as full value.
+ *
+ * Objects that didn't change since the baseline cost nothing. Ids are sent
+ * as differences to the previous id with a variable length code.
+ */
+
+#pragma once
+
+#include "Core/ReplicationRegistry.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/** The sequence of packets that contain the whole state. */
+uint32_t const NO_BASELINE = 0;
+
+/** The number of snapshots servers and clients keep as baselines. */
+size_t const SNAPSHOT_HISTORY = 64;
+
+struct SnapshotObject
+{
+  uint32_t networkId;
+
+  /** One bit per registered type of which the object has a component. */
+  uint32_t typeMask;
+
+  /** The range of the values of all fields of the types in the mask. */
+  uint32_t firstValue;
+
+  uint32_t numberOfValues;
+};
+
+struct ReplicationSnapshot
+{
+  /** The sequence of the snapshot, zero for unused snapshots. */
+  uint32_t sequence{0};
+
+  /** The objects sorted by network id. */
+  std::vector<SnapshotObject> objects{};
+
+  std::vector<uint32_t> values{};
+};
+
+/** Appends values of up to 32 bits to a byte buffer, lowest bits first. */
+class BitWriter final
+{
+public:
+  /** Clears the buffer and starts writing at its beginning. */
+  explicit BitWriter(std::vector<uint8_t> & buffer);
+
+  void write(uint32_t value, uint32_t numberOfBits);
+
+  /** Writes small values with fewer bits, e.g. differences of ids. */
+  void writeVariable(uint32_t value);
+
+  /** Writes the bits that don't fill a whole byte yet. */
+  void flush();
+
+private:
+  std::vector<uint8_t> & m_buffer;
+
+  uint64_t m_bits{0};
+
+  uint32_t m_numberOfBits{0};
+};
+
+/** Reads the values written by a bit writer. */
+class BitReader final
+{
+public:
+  BitReader(uint8_t const * pData, size_t size);
+
+  /** Returns false if there are not enough bits left. */
+  bool read(uint32_t numberOfBits, uint32_t & value);
+
+  bool readVariable(uint32_t & value);
+
+private:
+  uint8_t const * m_data;
+
+  uint8_t const * m_end;
+
+  uint64_t m_bits{0};
+
+  uint32_t m_numberOfBits{0};
+};
+
+/** Returns the value of the field of the component in its quantization. */
+uint32_t quantizeField(ReplicatedField const & field,
+                       Component const & component);
+
+/** Sets the field of the component to the quantized value. */
+void applyField(ReplicatedField const & field, Component & component,
+                uint32_t value);
+
+/**
+ * Writes the snapshot to the packet, relative to the baseline if there is
+ * one, otherwise with the whole state.
+ */
+void encodeSnapshot(ReplicationSnapshot const & snapshot,
+                    ReplicationSnapshot const * pBaseline,
+                    std::vector<uint8_t> & packet);
+
+/** Reads the sequences of the snapshot and its baseline from the packet. */
+bool decodeSequences(uint8_t const * pData, size_t size, uint32_t & sequence,
+                     uint32_t & baseline);
+
+/**
+ * Reads the snapshot from the packet, using the baseline it was encoded
+ * against. Collects the indices of the objects of the snapshot that are new
+ * or changed and the ids of the removed objects. Returns false if the
+ * packet is malformed or doesn't match the baseline or the registry.
+ */
+bool decodeSnapshot(uint8_t const * pData, size_t size,
+                    ReplicationSnapshot const * pBaseline,
+                    ReplicationSnapshot & snapshot,
+                    std::vector<uint32_t> & changedObjects,
+                    std::vector<uint32_t> & removedIds);
@@ -0,0 +1,151 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The private implementation of scene objects. It's only visible inside
+ * Core, so that subsystems like prefabs can build hierarchies directly.
+ */
+
+#pragma once
+
+#include "Core/SceneObject.h"
+#include "SmallVector.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+class SceneObject::Impl final
+{
+public:
+  /** The children and components most scene objects get along with. */
+  static size_t const INLINE_CHILDREN = 4;
+
+  static size_t const INLINE_COMPONENTS = 4;
+
+  /**
+   * Accounts the memory of the scene object unless the caller accounts many
+   * of them at once.
+   */
+  explicit Impl(SceneObject * d, bool isAccounted = true);
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  static void * operator new(size_t size);
+
+  static void operator delete(void * p, size_t size);
+
+  bool addComponent(Component * pComponent);
+
+  void removeComponent(Component * pComponent);
+
+  Component * getComponent(size_t typeId) const;
+
+  SceneObject * getParent();
+
+  SceneObject const * getParent() const;
+
+  bool addChild(SceneObject * pChild);
+
+  void update(double deltaTime);
+
+  void render() const;
+
+  size_t getNumberOfChildren() const;
+
+  bool isLeafNode() const;
+
+  SceneObject * getChild(size_t index);
+
+  SceneObject const * getChild(size_t index) const;
+
+  void setEnabled(bool isEnabled);
+
+  bool isEnabled() const;
+
+  bool isEnabledInHierarchy() const;
+
+  size_t getMemoryUsage(bool includeDescendants) const;
+
+  /**
+   * Creates count detached, empty scene objects with one trip to the pool
+   * for all objects and implementations and one memory record.
+   */
+  static void createObjects(size_t count, SceneObject ** ppObjects);
+
+private:
+  friend class Prefab;
+  friend class ComponentQuery;
+  friend class ComponentIndex;
+  friend class SceneSnapshot;
+  friend class SceneVersions;
+
+  /**
+   * Removes the child from this scene object committing ownership to the
+   * caller. Only call this, if you know what you're doing.
+   */
+  void removeChild(SceneObject * child);
+
+  /** Checks if the given node is a descendant of this scene object. */
+  bool isNodeDescendant(SceneObject const * pNode) const;
+
+  /** Notifies all components of this subtree that their activation changed. */
+  void notifyActivationChanged();
+
+  /**
+   * Accounts the change of the memory held by this scene object since the
+   * last call to the memory stats. Call after the containers changed.
+   */
+  void updateMemoryUsage();
+
+  /** Returns the bytes held by this scene object without its components. */
+  size_t getOwnMemoryUsage() const;
+
+  /** Attributes the component to the memory category of its type. */
+  static void attachMemory(Component * pComponent);
+
+  /** Removes the component from the memory category of its type. */
+  static void detachMemory(Component * pComponent);
+
+  /** The parent scene object. */
+  SceneObject * m_parent{nullptr};
+
+  /** The children scene objects. */
+  SmallVector<SceneObject *, INLINE_CHILDREN> m_children{};
+
+  /**
+   * All components with a unique identifier of their class, in the order
+   * they were added. Only one instance of one specific component type is
+   * allowed, which is part of the concept. Objects have few components, a
+   * linear search beats a hash map and needs no allocation.
+   */
+  SmallVector<std::pair<size_t, Component *>, INLINE_COMPONENTS>
+      m_components{};
+
+  /**
+   * If a scene object is disabled then its components as well as its children
+   * are neither updated nor rendered.
+   */
+  bool m_isEnabled{true};
+
+  /** The bytes currently accounted to the memory stats. */
+  size_t m_accountedBytes{0};
+
+  /** Changes whenever components or children are added or removed. */
+  uint64_t m_structureVersion{0};
+
+  /** Changes with the structure of this object and its descendants. */
+  uint64_t m_subtreeStructureVersion{0};
+
+  /** Changes with the enabled flags of this subtree and its components. */
+  uint64_t m_subtreeActivationVersion{0};
+
+  SceneObject * m_d;
+};
@@ -0,0 +1,24 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The pools scene objects and components are allocated from. Sharing them
+ * inside Core lets prefabs reserve the memory of many instances at once.
+ */
+
+#pragma once
+
+#include "Core/PoolAllocator.h"
+
+/** The pool of scene objects and their implementations. */
+PoolAllocator & getSceneObjectPool();
+
+/** The pool of all components. */
+PoolAllocator & getComponentPool();
+
+/**
+ * Allocates count blocks of the size from the component pool and accounts
+ * them like Component::operator new does. Components constructed in them
+ * are deleted as usual.
+ */
+void allocateComponents(size_t size, size_t count, void ** ppBlocks);
@@ -0,0 +1,33 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Versions of the scene structure and the enabled flags, kept per scene
+ * object. A change gives the changed object and all its ancestors new
+ * versions, so scene snapshots only look at the subtrees below their root
+ * that changed since they were taken and ignore changes elsewhere. Versions
+ * are taken from one counter, equal versions mean no change. The scene is
+ * only changed from the update thread, so the counter isn't atomic.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+class SceneObject;
+
+class SceneVersions final
+{
+public:
+  /**
+   * Call after components or children were added to or removed from the
+   * scene object.
+   */
+  static void markStructureChanged(SceneObject & object);
+
+  /**
+   * Call after the enabled flag of the scene object or of one of its
+   * components changed.
+   */
+  static void markActivationChanged(SceneObject & object);
+};
@@ -0,0 +1,116 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Vector that keeps its first N elements inside the object and only goes to
+ * the heap when it grows beyond them. Scene objects hold their children and
+ * components in it, so most of them never allocate and many objects can be
+ * created in one go. The elements must be trivially destructible, e.g.
+ * pointers. The vector points into itself and can't be copied or moved.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+template <class T, size_t N> class SmallVector final
+{
+  static_assert(std::is_trivially_destructible_v<T>,
+                "The elements must be trivially destructible.");
+
+public:
+  using iterator = T *;
+
+  using const_iterator = T const *;
+
+  SmallVector() = default;
+
+  ~SmallVector()
+  {
+    if (m_data != m_inline)
+    {
+      delete[] m_data;
+    }
+  }
+
+  SmallVector(SmallVector const &) = delete;
+
+  SmallVector & operator=(SmallVector const &) = delete;
+
+  iterator begin() { return m_data; }
+
+  iterator end() { return m_data + m_size; }
+
+  const_iterator begin() const { return m_data; }
+
+  const_iterator end() const { return m_data + m_size; }
+
+  const_iterator cbegin() const { return m_data; }
+
+  const_iterator cend() const { return m_data + m_size; }
+
+  size_t size() const { return m_size; }
+
+  bool empty() const { return m_size == 0; }
+
+  size_t capacity() const { return m_capacity; }
+
+  /** Returns the bytes allocated on the heap, zero while inline. */
+  size_t getHeapSize() const
+  {
+    return m_data != m_inline ? m_capacity * sizeof(T) : 0;
+  }
+
+  T & operator[](size_t index) { return m_data[index]; }
+
+  T const & operator[](size_t index) const { return m_data[index]; }
+
+  T & back() { return m_data[m_size - 1]; }
+
+  void push_back(T const & value)
+  {
+    if (m_size == m_capacity)
+    {
+      reserve(m_capacity * 2);
+    }
+    m_data[m_size++] = value;
+  }
+
+  void pop_back() { --m_size; }
+
+  /** Removes the element and keeps the order of the others. */
+  iterator erase(iterator position)
+  {
+    std::copy(position + 1, end(), position);
+    --m_size;
+    return position;
+  }
+
+  void clear() { m_size = 0; }
+
+  void reserve(size_t capacity)
+  {
+    if (capacity <= m_capacity)
+      return;
+    T * pData = new T[capacity];
+    std::copy(begin(), end(), pData);
+    if (m_data != m_inline)
+    {
+      delete[] m_data;
+    }
+    m_data = pData;
+    m_capacity = static_cast<uint32_t>(capacity);
+  }
+
+private:
+  T m_inline[N]{};
+
+  T * m_data{m_inline};
+
+  uint32_t m_size{0};
+
+  uint32_t m_capacity{N};
+};
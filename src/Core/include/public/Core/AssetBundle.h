@@ -0,0 +1,72 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Read-only view of a cooked asset bundle. The bundle file is memory mapped
+ * as a whole, so opening it costs one file open and no decoding. Atlas
+ * pixels can be uploaded straight from the mapping and sprites are looked
+ * up by name hash.
+ */
+
+#pragma once
+
+#include "Core/AssetBundleFormat.h"
+#include "Core/CoreDll.h"
+#include <memory>
+#include <string>
+
+class AssetBundle final
+{
+public:
+  CORE_API AssetBundle();
+
+  CORE_API ~AssetBundle();
+
+  CORE_API AssetBundle(AssetBundle const &) = delete;
+
+  CORE_API AssetBundle & operator=(AssetBundle const &) = delete;
+
+  CORE_API AssetBundle(AssetBundle &&) = delete;
+
+  CORE_API AssetBundle & operator=(AssetBundle &&) = delete;
+
+  /**
+   * Maps the bundle file into memory. Returns false if the file could not be
+   * mapped or is not a valid bundle. A previously opened bundle is closed.
+   */
+  CORE_API bool open(std::string const & filename);
+
+  /** Unmaps the bundle. All pointers into the bundle become invalid. */
+  CORE_API void close();
+
+  /** Returns true if a bundle is mapped. */
+  CORE_API bool isOpen() const;
+
+  /** Returns the number of texture atlases. */
+  CORE_API size_t getNumberOfAtlases() const;
+
+  /** Returns the atlas description at the given index. Not boundary safe. */
+  CORE_API AssetBundleFormat::AtlasEntry const & getAtlas(size_t index) const;
+
+  /** Returns the pixel data of the atlas at the given index. */
+  CORE_API void const * getAtlasPixels(size_t index) const;
+
+  /** Returns the number of sprites. */
+  CORE_API size_t getNumberOfSprites() const;
+
+  /** Returns the sprite at the given index. Not boundary safe. */
+  CORE_API AssetBundleFormat::SpriteEntry const &
+  getSprite(size_t index) const;
+
+  /** Returns the sprite with the given name hash or nullptr. */
+  CORE_API AssetBundleFormat::SpriteEntry const *
+  findSprite(uint64_t nameHash) const;
+
+  /** Returns the sprite with the given name or nullptr. */
+  CORE_API AssetBundleFormat::SpriteEntry const *
+  findSprite(std::string const & name) const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,102 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * On-disk layout of cooked asset bundles. A bundle is a single file that
+ * starts with a header, followed by the atlas table, the sprite table and
+ * the raw atlas pixel data. Every block is aligned so that the runtime can
+ * map the file and hand the pixels to the GPU without decoding or copying.
+ * The layout is little endian and shared by the cooker and the runtime.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace AssetBundleFormat
+{
+
+/** Identifies a bundle file ("PTAB"). */
+constexpr uint32_t MAGIC = 0x42415450u;
+
+/** Incremented whenever the layout changes. */
+constexpr uint32_t VERSION = 1u;
+
+/** Sprite rectangles are stored in 16 bits, atlases can't be larger. */
+constexpr uint32_t MAXIMUM_ATLAS_SIZE = 0xffffu;
+
+/** Alignment of the tables in the file. */
+constexpr uint64_t TABLE_ALIGNMENT = 64u;
+
+/** Alignment of atlas pixel data, a page so it can be mapped directly. */
+constexpr uint64_t DATA_ALIGNMENT = 4096u;
+
+enum PixelFormat : uint32_t
+{
+  PIXEL_FORMAT_RGBA8 = 0
+};
+
+struct Header
+{
+  uint32_t magic;
+  uint32_t version;
+  uint32_t numberOfAtlases;
+  uint32_t numberOfSprites;
+  uint64_t atlasTableOffset;
+  uint64_t spriteTableOffset;
+  uint64_t fileSize;
+};
+
+struct AtlasEntry
+{
+  uint32_t width;
+  uint32_t height;
+  uint32_t pixelFormat;
+  uint32_t reserved;
+  uint64_t dataOffset;
+  uint64_t dataSize;
+};
+
+/**
+ * One packed sprite. The sprite table is sorted by name hash so the runtime
+ * can look sprites up with a binary search.
+ */
+struct SpriteEntry
+{
+  uint64_t nameHash;
+  uint32_t atlasIndex;
+  uint16_t x;
+  uint16_t y;
+  uint16_t width;
+  uint16_t height;
+  float u0;
+  float v0;
+  float u1;
+  float v1;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 40, "Unexpected bundle header size.");
+static_assert(sizeof(AtlasEntry) == 32, "Unexpected atlas entry size.");
+static_assert(sizeof(SpriteEntry) == 40, "Unexpected sprite entry size.");
+
+/** Returns the offset rounded up to the given power of two alignment. */
+constexpr uint64_t align(uint64_t offset, uint64_t alignment)
+{
+  return (offset + alignment - 1u) & ~(alignment - 1u);
+}
+
+/** FNV-1a hash of a sprite name as stored in the sprite table. */
+constexpr uint64_t hashName(char const * pName, size_t length)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < length; ++i)
+  {
+    hash ^= static_cast<unsigned char>(pName[i]);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+} // namespace AssetBundleFormat
@@ -0,0 +1,284 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Coroutine based component behaviors. A behavior is a coroutine that
+ * belongs to a behavior component and can wait for the next frame, for a
+ * duration or for an event:
+ *
+ *   Behavior Turret::fire()
+ *   {
+ *     while (true)
+ *     {
+ *       co_await m_targetSpotted;
+ *       shoot();
+ *       co_await delay(1.5);
+ *     }
+ *   }
+ *
+ * Waiting behaviors are resumed by the behavior scheduler only when their
+ * condition fired. Delays are kept in a timer wheel and events keep their
+ * own lists, so a waiting behavior costs nothing per frame. Coroutine frames
+ * are allocated from a pool instead of the global heap. Behaviors of
+ * inactive components are held back until the component is active again.
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include "Core/CoreDll.h"
+#include "Core/IntrusiveList.h"
+#include "Core/TimerWheel.h"
+#include <coroutine>
+#include <exception>
+
+class BehaviorComponent;
+
+/** The return type of behavior coroutines. */
+class Behavior final
+{
+public:
+  class promise_type : public IntrusiveListNode
+  {
+  public:
+    Behavior get_return_object()
+    {
+      return Behavior(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    /** Behaviors only run once they are started by their component. */
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    /** Finished behaviors destroy themselves. */
+    auto final_suspend() noexcept
+    {
+      struct FinalAwaiter
+      {
+        bool await_ready() const noexcept { return false; }
+
+        void await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+        {
+          handle.destroy();
+        }
+
+        void await_resume() const noexcept {}
+      };
+      return FinalAwaiter();
+    }
+
+    void return_void() {}
+
+    void unhandled_exception() { std::terminate(); }
+
+    /** Allocates the coroutine frame from the behavior pool. */
+    CORE_API static void * operator new(size_t size);
+
+    /** Returns the coroutine frame to the behavior pool. */
+    CORE_API static void operator delete(void * p, size_t size);
+
+    /** The component the behavior belongs to, set when it's started. */
+    BehaviorComponent * m_owner{nullptr};
+  };
+
+  using Handle = std::coroutine_handle<promise_type>;
+
+  Behavior(Behavior && other) noexcept : m_handle(other.m_handle)
+  {
+    other.m_handle = nullptr;
+  }
+
+  Behavior & operator=(Behavior && other) = delete;
+
+  Behavior(Behavior const &) = delete;
+
+  Behavior & operator=(Behavior const &) = delete;
+
+  /** Destroys the coroutine if it was never started. */
+  ~Behavior()
+  {
+    if (m_handle)
+    {
+      m_handle.destroy();
+    }
+  }
+
+private:
+  friend class BehaviorComponent;
+
+  explicit Behavior(Handle handle) : m_handle(handle) {}
+
+  Handle m_handle;
+};
+
+/** A waiting behavior, embedded in the awaiter inside its coroutine frame. */
+struct BehaviorWaitNode : public TimerNode
+{
+  Behavior::Handle handle{};
+};
+
+/** Base class of all components that run behaviors. */
+class CORE_API BehaviorComponent : public Component
+{
+
+public:
+
+  BehaviorComponent();
+
+  /** Destroys all behaviors that are still running. */
+  ~BehaviorComponent() override;
+
+  /** Runs the behavior until it waits the first time. */
+  void startBehavior(Behavior behavior);
+
+  /** Destroys all behaviors that are still running. */
+  void stopBehaviors();
+
+  /** Returns true if the component has running behaviors. */
+  bool hasBehaviors() const;
+
+protected:
+
+  void onActivationChanged() override;
+
+private:
+
+  friend class BehaviorScheduler;
+
+  /** The promises of all running behaviors. */
+  IntrusiveList<Behavior::promise_type> m_behaviors;
+
+  /** Behaviors that became ready while the component was inactive. */
+  TimerList m_pausedBehaviors;
+
+};
+
+/**
+ * Resumes waiting behaviors. Call update once per frame from the update
+ * thread, behaviors only run inside it or when they are started.
+ */
+class BehaviorScheduler final
+{
+public:
+  /** The resolution of delays. */
+  static uint64_t const TICKS_PER_SECOND = 1000;
+
+  CORE_API static BehaviorScheduler & getInstance();
+
+  BehaviorScheduler(BehaviorScheduler const &) = delete;
+
+  BehaviorScheduler & operator=(BehaviorScheduler const &) = delete;
+
+  /** Advances the time and resumes all behaviors whose condition fired. */
+  CORE_API void update(double deltaTime);
+
+  /** Returns the time passed in all updates. */
+  CORE_API double getTime() const;
+
+  /** Returns the number of behaviors resumed in the last update. */
+  CORE_API size_t getNumberOfResumed() const;
+
+  /** Resumes the behavior with the next update. */
+  CORE_API void resumeNextFrame(BehaviorWaitNode & node);
+
+  /** Resumes the behavior with the first update after the delay. */
+  CORE_API void resumeAfter(BehaviorWaitNode & node, double seconds);
+
+private:
+  BehaviorScheduler();
+
+  /** Resumes the behavior or holds it back if its owner is inactive. */
+  void resume(BehaviorWaitNode & node);
+
+  TimerWheel m_timers{};
+
+  /** Behaviors resumed with the next update. */
+  TimerList m_nextFrame{};
+
+  uint64_t m_tick{0};
+
+  double m_time{0.0};
+
+  size_t m_numberOfResumed{0};
+};
+
+/** Awaiter that resumes the behavior with the next frame. */
+struct NextFrameAwaiter
+{
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(Behavior::Handle handle)
+  {
+    m_node.handle = handle;
+    BehaviorScheduler::getInstance().resumeNextFrame(m_node);
+  }
+
+  void await_resume() const noexcept {}
+
+  BehaviorWaitNode m_node{};
+};
+
+/** Awaiter that resumes the behavior after a duration. */
+struct DelayAwaiter
+{
+  bool await_ready() const noexcept { return false; }
+
+  void await_suspend(Behavior::Handle handle)
+  {
+    m_node.handle = handle;
+    BehaviorScheduler::getInstance().resumeAfter(m_node, m_seconds);
+  }
+
+  void await_resume() const noexcept {}
+
+  double m_seconds;
+
+  BehaviorWaitNode m_node{};
+};
+
+/** Waits until the next frame. */
+inline NextFrameAwaiter nextFrame() { return NextFrameAwaiter(); }
+
+/** Waits for the given number of seconds, at least until the next frame. */
+inline DelayAwaiter delay(double seconds) { return DelayAwaiter{seconds}; }
+
+/**
+ * Event behaviors can wait for with co_await. Signaling the event resumes
+ * all behaviors waiting at that moment with the next scheduler update.
+ */
+class BehaviorEvent final
+{
+public:
+  struct Awaiter
+  {
+    bool await_ready() const noexcept { return false; }
+
+    void await_suspend(Behavior::Handle handle)
+    {
+      m_node.handle = handle;
+      m_event.m_waiting.push_back(m_node);
+    }
+
+    void await_resume() const noexcept {}
+
+    BehaviorEvent & m_event;
+
+    BehaviorWaitNode m_node{};
+  };
+
+  BehaviorEvent() = default;
+
+  BehaviorEvent(BehaviorEvent const &) = delete;
+
+  BehaviorEvent & operator=(BehaviorEvent const &) = delete;
+
+  Awaiter operator co_await() { return Awaiter{*this}; }
+
+  /** Resumes all waiting behaviors with the next update. */
+  CORE_API void signal();
+
+  /** Returns true if behaviors wait for the event. */
+  bool hasWaiting() const { return !m_waiting.empty(); }
+
+private:
+  TimerList m_waiting{};
+};
@@ -0,0 +1,67 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Component that gives the rigid body of its scene object a shape and a
+ * material. Without a rigid body the collider has no effect; static level
+ * geometry is a rigid body of type BODY_STATIC with a collider.
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include "Core/PhysicsWorld.h"
+
+class CORE_API Collider : public Component
+{
+
+public:
+
+  Collider();
+
+  ~Collider() override;
+
+  Component * clone() const override;
+
+  void setCircle(float radius);
+
+  void setBox(float halfWidth, float halfHeight);
+
+  ShapeType getShape() const;
+
+  /** Returns the half extents of boxes, the radius of circles is x. */
+  Vector2 getHalfExtents() const;
+
+  void setFriction(float friction);
+
+  float getFriction() const;
+
+  /** Sets the bounciness from 0, not at all, to 1, elastic. */
+  void setRestitution(float restitution);
+
+  float getRestitution() const;
+
+protected:
+
+  void onActivationChanged() override;
+
+private:
+
+  /** Hands the changes to the rigid body of the scene object. */
+  void updateRigidBody();
+
+  /**
+   * The scene object at the last activation change, so that a removed
+   * collider can still reset the rigid body it leaves.
+   */
+  SceneObject * m_lastSceneObject{nullptr};
+
+  ShapeType m_shape{SHAPE_BOX};
+
+  Vector2 m_halfExtents{0.5f, 0.5f};
+
+  float m_friction{0.5f};
+
+  float m_restitution{0.0f};
+
+};
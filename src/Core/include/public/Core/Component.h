@@ -9,7 +9,11 @@
 #pragma once
 
 #include "Core/CoreDll.h"
+#include <cstddef>
+#include <cstdint>
+#include <new>
 
+class MemoryCategory;
 class SceneObject;
 
 class CORE_API Component
@@ -32,7 +36,21 @@ public:
   virtual void update(double deltaTime);
 
   virtual void render() const;
-  
+
+  /**
+   * Returns a new, detached copy of the component or nullptr if the
+   * component can't be copied. Prefabs are built from such copies.
+   */
+  virtual Component * clone() const;
+
+  /**
+   * Constructs a detached copy of the component in pMemory, a block of
+   * getAllocationSize() bytes from the component pool, and returns it.
+   * Prefabs copy many components that way. Returns nullptr if the component
+   * can't be copied into memory, clone is used then.
+   */
+  virtual Component * cloneInto(void * pMemory) const;
+
   SceneObject const * getSceneObject() const;
 
   SceneObject * getSceneObject();
@@ -41,11 +59,105 @@ public:
 
   bool isEnabled() const;
 
+  /**
+   * Returns true if the component is enabled and attached to a scene object
+   * that is enabled together with all its ancestors.
+   */
+  bool isActive() const;
+
+  /**
+   * Sets how often the component wants to be updated per second. With zero,
+   * the default, it's updated every frame by its scene object. Otherwise the
+   * update scheduler updates it at about the given rate with the time passed
+   * since its last update, spread evenly over the frames.
+   */
+  void setUpdateFrequency(double hertz);
+
+  /** Returns the desired updates per second or zero for every frame. */
+  double getUpdateFrequency() const;
+
+  /**
+   * Returns the number of bytes saveState writes or zero if the component
+   * has no state to save. Scene snapshots save the state for rollbacks.
+   */
+  virtual size_t getStateSize() const;
+
+  /** Writes the state to the getStateSize() bytes at pState. */
+  virtual void saveState(void * pState) const;
+
+  /** Sets the state to one that was written by saveState. */
+  virtual void loadState(void const * pState);
+
+  /**
+   * Returns a number that is different for every state the component went
+   * through, so equal versions mean equal states.
+   */
+  uint64_t getStateVersion() const;
+
+  /**
+   * Returns the number of bytes allocated for this component by new or zero
+   * if it wasn't allocated on the heap on its own.
+   */
+  size_t getAllocationSize() const;
+
+  /** Allocates components and accounts them to the memory stats. */
+  static void * operator new(size_t size);
+
+  /** Frees components allocated by new. */
+  static void operator delete(void * p, size_t size);
+
+  /**
+   * The pool only aligns to 16 bytes, components with a bigger alignment
+   * are allocated from the global heap instead.
+   */
+  static void * operator new(size_t size, std::align_val_t alignment);
+
+  /** Frees over-aligned components allocated by new. */
+  static void operator delete(void * p, size_t size,
+                              std::align_val_t alignment);
+
 protected:
   friend class SceneObject;
+  friend class UpdateScheduler;
+  friend class ComponentIndex;
+  friend class SceneSnapshot;
+  friend class Prefab;
+  friend class PhysicsWorld;
+
+  /** Call after every change of the state that saveState writes. */
+  void markStateChanged();
+
+  /**
+   * Called whenever the result of isActive() may have changed: the component
+   * was attached, detached, enabled or disabled or a scene object above it
+   * was enabled, disabled or moved in the hierarchy.
+   */
+  virtual void onActivationChanged();
 
   SceneObject * m_sceneObject{nullptr};
 
   bool m_isEnabled{true};
 
+private:
+  size_t m_allocationSize{0};
+
+  /** The category of the component type while attached to a scene object. */
+  MemoryCategory * m_memoryCategory{nullptr};
+
+  /** Registers with the update scheduler or leaves it as needed. */
+  void updateSchedulerRegistration();
+
+  double m_updateFrequency{0.0};
+
+  /** The entry in the update scheduler or UpdateScheduler::INVALID_ENTRY. */
+  uint32_t m_updateEntry;
+
+  /** The position in the component index list of its type. */
+  uint32_t m_indexPosition{0};
+
+  /** The key of the component in its scene object while attached. */
+  size_t m_typeId{0};
+
+  uint64_t m_stateVersion;
+
 };
@@ -0,0 +1,110 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * A live list of all scene objects that have enabled components of the
+ * required types and none of the excluded types. Objects must be enabled
+ * in the hierarchy to match. The list is kept up to date whenever
+ * components are added, removed, enabled or disabled and whenever scene
+ * objects are enabled, disabled or moved, so iterating it costs only the
+ * number of matches, not the size of the scene.
+ *
+ * Matches are stored contiguously together with their required components,
+ * one column per required type in the order they were required:
+ *
+ *   ComponentQuery query;
+ *   query.require<Physics>().require<Sprite>().exclude<Frozen>();
+ *   size_t const physics = query.getColumn<Physics>();
+ *   for (size_t i = 0; i < query.getNumberOfObjects(); ++i)
+ *   {
+ *     Physics * pPhysics = query.getComponent<Physics>(i, physics);
+ *   }
+ *
+ * Queries and the scene are not thread safe. Don't change the scene while
+ * iterating matches, since a change can move the matches around. Reading
+ * and writing components of different matches in parallel is fine.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/JobSystem.h"
+#include <cstddef>
+#include <memory>
+#include <typeinfo>
+
+class Component;
+class SceneObject;
+
+class ComponentQuery final
+{
+public:
+  /** Returned by getColumn for types that aren't required. */
+  static size_t const INVALID_COLUMN = ~size_t(0);
+
+  CORE_API ComponentQuery();
+
+  CORE_API ~ComponentQuery();
+
+  CORE_API ComponentQuery(ComponentQuery const &) = delete;
+
+  CORE_API ComponentQuery & operator=(ComponentQuery const &) = delete;
+
+  CORE_API ComponentQuery(ComponentQuery &&) = delete;
+
+  CORE_API ComponentQuery & operator=(ComponentQuery &&) = delete;
+
+  /**
+   * Adds a required component type. The matches are searched again, which
+   * only visits the objects with components of the required types.
+   */
+  CORE_API ComponentQuery & require(std::type_info const & type);
+
+  /** Adds an excluded component type and searches the matches again. */
+  CORE_API ComponentQuery & exclude(std::type_info const & type);
+
+  template <class TComponent> ComponentQuery & require()
+  {
+    return require(typeid(TComponent));
+  }
+
+  template <class TComponent> ComponentQuery & exclude()
+  {
+    return exclude(typeid(TComponent));
+  }
+
+  /** Returns the number of matching scene objects. */
+  CORE_API size_t getNumberOfObjects() const;
+
+  /** Returns the matching scene object at the index. Not boundary safe. */
+  CORE_API SceneObject * getObject(size_t index) const;
+
+  /** Returns the column of the required type or INVALID_COLUMN. */
+  CORE_API size_t getColumn(std::type_info const & type) const;
+
+  template <class TComponent> size_t getColumn() const
+  {
+    return getColumn(typeid(TComponent));
+  }
+
+  /** Returns the required component of the match. Not boundary safe. */
+  CORE_API Component * getComponent(size_t index, size_t column) const;
+
+  template <class TComponent>
+  TComponent * getComponent(size_t index, size_t column) const
+  {
+    return static_cast<TComponent *>(getComponent(index, column));
+  }
+
+  /**
+   * Calls the function for ranges of at most grainSize matches on the
+   * threads of the job system.
+   */
+  CORE_API void parallelFor(size_t grainSize,
+                            JobSystem::RangeFunction const & function) const;
+
+private:
+  friend class ComponentIndex;
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,101 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Base class for components whose state is one plain data struct. Keeping
+ * the state in one place lets the engine copy it without knowing the
+ * component: prefabs clone such components and copy the data with memcpy
+ * if the data type is trivially copyable, scene snapshots save and restore
+ * trivially copyable data for rollbacks.
+ *
+ *   struct HealthData { float health; float armor; };
+ *   class Health : public DataComponent<Health, HealthData> {};
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+template <class TDerived, class TData> class DataComponent : public Component
+{
+public:
+  using Data = TData;
+
+  TData const & getData() const { return m_data; }
+
+  /**
+   * Returns the data for modification and marks the state as changed. Call
+   * it for every change instead of keeping the reference.
+   */
+  TData & editData()
+  {
+    markStateChanged();
+    return m_data;
+  }
+
+  /** Creates a default constructed TDerived and copies the data into it. */
+  Component * clone() const override
+  {
+    TDerived * pCopy = new TDerived();
+    copyData(static_cast<DataComponent &>(*pCopy).m_data, m_data);
+    return pCopy;
+  }
+
+  /**
+   * Constructs a default TDerived in the memory and copies the data. Pool
+   * memory is aligned to 16 bytes, over-aligned types are cloned instead.
+   */
+  Component * cloneInto(void * pMemory) const override
+  {
+    if constexpr (alignof(TDerived) > 16)
+    {
+      return nullptr;
+    }
+    else
+    {
+      TDerived * pCopy = ::new (pMemory) TDerived();
+      copyData(static_cast<DataComponent &>(*pCopy).m_data, m_data);
+      return pCopy;
+    }
+  }
+
+  size_t getStateSize() const override
+  {
+    return std::is_trivially_copyable_v<TData> ? sizeof(TData) : 0;
+  }
+
+  void saveState(void * pState) const override
+  {
+    if constexpr (std::is_trivially_copyable_v<TData>)
+    {
+      std::memcpy(pState, &m_data, sizeof(TData));
+    }
+  }
+
+  void loadState(void const * pState) override
+  {
+    if constexpr (std::is_trivially_copyable_v<TData>)
+    {
+      std::memcpy(&m_data, pState, sizeof(TData));
+    }
+  }
+
+  /** Copies the data, with memcpy if the type allows it. */
+  static void copyData(TData & target, TData const & source)
+  {
+    if constexpr (std::is_trivially_copyable_v<TData>)
+    {
+      std::memcpy(&target, &source, sizeof(TData));
+    }
+    else
+    {
+      target = source;
+    }
+  }
+
+protected:
+  TData m_data{};
+};
@@ -0,0 +1,74 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Hands the render state of finished updates to the renderer. In pipelined
+ * mode the renderer runs on its own thread and draws frame N from an
+ * immutable snapshot while the update of frame N+1 runs. Two snapshots are
+ * used alternately, so the update is at most one frame ahead of the
+ * renderer. In serial mode the renderer is called directly after
+ * extraction, which is the classic update, render, swap loop.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/RenderSnapshot.h"
+#include <functional>
+#include <memory>
+
+struct FrameStatistics
+{
+  /** The number of items copied into the snapshot. */
+  size_t extractedItems{0};
+
+  /** Time spent copying items into the snapshot. */
+  double extractSeconds{0.0};
+
+  /** Time the update thread waited for the renderer to release a buffer. */
+  double waitSeconds{0.0};
+};
+
+class FramePipeline final
+{
+public:
+  /** Draws one snapshot. The snapshot stays untouched while it's drawn. */
+  using RenderFunction = std::function<void(RenderSnapshot const &)>;
+
+  /**
+   * Creates the pipeline. If isPipelined is true the render function is
+   * called on a dedicated render thread.
+   */
+  CORE_API FramePipeline(RenderFunction const & render, bool isPipelined);
+
+  /** Waits for the renderer and stops the render thread. */
+  CORE_API ~FramePipeline();
+
+  CORE_API FramePipeline(FramePipeline const &) = delete;
+
+  CORE_API FramePipeline & operator=(FramePipeline const &) = delete;
+
+  CORE_API FramePipeline(FramePipeline &&) = delete;
+
+  CORE_API FramePipeline & operator=(FramePipeline &&) = delete;
+
+  /**
+   * Extracts the render state of the finished update and renders it. Call
+   * once per frame after the update. In pipelined mode the method returns
+   * as soon as the snapshot is queued for the render thread.
+   */
+  CORE_API void submitFrame();
+
+  /** Blocks until all submitted frames are rendered. */
+  CORE_API void waitForRenderer();
+
+  /** Returns true if frames are rendered on the render thread. */
+  CORE_API bool isPipelined() const;
+
+  /** Returns the statistics of the last submitted frame. */
+  CORE_API FrameStatistics const & getStatistics() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,112 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Doubly linked list whose nodes are embedded in the listed objects. Linking
+ * and unlinking never allocate and a node unlinks itself when it's
+ * destroyed, so an object can't leave a dangling entry behind.
+ */
+
+#pragma once
+
+class IntrusiveListNode
+{
+public:
+  IntrusiveListNode() = default;
+
+  ~IntrusiveListNode() { unlink(); }
+
+  IntrusiveListNode(IntrusiveListNode const &) = delete;
+
+  IntrusiveListNode & operator=(IntrusiveListNode const &) = delete;
+
+  /** Returns true if the node is part of a list. */
+  bool isLinked() const { return m_next != nullptr; }
+
+  /** Removes the node from its list, if any. */
+  void unlink()
+  {
+    if (m_next != nullptr)
+    {
+      m_prev->m_next = m_next;
+      m_next->m_prev = m_prev;
+      m_prev = nullptr;
+      m_next = nullptr;
+    }
+  }
+
+private:
+  template <class T> friend class IntrusiveList;
+
+  IntrusiveListNode * m_prev{nullptr};
+
+  IntrusiveListNode * m_next{nullptr};
+};
+
+/** List of objects of type T, which must derive from IntrusiveListNode. */
+template <class T> class IntrusiveList
+{
+public:
+  IntrusiveList()
+  {
+    m_head.m_prev = &m_head;
+    m_head.m_next = &m_head;
+  }
+
+  ~IntrusiveList() { clear(); }
+
+  IntrusiveList(IntrusiveList const &) = delete;
+
+  IntrusiveList & operator=(IntrusiveList const &) = delete;
+
+  bool empty() const { return m_head.m_next == &m_head; }
+
+  T & front() { return static_cast<T &>(*m_head.m_next); }
+
+  /** Appends the node. A node that is already linked is moved. */
+  void push_back(T & node)
+  {
+    IntrusiveListNode & hook = node;
+    hook.unlink();
+    hook.m_prev = m_head.m_prev;
+    hook.m_next = &m_head;
+    m_head.m_prev->m_next = &hook;
+    m_head.m_prev = &hook;
+  }
+
+  /** Removes and returns the first node. Not safe on empty lists. */
+  T & pop_front()
+  {
+    T & node = front();
+    static_cast<IntrusiveListNode &>(node).unlink();
+    return node;
+  }
+
+  /** Moves all nodes to the end of the other list. */
+  void spliceTo(IntrusiveList & other)
+  {
+    if (empty())
+      return;
+    IntrusiveListNode * pFirst = m_head.m_next;
+    IntrusiveListNode * pLast = m_head.m_prev;
+    pFirst->m_prev = other.m_head.m_prev;
+    pLast->m_next = &other.m_head;
+    other.m_head.m_prev->m_next = pFirst;
+    other.m_head.m_prev = pLast;
+    m_head.m_prev = &m_head;
+    m_head.m_next = &m_head;
+  }
+
+  /** Unlinks all nodes. */
+  void clear()
+  {
+    while (!empty())
+    {
+      m_head.m_next->unlink();
+    }
+  }
+
+private:
+  /** Sentinel, the list is circular through it. */
+  IntrusiveListNode m_head{};
+};
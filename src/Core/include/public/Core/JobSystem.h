@@ -0,0 +1,65 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * A pool of worker threads for data parallel loops. parallelFor splits an
+ * index range into chunks that the workers and the calling thread take from
+ * a shared counter, so a slow chunk doesn't hold back the others, and
+ * returns when all chunks are done.
+ *
+ * Loops are meant to be started from the frame thread. A parallelFor that
+ * is started while another one is running, e.g. from inside a chunk, runs
+ * serially on the calling thread.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+class JobSystem final
+{
+public:
+  /** Processes the indices [begin, end). */
+  using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+  CORE_API static JobSystem & getInstance();
+
+  CORE_API ~JobSystem();
+
+  CORE_API JobSystem(JobSystem const &) = delete;
+
+  CORE_API JobSystem & operator=(JobSystem const &) = delete;
+
+  CORE_API JobSystem(JobSystem &&) = delete;
+
+  CORE_API JobSystem & operator=(JobSystem &&) = delete;
+
+  /**
+   * Calls the function for chunks of at most grainSize indices covering
+   * [0, count) on all threads and waits until it's done. Ranges smaller
+   * than two chunks run on the calling thread only.
+   */
+  CORE_API void parallelFor(size_t count, size_t grainSize,
+                            RangeFunction const & function);
+
+  /**
+   * Returns the number of threads a loop runs on, the workers and the
+   * calling thread.
+   */
+  CORE_API size_t getNumberOfThreads() const;
+
+  /**
+   * Restarts the workers so that loops run on the given number of threads.
+   * Zero uses one thread per hardware thread, one disables the workers.
+   */
+  CORE_API void setNumberOfThreads(size_t numberOfThreads);
+
+private:
+  JobSystem();
+
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
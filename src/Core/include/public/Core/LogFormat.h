@@ -0,0 +1,205 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Layout of binary log files and of logged arguments. A log file starts
+ * with a header followed by records. Format strings are written once as
+ * format records and messages refer to them by id, so a message only costs
+ * its timestamp, thread, ids and arguments. Arguments are stored as a type
+ * byte followed by the value; the same encoding is used in the buffers of
+ * the logging threads, so messages are formatted when they are read and not
+ * when they are logged. The layout is little endian and shared by the
+ * logger and the log reader.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace LogFormat
+{
+
+/** Identifies a log file ("PTLG"). */
+constexpr uint32_t MAGIC = 0x474C5450u;
+
+/** Incremented whenever the layout changes. */
+constexpr uint32_t VERSION = 1u;
+
+/** Longer string arguments are cut off. */
+constexpr size_t MAXIMUM_STRING_LENGTH = 1024u;
+
+enum RecordType : uint8_t
+{
+  /** A format string: its id and its characters. */
+  RECORD_FORMAT = 0,
+
+  /** A message: MessageHeader followed by the encoded arguments. */
+  RECORD_MESSAGE = 1,
+
+  /** Messages of a thread were dropped: DroppedRecord. */
+  RECORD_DROPPED = 2
+};
+
+enum ArgumentType : uint8_t
+{
+  ARGUMENT_INTEGER = 0,
+  ARGUMENT_UNSIGNED = 1,
+  ARGUMENT_FLOAT = 2,
+  ARGUMENT_DOUBLE = 3,
+  ARGUMENT_BOOL = 4,
+  ARGUMENT_CHARACTER = 5,
+
+  /** A 16 bit length followed by the characters. */
+  ARGUMENT_STRING = 6,
+  ARGUMENT_POINTER = 7
+};
+
+struct Header
+{
+  uint32_t magic;
+  uint32_t version;
+
+  /** The system time of the timestamp zero in nanoseconds since 1970. */
+  uint64_t startTime;
+};
+
+/** Precedes every record, the size excludes the record header. */
+struct RecordHeader
+{
+  uint8_t type;
+  uint8_t severity;
+  uint8_t category;
+  uint8_t reserved;
+  uint32_t size;
+};
+
+struct MessageHeader
+{
+  /** Nanoseconds since the timestamp zero. */
+  uint64_t timestamp;
+  uint32_t thread;
+  uint32_t format;
+};
+
+struct DroppedRecord
+{
+  uint64_t timestamp;
+  uint64_t numberOfMessages;
+  uint32_t thread;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(Header) == 16, "Unexpected log header size.");
+static_assert(sizeof(RecordHeader) == 8, "Unexpected record header size.");
+static_assert(sizeof(MessageHeader) == 16, "Unexpected message size.");
+static_assert(sizeof(DroppedRecord) == 24, "Unexpected dropped size.");
+
+/** Returns the bytes of the argument, "(null)" for a null pointer. */
+template <class T> std::string_view getString(T const & argument)
+{
+  if constexpr (std::is_pointer_v<T>)
+  {
+    if (argument == nullptr)
+    {
+      return "(null)";
+    }
+  }
+  std::string_view const text(argument);
+  return text.size() <= MAXIMUM_STRING_LENGTH
+             ? text
+             : text.substr(0, MAXIMUM_STRING_LENGTH);
+}
+
+/** Returns the number of bytes writeArgument needs for the argument. */
+template <class T> size_t getArgumentSize(T const & argument)
+{
+  using Type = std::decay_t<T>;
+  if constexpr (std::is_same_v<Type, char *> ||
+                std::is_same_v<Type, char const *> ||
+                std::is_same_v<Type, std::string> ||
+                std::is_same_v<Type, std::string_view>)
+  {
+    return 1 + sizeof(uint16_t) + getString(argument).size();
+  }
+  else if constexpr (std::is_same_v<Type, bool> ||
+                     std::is_same_v<Type, char>)
+  {
+    return 2;
+  }
+  else if constexpr (std::is_same_v<Type, float>)
+  {
+    return 1 + sizeof(float);
+  }
+  else
+  {
+    static_assert(std::is_arithmetic_v<Type> || std::is_enum_v<Type> ||
+                      std::is_pointer_v<Type>,
+                  "The type can't be logged.");
+    return 1 + sizeof(uint64_t);
+  }
+}
+
+/** Writes the type and the value, returns the end of the written bytes. */
+template <class T> uint8_t * writeArgument(uint8_t * pData, T const & argument)
+{
+  using Type = std::decay_t<T>;
+  if constexpr (std::is_same_v<Type, char *> ||
+                std::is_same_v<Type, char const *> ||
+                std::is_same_v<Type, std::string> ||
+                std::is_same_v<Type, std::string_view>)
+  {
+    std::string_view const text = getString(argument);
+    uint16_t const length = static_cast<uint16_t>(text.size());
+    *pData = ARGUMENT_STRING;
+    std::memcpy(pData + 1, &length, sizeof(length));
+    std::memcpy(pData + 1 + sizeof(length), text.data(), text.size());
+    return pData + 1 + sizeof(length) + text.size();
+  }
+  else if constexpr (std::is_same_v<Type, bool> ||
+                     std::is_same_v<Type, char>)
+  {
+    pData[0] = std::is_same_v<Type, bool> ? ARGUMENT_BOOL : ARGUMENT_CHARACTER;
+    pData[1] = static_cast<uint8_t>(argument);
+    return pData + 2;
+  }
+  else if constexpr (std::is_same_v<Type, float>)
+  {
+    *pData = ARGUMENT_FLOAT;
+    std::memcpy(pData + 1, &argument, sizeof(float));
+    return pData + 1 + sizeof(float);
+  }
+  else
+  {
+    uint64_t value = 0;
+    if constexpr (std::is_pointer_v<Type>)
+    {
+      *pData = ARGUMENT_POINTER;
+      value = reinterpret_cast<uintptr_t>(argument);
+    }
+    else if constexpr (std::is_floating_point_v<Type>)
+    {
+      *pData = ARGUMENT_DOUBLE;
+      double const number = static_cast<double>(argument);
+      std::memcpy(&value, &number, sizeof(value));
+    }
+    else if constexpr (std::is_enum_v<Type> || std::is_signed_v<Type>)
+    {
+      *pData = ARGUMENT_INTEGER;
+      value = static_cast<uint64_t>(static_cast<int64_t>(argument));
+    }
+    else
+    {
+      *pData = ARGUMENT_UNSIGNED;
+      value = static_cast<uint64_t>(argument);
+    }
+    std::memcpy(pData + 1, &value, sizeof(value));
+    return pData + 1 + sizeof(value);
+  }
+}
+
+} // namespace LogFormat
@@ -0,0 +1,71 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Decodes binary log files written by the logger. The file is read as a
+ * whole and the messages are formatted one by one while they are read.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/Logger.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct LogEntry
+{
+  /** Nanoseconds since the logger started. */
+  uint64_t timestamp{0};
+
+  uint32_t thread{0};
+
+  LogSeverity severity{SEVERITY_INFO};
+
+  LogCategory category{CATEGORY_GENERAL};
+
+  /** The formatted message. */
+  std::string message{};
+};
+
+class LogReader final
+{
+public:
+  CORE_API LogReader();
+
+  CORE_API ~LogReader();
+
+  CORE_API LogReader(LogReader const &) = delete;
+
+  CORE_API LogReader & operator=(LogReader const &) = delete;
+
+  CORE_API LogReader(LogReader &&) = delete;
+
+  CORE_API LogReader & operator=(LogReader &&) = delete;
+
+  /**
+   * Reads the log file. Returns false if the file could not be read or is
+   * not a log file. A previously opened file is closed.
+   */
+  CORE_API bool open(std::string const & filename);
+
+  /**
+   * Reads the next message. Returns false at the end of the file or if the
+   * rest of it is malformed, e.g. because the writer didn't finish it.
+   */
+  CORE_API bool read(LogEntry & entry);
+
+  /** Returns the system time of the timestamp zero in ns since 1970. */
+  CORE_API uint64_t getStartTime() const;
+
+  /** Returns true if the file ended with a malformed record. */
+  CORE_API bool isTruncated() const;
+
+  /** Formats the entry as one line like the logger's text output. */
+  CORE_API static std::string formatEntry(LogEntry const & entry);
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,216 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Asynchronous logging that keeps formatting and output off the logging
+ * threads. Every thread writes its messages into its own lock free ring
+ * buffer: a timestamp, the severity and category, the pointer to the format
+ * string and the encoded arguments. A background thread collects the
+ * messages of all threads in timestamp order, formats them and writes them
+ * to the console, a text file and a binary log file. A full buffer drops the
+ * message instead of blocking and the drop is reported later.
+ *
+ *   CORE_LOG_INFO(CATEGORY_PHYSICS, "{} bodies in {} islands", bodies,
+ *                 islands);
+ *
+ * Format strings use {} for the arguments and must outlive the logger,
+ * string literals do. The macros compile out messages below
+ * CORE_LOG_MINIMUM_SEVERITY or of the categories in the bit mask
+ * CORE_LOG_DISABLED_CATEGORIES, without evaluating the arguments. The check
+ * is expanded at the call site, so both can be defined per target or per
+ * file. Further messages can be filtered at runtime.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/LogFormat.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/** Without a definition, debug builds log everything and others from info. */
+#ifndef CORE_LOG_MINIMUM_SEVERITY
+#ifdef NDEBUG
+#define CORE_LOG_MINIMUM_SEVERITY 2
+#else
+#define CORE_LOG_MINIMUM_SEVERITY 0
+#endif
+#endif
+
+#ifndef CORE_LOG_DISABLED_CATEGORIES
+#define CORE_LOG_DISABLED_CATEGORIES 0
+#endif
+
+enum LogSeverity
+{
+  SEVERITY_TRACE = 0,
+  SEVERITY_DEBUG = 1,
+  SEVERITY_INFO = 2,
+  SEVERITY_WARNING = 3,
+  SEVERITY_ERROR = 4,
+  NUMBER_OF_SEVERITIES = 5
+};
+
+enum LogCategory
+{
+  CATEGORY_GENERAL = 0,
+  CATEGORY_CORE = 1,
+  CATEGORY_RENDERING = 2,
+  CATEGORY_PHYSICS = 3,
+  CATEGORY_NETWORK = 4,
+  CATEGORY_ASSETS = 5,
+  CATEGORY_INPUT = 6,
+  CATEGORY_GAME = 7,
+  NUMBER_OF_CATEGORIES = 8
+};
+
+/** Returns the name of the severity, e.g. "WARNING". */
+CORE_API char const * getSeverityName(LogSeverity severity);
+
+/** Returns the name of the category, e.g. "Physics". */
+CORE_API char const * getCategoryName(LogCategory category);
+
+/**
+ * Returns true if messages of the severity and category pass the minimum
+ * severity and the bit mask of disabled categories.
+ */
+constexpr bool isLogCompiledIn(LogSeverity severity, LogCategory category,
+                               int minimumSeverity,
+                               uint32_t disabledCategories)
+{
+  return severity >= minimumSeverity &&
+         ((disabledCategories >> category) & 1) == 0;
+}
+
+class Logger final
+{
+public:
+  CORE_API static Logger & getInstance();
+
+  CORE_API ~Logger();
+
+  CORE_API Logger(Logger const &) = delete;
+
+  CORE_API Logger & operator=(Logger const &) = delete;
+
+  CORE_API Logger(Logger &&) = delete;
+
+  CORE_API Logger & operator=(Logger &&) = delete;
+
+  /**
+   * Logs the message unless it's filtered at runtime. Costs a few copies and
+   * never blocks. Use the CORE_LOG_* macros, which also compile messages out.
+   */
+  template <LogSeverity severity, LogCategory category, class... TArguments>
+  static void log(char const * format, TArguments const &... arguments)
+  {
+    Logger & logger = getInstance();
+    if (logger.isEnabled(severity, category))
+    {
+      size_t const size =
+          (size_t{0} + ... + LogFormat::getArgumentSize(arguments));
+      uint8_t * pData = logger.beginMessage(severity, category, format, size);
+      if (pData != nullptr)
+      {
+        ((pData = LogFormat::writeArgument(pData, arguments)), ...);
+        logger.endMessage();
+      }
+    }
+  }
+
+  /** Returns true if messages of the severity and category are logged. */
+  bool isEnabled(LogSeverity severity, LogCategory category) const
+  {
+    return ((m_categoryMasks[severity].load(std::memory_order_relaxed) >>
+             category) &
+            1) != 0;
+  }
+
+  /** Filters messages below the severity, the default is SEVERITY_TRACE. */
+  CORE_API void setMinimumSeverity(LogSeverity severity);
+
+  CORE_API void setCategoryEnabled(LogCategory category, bool isEnabled);
+
+  /** Enables or disables writing messages to stdout, enabled by default. */
+  CORE_API void setConsoleOutput(bool isEnabled);
+
+  /**
+   * Writes the messages formatted to the text file. Returns false if the
+   * file couldn't be opened. A previously opened text file is closed.
+   */
+  CORE_API bool openTextFile(std::string const & filename);
+
+  /**
+   * Writes the messages unformatted to the binary log file, read it with
+   * LogReader. Returns false if the file couldn't be opened. A previously
+   * opened binary file is closed.
+   */
+  CORE_API bool openBinaryFile(std::string const & filename);
+
+  /** Writes the pending messages and closes both files. */
+  CORE_API void closeFiles();
+
+  /** Blocks until all messages logged before are written. */
+  CORE_API void flush();
+
+  /** Returns the number of messages dropped because a buffer was full. */
+  CORE_API uint64_t getNumberOfDroppedMessages() const;
+
+private:
+  CORE_API Logger();
+
+  /**
+   * Reserves a message with argumentSize bytes of arguments in the buffer
+   * of the calling thread and returns where to write them, nullptr if the
+   * buffer is full.
+   */
+  CORE_API uint8_t * beginMessage(LogSeverity severity, LogCategory category,
+                                  char const * format, size_t argumentSize);
+
+  /** Hands the reserved message to the writer thread. */
+  CORE_API void endMessage();
+
+  /** Updates the runtime filter of every severity. */
+  void updateCategoryMasks();
+
+  /** One bit per category for every severity. */
+  std::atomic<uint32_t> m_categoryMasks[NUMBER_OF_SEVERITIES];
+
+  /** Set from any thread, the masks are derived from them. */
+  std::atomic<LogSeverity> m_minimumSeverity{SEVERITY_TRACE};
+
+  std::atomic<uint32_t> m_enabledCategories{(1u << NUMBER_OF_CATEGORIES) - 1};
+
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+/** Logs a message of the severity, see the macros below. */
+#define CORE_LOG(severity, category, ...)                                    \
+  do                                                                         \
+  {                                                                          \
+    if constexpr (isLogCompiledIn(severity, category,                        \
+                                  CORE_LOG_MINIMUM_SEVERITY,                 \
+                                  CORE_LOG_DISABLED_CATEGORIES))             \
+    {                                                                        \
+      Logger::log<severity, category>(__VA_ARGS__);                          \
+    }                                                                        \
+  } while (false)
+
+#define CORE_LOG_TRACE(category, ...)                                        \
+  CORE_LOG(SEVERITY_TRACE, category, __VA_ARGS__)
+
+#define CORE_LOG_DEBUG(category, ...)                                        \
+  CORE_LOG(SEVERITY_DEBUG, category, __VA_ARGS__)
+
+#define CORE_LOG_INFO(category, ...)                                         \
+  CORE_LOG(SEVERITY_INFO, category, __VA_ARGS__)
+
+#define CORE_LOG_WARNING(category, ...)                                      \
+  CORE_LOG(SEVERITY_WARNING, category, __VA_ARGS__)
+
+#define CORE_LOG_ERROR(category, ...)                                        \
+  CORE_LOG(SEVERITY_ERROR, category, __VA_ARGS__)
@@ -0,0 +1,239 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Memory accounting of the engine. Memory is tracked in categories, one per
+ * subsystem, per object type (e.g. scene objects) and per component type.
+ * Every category counts its live instances and bytes. The counters can be
+ * queried at any time and a snapshot of all categories can be diffed
+ * against an earlier one to find growth between two points in time.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <iosfwd>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+enum MemoryCategoryType
+{
+  MEMORY_SUBSYSTEM = 0,
+  MEMORY_OBJECT_TYPE = 1,
+  MEMORY_COMPONENT_TYPE = 2
+};
+
+struct MemoryCounters
+{
+  /** The number of live instances. */
+  int64_t liveCount{0};
+
+  /** The number of bytes held by the live instances. */
+  int64_t liveBytes{0};
+
+  /** The highest number of live bytes ever seen. */
+  int64_t peakBytes{0};
+
+  /** The number of instances ever allocated. */
+  int64_t totalAllocations{0};
+};
+
+/**
+ * The counters of one category. Recording is lock free and may happen from
+ * any thread.
+ */
+class MemoryCategory final
+{
+public:
+  MemoryCategory(std::string const & name, MemoryCategoryType type)
+      : m_name(name), m_type(type)
+  {
+  }
+
+  MemoryCategory(MemoryCategory const &) = delete;
+
+  MemoryCategory & operator=(MemoryCategory const &) = delete;
+
+  /** Records a new instance holding the given number of bytes. */
+  void recordAllocation(size_t bytes)
+  {
+    m_liveCount.fetch_add(1, std::memory_order_relaxed);
+    m_totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    recordResize(static_cast<int64_t>(bytes));
+  }
+
+  /** Records count new instances holding the given number of bytes. */
+  void recordAllocations(size_t count, size_t bytes)
+  {
+    m_liveCount.fetch_add(static_cast<int64_t>(count),
+                          std::memory_order_relaxed);
+    m_totalAllocations.fetch_add(static_cast<int64_t>(count),
+                                 std::memory_order_relaxed);
+    recordResize(static_cast<int64_t>(bytes));
+  }
+
+  /** Records the release of an instance holding the given number of bytes. */
+  void recordDeallocation(size_t bytes)
+  {
+    m_liveCount.fetch_sub(1, std::memory_order_relaxed);
+    recordResize(-static_cast<int64_t>(bytes));
+  }
+
+  /** Records that a live instance grew or shrank by the given bytes. */
+  void recordResize(int64_t deltaBytes)
+  {
+    int64_t const liveBytes =
+        m_liveBytes.fetch_add(deltaBytes, std::memory_order_relaxed) +
+        deltaBytes;
+    int64_t peakBytes = m_peakBytes.load(std::memory_order_relaxed);
+    while (liveBytes > peakBytes &&
+           !m_peakBytes.compare_exchange_weak(peakBytes, liveBytes,
+                                              std::memory_order_relaxed))
+    {
+    }
+  }
+
+  MemoryCounters getCounters() const
+  {
+    MemoryCounters counters;
+    counters.liveCount = m_liveCount.load(std::memory_order_relaxed);
+    counters.liveBytes = m_liveBytes.load(std::memory_order_relaxed);
+    counters.peakBytes = m_peakBytes.load(std::memory_order_relaxed);
+    counters.totalAllocations =
+        m_totalAllocations.load(std::memory_order_relaxed);
+    return counters;
+  }
+
+  std::string const & getName() const { return m_name; }
+
+  MemoryCategoryType getType() const { return m_type; }
+
+private:
+  std::string const m_name;
+
+  MemoryCategoryType const m_type;
+
+  std::atomic<int64_t> m_liveCount{0};
+
+  std::atomic<int64_t> m_liveBytes{0};
+
+  std::atomic<int64_t> m_peakBytes{0};
+
+  std::atomic<int64_t> m_totalAllocations{0};
+};
+
+/** The counters of all categories at one point in time. */
+struct MemorySnapshot
+{
+  struct Entry
+  {
+    std::string name{};
+
+    MemoryCategoryType type{MEMORY_SUBSYSTEM};
+
+    MemoryCounters counters{};
+  };
+
+  std::vector<Entry> entries{};
+
+  /**
+   * Returns the change of all counters from the earlier to the later
+   * snapshot. Categories that didn't change are left out.
+   */
+  CORE_API static MemorySnapshot diff(MemorySnapshot const & earlier,
+                                      MemorySnapshot const & later);
+
+  /** Writes the snapshot as a table, grouped by category type. */
+  CORE_API void dump(std::ostream & stream) const;
+};
+
+class MemoryStats final
+{
+public:
+  CORE_API static MemoryStats & getInstance();
+
+  MemoryStats(MemoryStats const &) = delete;
+
+  MemoryStats & operator=(MemoryStats const &) = delete;
+
+  /** Returns the category of the subsystem, it's created on first use. */
+  CORE_API MemoryCategory & getSubsystem(std::string const & name);
+
+  /** Returns the category of the object type, it's created on first use. */
+  CORE_API MemoryCategory & getObjectType(std::string const & name);
+
+  /** Returns the category of the component type, created on first use. */
+  CORE_API MemoryCategory & getComponentType(std::type_info const & type);
+
+  /** Returns the current counters of all categories. */
+  CORE_API MemorySnapshot takeSnapshot() const;
+
+private:
+  MemoryStats();
+
+  MemoryCategory & getCategory(std::string const & name,
+                               MemoryCategoryType type);
+
+  mutable std::mutex m_mutex{};
+
+  /** All categories. A deque keeps references stable while growing. */
+  std::deque<MemoryCategory> m_categories{};
+
+  std::unordered_map<std::string, MemoryCategory *> m_namedCategories{};
+
+  std::unordered_map<std::type_index, MemoryCategory *> m_componentTypes{};
+};
+
+/**
+ * Standard allocator that accounts all its memory to a category, so that
+ * containers of a subsystem show up in its counters.
+ */
+template <class T> class TrackedAllocator
+{
+public:
+  using value_type = T;
+
+  explicit TrackedAllocator(MemoryCategory & category) : m_category(&category)
+  {
+  }
+
+  template <class U>
+  TrackedAllocator(TrackedAllocator<U> const & other)
+      : m_category(other.getCategory())
+  {
+  }
+
+  T * allocate(size_t count)
+  {
+    m_category->recordAllocation(count * sizeof(T));
+    return static_cast<T *>(::operator new(count * sizeof(T)));
+  }
+
+  void deallocate(T * p, size_t count)
+  {
+    m_category->recordDeallocation(count * sizeof(T));
+    ::operator delete(p);
+  }
+
+  MemoryCategory * getCategory() const { return m_category; }
+
+  template <class U> bool operator==(TrackedAllocator<U> const & other) const
+  {
+    return m_category == other.getCategory();
+  }
+
+  template <class U> bool operator!=(TrackedAllocator<U> const & other) const
+  {
+    return m_category != other.getCategory();
+  }
+
+private:
+  MemoryCategory * m_category;
+};
@@ -0,0 +1,158 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Component that spawns and simulates many short lived particles. The
+ * particles aren't scene objects: they live in one structure of arrays per
+ * emitter, which is allocated once with the capacity of the emitter. Every
+ * update spawns new particles, integrates all of them with a vectorized
+ * kernel (AVX2 if the processor has it, scalar code otherwise) and
+ * compacts the arrays by moving the last particles into the gaps of the
+ * dead ones. Large emitters can be split across the threads of the job
+ * system.
+ *
+ * Renderers read the arrays directly, the first getNumberOfParticles()
+ * entries of each are alive.
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include <cstdint>
+#include <vector>
+
+struct ParticleEmitterSettings
+{
+  /** The maximum number of live particles. */
+  size_t capacity{10000};
+
+  /** The number of particles spawned per second. */
+  float rate{1000.0f};
+
+  /** The center particles are spawned around. */
+  float positionX{0.0f};
+  float positionY{0.0f};
+
+  /** Particles spawn up to this far from the center on both axes. */
+  float spread{0.0f};
+
+  /** The mean start velocity and its random variation on both axes. */
+  float velocityX{0.0f};
+  float velocityY{0.0f};
+  float velocityVariance{1.0f};
+
+  /** The lifetime in seconds is picked evenly from this range. */
+  float minimumLifetime{1.0f};
+  float maximumLifetime{2.0f};
+
+  /** The constant acceleration, e.g. gravity. */
+  float accelerationX{0.0f};
+  float accelerationY{0.0f};
+
+  /** The fraction of the velocity lost per second. */
+  float drag{0.0f};
+};
+
+class CORE_API ParticleEmitter : public Component
+{
+
+public:
+
+  ParticleEmitter();
+
+  ~ParticleEmitter() override;
+
+  /** Spawns, integrates and removes particles. */
+  void update(double deltaTime) override;
+
+  Component * clone() const override;
+
+  /**
+   * Applies the settings. A new capacity reallocates the arrays and removes
+   * all particles.
+   */
+  void setSettings(ParticleEmitterSettings const & settings);
+
+  ParticleEmitterSettings const & getSettings() const;
+
+  /** Spawns up to count particles at once, as far as the capacity allows. */
+  void emit(size_t count);
+
+  /** Removes all particles. */
+  void clear();
+
+  size_t getNumberOfParticles() const;
+
+  size_t getCapacity() const;
+
+  /**
+   * Splits emitters with more than this many particles into chunks of this
+   * size on the job system. Zero, the default, always runs on the calling
+   * thread.
+   */
+  void setParallelGrainSize(size_t grainSize);
+
+  size_t getParallelGrainSize() const;
+
+  /** Uses the AVX2 kernel if it's available, the default, or scalar code. */
+  void setVectorized(bool isVectorized);
+
+  /** Returns true if the AVX2 kernel is used. */
+  bool isVectorized() const;
+
+  float const * getPositionsX() const;
+
+  float const * getPositionsY() const;
+
+  float const * getVelocitiesX() const;
+
+  float const * getVelocitiesY() const;
+
+  /** Returns the remaining lifetimes in seconds. */
+  float const * getLives() const;
+
+private:
+
+  /** Allocates the arrays for the capacity of the settings. */
+  void allocate();
+
+  /** Spawns the given number of particles behind the live ones. */
+  void spawn(size_t count);
+
+  /** Moves the last live particles into the gaps of the dead ones. */
+  void compact();
+
+  ParticleEmitterSettings m_settings{};
+
+  /** All arrays in one aligned block. */
+  float * m_memory{nullptr};
+
+  size_t m_allocatedBytes{0};
+
+  float * m_positionX{nullptr};
+  float * m_positionY{nullptr};
+  float * m_velocityX{nullptr};
+  float * m_velocityY{nullptr};
+  float * m_life{nullptr};
+
+  size_t m_numberOfParticles{0};
+
+  /** The fraction of a particle left over from the last spawn. */
+  double m_spawnRemainder{0.0};
+
+  /** The dead particles of each chunk, stored at the chunk's offset. */
+  std::vector<uint32_t> m_dead{};
+
+  std::vector<size_t> m_deadPerChunk{};
+
+  /** The number of particles per chunk of the last update. */
+  size_t m_chunkSize{0};
+
+  size_t m_grainSize{0};
+
+  bool m_isVectorized{true};
+
+  /** The state of the xorshift generator used for spawning. */
+  uint32_t m_random{0x9e3779b9u};
+
+};
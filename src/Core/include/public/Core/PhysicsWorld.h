@@ -0,0 +1,185 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * 2D rigid body physics. The world owns all bodies in slots of contiguous
+ * arrays and advances them in fixed time steps, independent of the frame
+ * rate. Every step
+ *
+ *  - finds overlapping bounding boxes with a uniform grid,
+ *  - generates contact points for them in parallel,
+ *  - groups the touching bodies into islands that don't share a dynamic
+ *    body and
+ *  - solves the islands in parallel with sequential impulses, warm started
+ *    with the impulses of the last step.
+ *
+ * Every island is solved by one thread in a fixed order, so the result is
+ * the same for any number of threads. The physics world is only accessed
+ * from the update thread.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/MathTypes.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class Component;
+
+enum BodyType
+{
+  BODY_STATIC = 0,
+  BODY_KINEMATIC = 1,
+  BODY_DYNAMIC = 2
+};
+
+enum ShapeType
+{
+  SHAPE_NONE = 0,
+  SHAPE_CIRCLE = 1,
+  SHAPE_BOX = 2
+};
+
+/** The state of a body that changes with every step. */
+struct BodyMotion
+{
+  float positionX{0.0f};
+  float positionY{0.0f};
+
+  /** The rotation in radians. */
+  float angle{0.0f};
+
+  float velocityX{0.0f};
+  float velocityY{0.0f};
+  float angularVelocity{0.0f};
+};
+
+/** The shape and material of a body. */
+struct BodyDefinition
+{
+  BodyType type{BODY_DYNAMIC};
+
+  /** Bodies without a shape move but don't collide. */
+  ShapeType shape{SHAPE_NONE};
+
+  /** The half extents of boxes, the radius of circles is halfWidth. */
+  float halfWidth{0.5f};
+  float halfHeight{0.5f};
+
+  /** The mass per area of dynamic bodies. */
+  float density{1.0f};
+
+  float friction{0.5f};
+
+  float restitution{0.0f};
+};
+
+struct PhysicsStatistics
+{
+  /** The number of steps taken in the last update. */
+  size_t numberOfSteps{0};
+
+  /** The following are the numbers of the last step. */
+  size_t numberOfBodies{0};
+  size_t numberOfPairs{0};
+  size_t numberOfContacts{0};
+  size_t numberOfIslands{0};
+
+  /** The time spent in the phases of the last step. */
+  double broadphaseSeconds{0.0};
+  double narrowphaseSeconds{0.0};
+  double solverSeconds{0.0};
+};
+
+class PhysicsWorld final
+{
+public:
+  CORE_API static PhysicsWorld & getInstance();
+
+  CORE_API ~PhysicsWorld();
+
+  CORE_API PhysicsWorld(PhysicsWorld const &) = delete;
+
+  CORE_API PhysicsWorld & operator=(PhysicsWorld const &) = delete;
+
+  CORE_API PhysicsWorld(PhysicsWorld &&) = delete;
+
+  CORE_API PhysicsWorld & operator=(PhysicsWorld &&) = delete;
+
+  /**
+   * Creates a disabled body without a shape and returns its slot. Steps
+   * that move the body change the state version of the owner, so scene
+   * snapshots save its new motion.
+   */
+  CORE_API uint32_t createBody(Component * pOwner = nullptr);
+
+  /** Removes the body and makes its slot available again. */
+  CORE_API void destroyBody(uint32_t slot);
+
+  /** Sets shape and material and recomputes the mass of the body. */
+  CORE_API void setDefinition(uint32_t slot, BodyDefinition const & definition);
+
+  CORE_API BodyDefinition const & getDefinition(uint32_t slot) const;
+
+  /** Returns the state of the body for modification. Not boundary safe. */
+  CORE_API BodyMotion & editMotion(uint32_t slot);
+
+  CORE_API BodyMotion const & getMotion(uint32_t slot) const;
+
+  /**
+   * Returns the state between the last two steps that matches the time
+   * left over in the last update, for smooth rendering.
+   */
+  CORE_API BodyMotion getInterpolatedMotion(uint32_t slot) const;
+
+  /** Disabled bodies are neither moved nor collided with. */
+  CORE_API void setEnabled(uint32_t slot, bool isEnabled);
+
+  CORE_API bool isEnabled(uint32_t slot) const;
+
+  /**
+   * Call after moving the body with editMotion instead of simulating it
+   * there, so it isn't interpolated from its old place.
+   */
+  CORE_API void teleport(uint32_t slot);
+
+  /** Changes the velocity of a dynamic body by the impulse. */
+  CORE_API void applyImpulse(uint32_t slot, Vector2 const & impulse);
+
+  /** Takes as many fixed steps as fit into the passed time. */
+  CORE_API void update(double deltaTime);
+
+  /** Takes exactly one fixed step. */
+  CORE_API void step();
+
+  /** Sets the length of one step in seconds, by default 1/120. */
+  CORE_API void setTimeStep(double seconds);
+
+  CORE_API double getTimeStep() const;
+
+  /**
+   * Sets the maximum number of steps per update. Time that doesn't fit is
+   * dropped, so a slow frame can't make the next one even slower.
+   */
+  CORE_API void setMaximumSteps(size_t maximumSteps);
+
+  /** Sets the number of solver iterations per step, by default 10. */
+  CORE_API void setIterations(size_t iterations);
+
+  CORE_API void setGravity(Vector2 const & gravity);
+
+  CORE_API Vector2 getGravity() const;
+
+  /** Returns the number of slots, used or not. */
+  CORE_API size_t getNumberOfSlots() const;
+
+  CORE_API PhysicsStatistics const & getStatistics() const;
+
+private:
+  PhysicsWorld();
+
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,79 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Allocator for many small, short lived blocks such as coroutine frames.
+ * Blocks are rounded up to size classes of 16 bytes and served from stacks
+ * of free blocks that are refilled a whole chunk at a time, so allocating
+ * and freeing pops and pushes a pointer instead of a trip to the global
+ * heap. The stacks live outside the blocks, taking many blocks at once
+ * copies pointers instead of chasing them through cold memory. Memory is
+ * never returned to the system, freed blocks are reused. Blocks larger than
+ * the biggest size class fall back to the global heap.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+class MemoryCategory;
+
+class PoolAllocator final
+{
+public:
+  /** The granularity of the size classes. */
+  static size_t const GRANULARITY = 16;
+
+  /** The biggest block served from the pool. */
+  static size_t const MAX_BLOCK_SIZE = 1024;
+
+  /** Creates a pool whose memory is accounted to the subsystem. */
+  CORE_API explicit PoolAllocator(char const * pSubsystemName);
+
+  CORE_API ~PoolAllocator();
+
+  PoolAllocator(PoolAllocator const &) = delete;
+
+  PoolAllocator & operator=(PoolAllocator const &) = delete;
+
+  /**
+   * Returns a block of at least the given size, aligned to 16 bytes. Types
+   * with a bigger alignment can't be allocated from the pool.
+   */
+  CORE_API void * allocate(size_t size);
+
+  /**
+   * Writes count blocks of at least the given size to ppBlocks, taking the
+   * lock and refilling at most once. Each block is freed with deallocate.
+   */
+  CORE_API void allocate(size_t size, size_t count, void ** ppBlocks);
+
+  /** Returns the block to the pool. The size must match the allocation. */
+  CORE_API void deallocate(void * p, size_t size);
+
+  /**
+   * Makes sure that the given number of blocks of the size can be allocated
+   * without refilling, with a single chunk allocation.
+   */
+  CORE_API void reserve(size_t size, size_t count);
+
+private:
+  /** Returns the size class of the block size. */
+  static size_t getSizeClass(size_t size);
+
+  /** Adds a chunk of count blocks to the free blocks of the size class. */
+  void refill(size_t sizeClass, size_t count);
+
+  std::mutex m_mutex{};
+
+  /** The free blocks of each size class, the next one to hand out last. */
+  std::vector<std::vector<void *>> m_freeBlocks;
+
+  /** All chunks, released when the pool is destroyed. */
+  std::vector<void *> m_chunks{};
+
+  MemoryCategory & m_memory;
+};
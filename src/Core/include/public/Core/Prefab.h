@@ -0,0 +1,74 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Immutable template of a scene object subtree. A prefab captures the
+ * hierarchy, the enabled flags and a detached copy of every component once.
+ * Instantiating it creates any number of copies in one call: the memory of
+ * each prototype's copies is taken from the pool in one go, each instance's
+ * objects with one pool trip, components are copied into the blocks with
+ * cloneInto and the hierarchy is linked without the checks addChild has to
+ * do for arbitrary objects. Each instance is completed while its memory is
+ * still in the cache, the index lists, memory stats and the structure
+ * version of the parent are updated once per call.
+ *
+ * Only components that implement clone can be captured, e.g. all
+ * DataComponents. Components without cloneInto are cloned one by one.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <memory>
+#include <vector>
+
+class SceneObject;
+
+class Prefab final
+{
+public:
+  CORE_API Prefab();
+
+  CORE_API ~Prefab();
+
+  CORE_API Prefab(Prefab const &) = delete;
+
+  CORE_API Prefab & operator=(Prefab const &) = delete;
+
+  CORE_API Prefab(Prefab &&) = delete;
+
+  CORE_API Prefab & operator=(Prefab &&) = delete;
+
+  /**
+   * Captures the subtree starting at the given scene object. If a component
+   * of the subtree can't be cloned the method returns false and the prefab
+   * stays empty. A previous capture is replaced.
+   */
+  CORE_API bool capture(SceneObject const & root);
+
+  /** Returns true if nothing was captured. */
+  CORE_API bool isEmpty() const;
+
+  /** Returns the number of scene objects of one instance. */
+  CORE_API size_t getNumberOfObjects() const;
+
+  /** Returns the number of components of one instance. */
+  CORE_API size_t getNumberOfComponents() const;
+
+  /**
+   * Creates an instance and returns its root, which is added to the parent
+   * if one is given. Returns nullptr if the prefab is empty.
+   */
+  CORE_API SceneObject * instantiate(SceneObject * pParent = nullptr) const;
+
+  /**
+   * Creates count instances and appends their roots to the vector. If a
+   * parent is given the roots are added to it.
+   */
+  CORE_API void instantiate(size_t count, std::vector<SceneObject *> & roots,
+                            SceneObject * pParent = nullptr) const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,72 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Component that makes its scene object visible. It owns one item of the
+ * render world and writes every change straight into it, so the renderer
+ * only ever reads the extracted snapshots and never the scene itself.
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include "Core/MathTypes.h"
+#include "Core/RenderSnapshot.h"
+#include <cstdint>
+
+class CORE_API RenderComponent : public Component
+{
+
+public:
+
+  RenderComponent();
+
+  ~RenderComponent() override;
+
+  Component * clone() const override;
+
+  /** The state is the draw item without its visibility. */
+  size_t getStateSize() const override;
+
+  void saveState(void * pState) const override;
+
+  void loadState(void const * pState) override;
+
+  void setPosition(Vector2 const & position);
+
+  Vector2 getPosition() const;
+
+  /** Sets the rotation in radians. */
+  void setRotation(float rotation);
+
+  float getRotation() const;
+
+  void setScale(Vector2 const & scale);
+
+  Vector2 getScale() const;
+
+  void setSprite(uint64_t spriteId);
+
+  uint64_t getSprite() const;
+
+  /** Sets the packed RGBA8 tint color. */
+  void setColor(uint32_t color);
+
+  uint32_t getColor() const;
+
+  void setLayer(int32_t layer);
+
+  int32_t getLayer() const;
+
+  /** Returns the slot of the item in the render world. */
+  uint32_t getSlot() const;
+
+protected:
+
+  void onActivationChanged() override;
+
+private:
+
+  uint32_t m_slot;
+
+};
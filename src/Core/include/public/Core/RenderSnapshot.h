@@ -0,0 +1,52 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Immutable copy of everything the renderer needs from one frame. Snapshots
+ * are filled by the render world after the update and consumed by the
+ * renderer, possibly on another thread while the next update runs.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * The render relevant state of one render component. Plain data so that
+ * extraction is a trivial copy.
+ */
+struct DrawItem
+{
+  float positionX{0.0f};
+
+  float positionY{0.0f};
+
+  /** Rotation in radians. */
+  float rotation{0.0f};
+
+  float scaleX{1.0f};
+
+  float scaleY{1.0f};
+
+  /** The sprite to draw, e.g. a sprite hash of an asset bundle. */
+  uint64_t spriteId{0};
+
+  /** Packed RGBA8 tint color. */
+  uint32_t color{0xffffffffu};
+
+  /** Items with lower layers are drawn first. */
+  int32_t layer{0};
+
+  /** Invisible items and unused slots aren't drawn. */
+  bool isVisible{false};
+};
+
+struct RenderSnapshot
+{
+  /** The number of the frame the snapshot was extracted from. */
+  uint64_t frame{0};
+
+  /** All items indexed by their slot in the render world. */
+  std::vector<DrawItem> items{};
+};
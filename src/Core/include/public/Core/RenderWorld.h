@@ -0,0 +1,72 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Owns the live render state of all render components in slots of one
+ * contiguous array. Changing a slot marks it dirty for both snapshot
+ * buffers, so extraction only copies what changed since a buffer was
+ * last filled instead of walking the whole scene. The render world is only
+ * accessed from the update thread.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/RenderSnapshot.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class RenderWorld final
+{
+public:
+  /** The number of snapshot buffers that are kept up to date. */
+  static size_t const NUMBER_OF_BUFFERS = 2;
+
+  CORE_API static RenderWorld & getInstance();
+
+  RenderWorld(RenderWorld const &) = delete;
+
+  RenderWorld & operator=(RenderWorld const &) = delete;
+
+  /** Creates a new invisible item and returns its slot. */
+  CORE_API uint32_t createItem();
+
+  /** Hides the item and makes its slot available again. */
+  CORE_API void destroyItem(uint32_t slot);
+
+  /** Returns the item for modification and marks it dirty. */
+  CORE_API DrawItem & editItem(uint32_t slot);
+
+  /** Returns the item at the given slot. Not boundary safe. */
+  CORE_API DrawItem const & getItem(uint32_t slot) const;
+
+  /**
+   * Marks all items dirty, so that the next extraction into every buffer
+   * copies everything. Needed whenever the snapshots are replaced.
+   */
+  CORE_API void markAllDirty();
+
+  /** Returns the number of slots, used or not. */
+  CORE_API size_t getNumberOfSlots() const;
+
+  /**
+   * Brings the snapshot of the given buffer up to date by copying all items
+   * that changed since it was filled last. Returns the number of copied items.
+   */
+  CORE_API size_t extract(RenderSnapshot & snapshot, size_t bufferIndex);
+
+private:
+  RenderWorld();
+
+  /** The live items. */
+  std::vector<DrawItem> m_items{};
+
+  /** Per slot one bit for each buffer that hasn't seen the last change. */
+  std::vector<uint8_t> m_dirtyMasks{};
+
+  /** All slots with a non zero dirty mask. */
+  std::vector<uint32_t> m_dirtySlots{};
+
+  std::vector<uint32_t> m_freeSlots{};
+};
@@ -0,0 +1,42 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Component that makes its scene object part of the replicated state. The
+ * scene object is identified by a network id that is the same on the
+ * server and on all clients. Servers capture the registered components of
+ * all active replicated objects, clients create replicas of them.
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include <cstdint>
+
+class CORE_API ReplicatedObject : public Component
+{
+
+public:
+
+  /** Assigns a new network id. */
+  ReplicatedObject();
+
+  ~ReplicatedObject() override;
+
+  /** Creates a copy with a new network id. */
+  Component * clone() const override;
+
+  uint32_t getNetworkId() const;
+
+  /** Returns true if a client created the object as copy of a server's. */
+  bool isReplica() const;
+
+private:
+
+  friend class ReplicationClient;
+
+  uint32_t m_networkId;
+
+  bool m_isReplica{false};
+
+};
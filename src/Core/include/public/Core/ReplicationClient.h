@@ -0,0 +1,67 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The receiving side of replication. The client decodes the updates of a
+ * server and keeps a replica of every replicated object below its root
+ * scene object: new objects are created with a ReplicatedObject and the
+ * registered components they have on the server, removed objects are
+ * deleted and changed objects get the new field values. Every decoded
+ * update is acknowledged, so the server can send the next one relative to
+ * it.
+ *
+ * Replicas are owned by the root and stay in the scene when the client is
+ * destroyed.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+class ReplicationTransport;
+class SceneObject;
+
+class ReplicationClient final
+{
+public:
+  /** Creates the replicas as children of the root. */
+  CORE_API explicit ReplicationClient(SceneObject * pRoot);
+
+  CORE_API ~ReplicationClient();
+
+  CORE_API ReplicationClient(ReplicationClient const &) = delete;
+
+  CORE_API ReplicationClient & operator=(ReplicationClient const &) = delete;
+
+  CORE_API ReplicationClient(ReplicationClient &&) = delete;
+
+  CORE_API ReplicationClient & operator=(ReplicationClient &&) = delete;
+
+  /**
+   * Applies the update to the replicas. Returns false if the packet was
+   * ignored because it is older than the last one, malformed or relative to
+   * a snapshot the client doesn't know.
+   */
+  CORE_API bool decode(uint8_t const * pData, size_t size);
+
+  /** Returns the sequence of the last decoded snapshot or zero. */
+  CORE_API uint32_t getSequence() const;
+
+  /**
+   * Decodes all packets received over the transport and acknowledges the
+   * last one.
+   */
+  CORE_API void update(ReplicationTransport & transport);
+
+  /** Returns the replica with the network id or nullptr. */
+  CORE_API SceneObject * getObject(uint32_t networkId) const;
+
+  CORE_API size_t getNumberOfObjects() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
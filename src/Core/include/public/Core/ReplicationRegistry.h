@@ -0,0 +1,181 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The component types and fields that are replicated from servers to
+ * clients. Every replicated type lists its fields with accessors and a
+ * quantization, e.g.
+ *
+ *   ReplicationRegistry::getInstance()
+ *       .registerType<RenderComponent>()
+ *       .addFloat(
+ *           [](Component const & c) {
+ *             return static_cast<RenderComponent const &>(c).getPosition().x();
+ *           },
+ *           [](Component & c, float x) { ... },
+ *           -1000.0f, 1000.0f, 0.01f)
+ *       .addAngle(..., 12);
+ *
+ * Servers and clients must register the same types with the same fields in
+ * the same order, since packets only refer to them by index.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <typeinfo>
+#include <vector>
+
+class Component;
+
+enum ReplicatedFieldType
+{
+  /** A float sent with all 32 bits. */
+  FIELD_FLOAT = 0,
+
+  /** A float in a fixed range, rounded to a given precision. */
+  FIELD_QUANTIZED_FLOAT = 1,
+
+  /** An angle in radians, wrapped and rounded to a number of bits. */
+  FIELD_ANGLE = 2,
+
+  /** The lowest bits of an integer. */
+  FIELD_INTEGER = 3,
+
+  FIELD_BOOL = 4
+};
+
+struct ReplicatedField
+{
+  using FloatGetter = float (*)(Component const &);
+  using FloatSetter = void (*)(Component &, float);
+  using IntegerGetter = uint32_t (*)(Component const &);
+  using IntegerSetter = void (*)(Component &, uint32_t);
+
+  ReplicatedFieldType type{FIELD_FLOAT};
+
+  /** The number of bits of the quantized value, 1 to 32. */
+  uint32_t numberOfBits{32};
+
+  /** The range of quantized floats, values outside are clamped. */
+  float minimum{0.0f};
+  float maximum{0.0f};
+
+  /** The accessors of float and angle fields. */
+  FloatGetter getFloat{nullptr};
+  FloatSetter setFloat{nullptr};
+
+  /** The accessors of integer and bool fields. */
+  IntegerGetter getInteger{nullptr};
+  IntegerSetter setInteger{nullptr};
+};
+
+/** A replicated component type and its fields. */
+class ReplicatedType final
+{
+public:
+  using CreateFunction = Component * (*)();
+
+  CORE_API ReplicatedType(std::type_info const & type, CreateFunction create);
+
+  /** Adds a float field that is sent with full precision. */
+  CORE_API ReplicatedType & addFloat(ReplicatedField::FloatGetter get,
+                                     ReplicatedField::FloatSetter set);
+
+  /**
+   * Adds a float field in [minimum, maximum] that is sent with just enough
+   * bits to keep the given precision.
+   */
+  CORE_API ReplicatedType & addFloat(ReplicatedField::FloatGetter get,
+                                     ReplicatedField::FloatSetter set,
+                                     float minimum, float maximum,
+                                     float precision);
+
+  /** Adds an angle in radians that is sent with the number of bits. */
+  CORE_API ReplicatedType & addAngle(ReplicatedField::FloatGetter get,
+                                     ReplicatedField::FloatSetter set,
+                                     uint32_t numberOfBits);
+
+  /** Adds an integer field of which the lowest numberOfBits are sent. */
+  CORE_API ReplicatedType & addInteger(ReplicatedField::IntegerGetter get,
+                                       ReplicatedField::IntegerSetter set,
+                                       uint32_t numberOfBits = 32);
+
+  /** Adds a bool field, the accessors use zero and one. */
+  CORE_API ReplicatedType & addBool(ReplicatedField::IntegerGetter get,
+                                    ReplicatedField::IntegerSetter set);
+
+  CORE_API std::type_info const & getType() const;
+
+  /** Creates a detached component of the type for clients. */
+  CORE_API Component * create() const;
+
+  CORE_API size_t getNumberOfFields() const;
+
+  CORE_API ReplicatedField const & getField(size_t index) const;
+
+private:
+  std::type_info const * m_type;
+
+  CreateFunction m_create;
+
+  std::vector<ReplicatedField> m_fields{};
+};
+
+class ReplicationRegistry final
+{
+public:
+  /** The most types that can be registered. */
+  static size_t const MAXIMUM_TYPES = 32;
+
+  /** Returned by findType for types that aren't registered. */
+  static size_t const INVALID_TYPE = ~size_t(0);
+
+  CORE_API static ReplicationRegistry & getInstance();
+
+  CORE_API ~ReplicationRegistry();
+
+  CORE_API ReplicationRegistry(ReplicationRegistry const &) = delete;
+
+  CORE_API ReplicationRegistry & operator=(ReplicationRegistry const &) = delete;
+
+  CORE_API ReplicationRegistry(ReplicationRegistry &&) = delete;
+
+  CORE_API ReplicationRegistry & operator=(ReplicationRegistry &&) = delete;
+
+  /**
+   * Registers the component type and returns it to add fields. A type that
+   * is already registered is returned as is. Returns nullptr if
+   * MAXIMUM_TYPES are registered.
+   */
+  CORE_API ReplicatedType * registerType(std::type_info const & type,
+                                         ReplicatedType::CreateFunction create);
+
+  /**
+   * Registers a default constructible component type. The registry must not
+   * be full.
+   */
+  template <class TComponent> ReplicatedType & registerType()
+  {
+    return *registerType(typeid(TComponent), []() -> Component * {
+      return new TComponent();
+    });
+  }
+
+  CORE_API size_t getNumberOfTypes() const;
+
+  /** Returns the type at the index. Not boundary safe. */
+  CORE_API ReplicatedType const & getType(size_t index) const;
+
+  /** Returns the index of the type or INVALID_TYPE. */
+  CORE_API size_t findType(std::type_info const & type) const;
+
+private:
+  ReplicationRegistry();
+
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,84 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The authoritative side of replication. Every frame the server captures a
+ * snapshot of the registered components of all active replicated objects
+ * and sends each client the difference to the last snapshot the client
+ * acknowledged. Snapshots store quantized values, so an object only costs
+ * bandwidth if its quantized state changed since that snapshot. Clients
+ * that acknowledged nothing or fell behind the kept snapshots get the
+ * whole state.
+ *
+ *   server.captureSnapshot();
+ *   server.update(); // receive acknowledgements, send updates
+ *
+ * Field getters are called from the threads of the job system while the
+ * snapshot is captured, so they must only read.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ReplicationTransport;
+
+class ReplicationServer final
+{
+public:
+  CORE_API ReplicationServer();
+
+  CORE_API ~ReplicationServer();
+
+  CORE_API ReplicationServer(ReplicationServer const &) = delete;
+
+  CORE_API ReplicationServer & operator=(ReplicationServer const &) = delete;
+
+  CORE_API ReplicationServer(ReplicationServer &&) = delete;
+
+  CORE_API ReplicationServer & operator=(ReplicationServer &&) = delete;
+
+  /** Captures the current state as the next snapshot, returns its sequence. */
+  CORE_API uint32_t captureSnapshot();
+
+  /** Returns the sequence of the latest snapshot or zero. */
+  CORE_API uint32_t getSequence() const;
+
+  /** Returns the number of objects in the latest snapshot. */
+  CORE_API size_t getNumberOfObjects() const;
+
+  /**
+   * Adds a client and returns its id. Updates are exchanged over the
+   * transport, which must outlive the client. Without a transport, packets
+   * are only exchanged with encode and acknowledge.
+   */
+  CORE_API uint32_t addClient(ReplicationTransport * pTransport = nullptr);
+
+  CORE_API void removeClient(uint32_t client);
+
+  /** Makes the snapshot the baseline of the client if it's newer. */
+  CORE_API void acknowledge(uint32_t client, uint32_t sequence);
+
+  /** Returns the sequence of the baseline of the client or zero. */
+  CORE_API uint32_t getAcknowledged(uint32_t client) const;
+
+  /**
+   * Writes the latest snapshot relative to the baseline of the client to the
+   * packet. The packet is empty if nothing was captured yet.
+   */
+  CORE_API void encode(uint32_t client, std::vector<uint8_t> & packet) const;
+
+  /**
+   * Receives the acknowledgements of all clients with a transport and sends
+   * them the latest snapshot. The packets are encoded in parallel.
+   */
+  CORE_API void update();
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,104 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Unreliable packet transports between a replication server and one
+ * client. Packets may be lost, duplicated or reordered, but arrive whole.
+ * The in-process transport connects two endpoints within one process, the
+ * UDP transport splits packets into datagrams and puts them back together,
+ * dropping packets of which a datagram was lost.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class CORE_API ReplicationTransport
+{
+
+public:
+
+  virtual ~ReplicationTransport();
+
+  /** Sends the packet without blocking. Returns false if it was dropped. */
+  virtual bool send(uint8_t const * pData, size_t size) = 0;
+
+  /**
+   * Moves the next received packet into the buffer without blocking.
+   * Returns false if there is none.
+   */
+  virtual bool receive(std::vector<uint8_t> & packet) = 0;
+
+};
+
+/** Thread safe transport between two endpoints in the same process. */
+class InProcessTransport final : public ReplicationTransport
+{
+public:
+  CORE_API InProcessTransport();
+
+  CORE_API ~InProcessTransport() override;
+
+  CORE_API InProcessTransport(InProcessTransport const &) = delete;
+
+  CORE_API InProcessTransport & operator=(InProcessTransport const &) = delete;
+
+  CORE_API InProcessTransport(InProcessTransport &&) = delete;
+
+  CORE_API InProcessTransport & operator=(InProcessTransport &&) = delete;
+
+  /** Connects the endpoints to each other, replacing old connections. */
+  CORE_API static void connect(InProcessTransport & a, InProcessTransport & b);
+
+  CORE_API bool send(uint8_t const * pData, size_t size) override;
+
+  CORE_API bool receive(std::vector<uint8_t> & packet) override;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+/** Non-blocking UDP socket that exchanges packets with one peer. */
+class UdpTransport final : public ReplicationTransport
+{
+public:
+  /** The payload of one datagram, small enough to avoid fragmentation. */
+  static size_t const MAXIMUM_PAYLOAD = 1200;
+
+  CORE_API UdpTransport();
+
+  CORE_API ~UdpTransport() override;
+
+  CORE_API UdpTransport(UdpTransport const &) = delete;
+
+  CORE_API UdpTransport & operator=(UdpTransport const &) = delete;
+
+  CORE_API UdpTransport(UdpTransport &&) = delete;
+
+  CORE_API UdpTransport & operator=(UdpTransport &&) = delete;
+
+  /**
+   * Opens a socket on the port of all local addresses, zero picks a free
+   * port. Returns false if the socket couldn't be opened.
+   */
+  CORE_API bool open(uint16_t port = 0);
+
+  /** Sets the IPv4 address and port packets are sent to. */
+  CORE_API bool setPeer(char const * address, uint16_t port);
+
+  /** Returns the port the socket is bound to or zero. */
+  CORE_API uint16_t getPort() const;
+
+  CORE_API bool send(uint8_t const * pData, size_t size) override;
+
+  CORE_API bool receive(std::vector<uint8_t> & packet) override;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,90 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Component that lets the physics world move its scene object. It owns one
+ * body of the physics world, which takes its shape and material from the
+ * collider of the same scene object. The body only takes part in the
+ * simulation while the component is active. Every update writes the
+ * interpolated body transform to the render component of the scene object,
+ * if there is one. The motion of the body is the state of the component, so
+ * scene snapshots roll the body back with its scene object.
+ */
+
+#pragma once
+
+#include "Core/Component.h"
+#include "Core/MathTypes.h"
+#include "Core/PhysicsWorld.h"
+#include <cstdint>
+
+class CORE_API RigidBody : public Component
+{
+
+public:
+
+  RigidBody();
+
+  ~RigidBody() override;
+
+  /** Copies the interpolated transform to the render component. */
+  void update(double deltaTime) override;
+
+  Component * clone() const override;
+
+  /** The state is the motion of the body, so rollbacks restore it. */
+  size_t getStateSize() const override;
+
+  void saveState(void * pState) const override;
+
+  void loadState(void const * pState) override;
+
+  void setType(BodyType type);
+
+  BodyType getType() const;
+
+  /** Sets the mass per area of dynamic bodies. */
+  void setDensity(float density);
+
+  float getDensity() const;
+
+  /** Moves the body there, rendering doesn't interpolate the jump. */
+  void setPosition(Vector2 const & position);
+
+  Vector2 getPosition() const;
+
+  /** Sets the rotation in radians, like setPosition without interpolation. */
+  void setAngle(float angle);
+
+  float getAngle() const;
+
+  void setVelocity(Vector2 const & velocity);
+
+  Vector2 getVelocity() const;
+
+  void setAngularVelocity(float angularVelocity);
+
+  float getAngularVelocity() const;
+
+  /** Changes the velocity by the impulse divided by the mass. */
+  void applyImpulse(Vector2 const & impulse);
+
+  /** Applies the shape and material of the collider to the body. */
+  void updateDefinition();
+
+  /** Returns the slot of the body in the physics world. */
+  uint32_t getSlot() const;
+
+protected:
+
+  void onActivationChanged() override;
+
+private:
+
+  uint32_t m_slot;
+
+  BodyType m_type{BODY_DYNAMIC};
+
+  float m_density{1.0f};
+
+};
@@ -20,6 +20,7 @@
 
 #include "Core/CoreDll.h"
 #include <memory>
+#include <typeinfo>
 
 class Component;
 
@@ -38,6 +39,12 @@ public:
 
   CORE_API SceneObject & operator=(SceneObject &&) = delete;
 
+  /** Allocates scene objects from the scene object pool. */
+  CORE_API static void * operator new(size_t size);
+
+  /** Returns scene objects to the scene object pool. */
+  CORE_API static void operator delete(void * p, size_t size);
+
   /**
    * Adds the component to the scene object and commits ownership.
    * If the component could not be added the method returns false.
@@ -51,28 +58,22 @@ public:
   CORE_API void removeComponent(Component * pComponent);
 
   /** Returns the component of the specific type or nullptr. */
-  // template <class TComponent> TComponent * getComponent()
-  //{
-  //  auto iter = m_components.find(typeid(TComponent).hash_code());
-  //  if (iter != std::end(m_components))
-  //  {
-  //    assert(dynamic_cast<TComponent *>(iter->second));
-  //    return static_cast<TComponent *>(iter->second);
-  //  }
-  //  return nullptr;
-  //}
+  CORE_API Component * getComponent(std::type_info const & type);
+
+  /** Returns the component of the specific type or nullptr. */
+  CORE_API Component const * getComponent(std::type_info const & type) const;
+
+  /** Returns the component of the specific type or nullptr. */
+  template <class TComponent> TComponent * getComponent()
+  {
+    return static_cast<TComponent *>(getComponent(typeid(TComponent)));
+  }
 
   /** Returns the component of the specific type or nullptr. */
-  // template <class TComponent> TComponent const * getComponent() const
-  //{
-  //  auto iter = m_components.find(typeid(TComponent).hash_code());
-  //  if (iter != std::end(m_components))
-  //  {
-  //    assert(dynamic_cast<TComponent *>(iter->second));
-  //    return static_cast<TComponent const *>(iter->second);
-  //  }
-  //  return nullptr;
-  //}
+  template <class TComponent> TComponent const * getComponent() const
+  {
+    return static_cast<TComponent const *>(getComponent(typeid(TComponent)));
+  }
 
   /** Returns the parent scene object or nullptr. */
   CORE_API SceneObject * getParent();
@@ -110,8 +111,26 @@ public:
   /** Returns true if the scene object is enabled. */
   CORE_API bool isEnabled() const;
 
+  /** Returns true if the scene object and all its ancestors are enabled. */
+  CORE_API bool isEnabledInHierarchy() const;
+
+  /**
+   * Returns the bytes held by this scene object, its children and
+   * component vectors and its heap allocated components. Optionally the memory
+   * of all descendants is included.
+   */
+  CORE_API size_t getMemoryUsage(bool includeDescendants = false) const;
+
 private:
   class Impl;
   friend class Impl;
+
+  /** Takes the implementation of objects created in bulk. */
+  explicit SceneObject(Impl * pImpl);
+
+  friend class Prefab;
+  friend class ComponentQuery;
+  friend class SceneSnapshot;
+  friend class SceneVersions;
   std::unique_ptr<Impl> m_impl;
 };
@@ -0,0 +1,75 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * The whole state of a scene for rollbacks: the hierarchy below a root, the
+ * enabled flags of its scene objects and components and the state that
+ * components write with saveState. Snapshots keep the layout of the scene
+ * and one buffer for all states, so capturing and restoring the same scene
+ * again doesn't allocate and only copies what changed in between:
+ *
+ *  - restore only puts back the objects whose children or components
+ *    changed, capture only walks the hierarchy again if it changed,
+ *  - only the flags of subtrees in which one of them changed are compared,
+ *  - changes outside the subtree of the root don't count and
+ *  - states are only copied if the state version of the component differs.
+ *
+ *   SceneSnapshot snapshot;
+ *   snapshot.capture(*pRoot);
+ *   ...                // simulate ahead
+ *   snapshot.restore(); // roll back
+ *
+ * The scene objects and components of a snapshot must not be destroyed
+ * before it's restored, except by restoring: objects and components that
+ * were added below the root since the capture are destroyed by restore,
+ * removed ones must be kept alive to be attached again.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <memory>
+
+class SceneObject;
+
+class SceneSnapshot final
+{
+public:
+  CORE_API SceneSnapshot();
+
+  CORE_API ~SceneSnapshot();
+
+  CORE_API SceneSnapshot(SceneSnapshot const &) = delete;
+
+  CORE_API SceneSnapshot & operator=(SceneSnapshot const &) = delete;
+
+  CORE_API SceneSnapshot(SceneSnapshot &&) = delete;
+
+  CORE_API SceneSnapshot & operator=(SceneSnapshot &&) = delete;
+
+  /** Captures the scene below the root including the root itself. */
+  CORE_API void capture(SceneObject & root);
+
+  /**
+   * Sets the scene back to the captured state. Returns false if nothing was
+   * captured yet.
+   */
+  CORE_API bool restore();
+
+  CORE_API bool isEmpty() const;
+
+  CORE_API size_t getNumberOfObjects() const;
+
+  CORE_API size_t getNumberOfComponents() const;
+
+  /** Returns the bytes of the buffer that holds the component states. */
+  CORE_API size_t getStateSize() const;
+
+  /** Returns the number of states the last capture or restore copied. */
+  CORE_API size_t getNumberOfCopiedStates() const;
+
+private:
+  class Impl;
+  std::unique_ptr<Impl> m_impl;
+};
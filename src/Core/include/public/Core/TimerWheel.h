@@ -0,0 +1,71 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Hierarchical timer wheel. Timers are sorted into four wheels of 256 slots
+ * each, the first one holding the next 256 ticks, every further one 256
+ * times the range of the previous one. Advancing the wheel only visits the
+ * slots of the elapsed ticks and occasionally cascades a slot of an outer
+ * wheel inwards, so the cost doesn't depend on the number of pending timers.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include "Core/IntrusiveList.h"
+#include <cstddef>
+#include <cstdint>
+
+/** A timer, usually embedded in the object that waits for it. */
+struct TimerNode : public IntrusiveListNode
+{
+  /** The tick at which the timer expires. */
+  uint64_t expiry{0};
+};
+
+using TimerList = IntrusiveList<TimerNode>;
+
+class TimerWheel final
+{
+public:
+  static size_t const NUMBER_OF_LEVELS = 4;
+
+  static size_t const BITS_PER_LEVEL = 8;
+
+  static size_t const SLOTS_PER_LEVEL = size_t(1) << BITS_PER_LEVEL;
+
+  CORE_API TimerWheel();
+
+  TimerWheel(TimerWheel const &) = delete;
+
+  TimerWheel & operator=(TimerWheel const &) = delete;
+
+  /**
+   * Schedules the timer for the given tick. Timers that are already due
+   * expire with the next call to advance.
+   */
+  CORE_API void schedule(TimerNode & timer, uint64_t expiry);
+
+  /** Advances to the given tick and moves all expired timers to the list. */
+  CORE_API void advance(uint64_t tick, TimerList & expired);
+
+  /** Returns the tick the wheel was advanced to last. */
+  CORE_API uint64_t getCurrentTick() const;
+
+private:
+  /** Sorts the timer into the wheel relative to the current tick. */
+  void insert(TimerNode & timer);
+
+  /** Re-inserts all timers of the slot, they move to inner wheels. */
+  void cascade(TimerList & slot);
+
+  uint64_t m_currentTick{0};
+
+  TimerList m_wheels[NUMBER_OF_LEVELS][SLOTS_PER_LEVEL];
+
+  /** Timers beyond the range of the outermost wheel. */
+  TimerList m_overflow{};
+
+  /** Timers that were already due when they were scheduled. */
+  TimerList m_due{};
+};
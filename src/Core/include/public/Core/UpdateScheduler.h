@@ -0,0 +1,149 @@
+/**
+ * @author Florian Feuerstein
+ * @date 19.10.2026
+ *
+ * Updates components that asked for a lower update frequency than the frame
+ * rate. A component with a frequency f is updated about every
+ * 1 / (f * frame time) frames. Frames are kept in a ring of buckets and a
+ * component is placed in the least loaded bucket when it's (re)scheduled,
+ * so thousands of low frequency components spread evenly over the frames
+ * instead of all running in the same one. Every update gets the time that
+ * passed since the previous update of that component.
+ *
+ * An optional frame budget caps the time spent per frame. Components that
+ * don't fit into the budget are updated first in the next frame.
+ */
+
+#pragma once
+
+#include "Core/CoreDll.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class Component;
+
+struct UpdateSchedulerStatistics
+{
+  /** The number of components updated in the last frame. */
+  size_t numberOfUpdates{0};
+
+  /** The number of due components postponed to the next frame. */
+  size_t numberOfDeferred{0};
+
+  /** The time spent updating components in the last frame. */
+  double updateSeconds{0.0};
+};
+
+class UpdateScheduler final
+{
+public:
+  /** Marks components that aren't scheduled. */
+  static uint32_t const INVALID_ENTRY = 0xffffffffu;
+
+  /** The number of frame buckets, the longest possible update interval. */
+  static size_t const NUMBER_OF_BUCKETS = 256;
+
+  /**
+   * Maps a component and its desired frequency to the frequency it's
+   * updated with, e.g. lower for components far away from the camera.
+   */
+  using FrequencyFunction = std::function<double(Component const &, double)>;
+
+  CORE_API static UpdateScheduler & getInstance();
+
+  UpdateScheduler(UpdateScheduler const &) = delete;
+
+  UpdateScheduler & operator=(UpdateScheduler const &) = delete;
+
+  /** Updates all components due in this frame. Call once per frame. */
+  CORE_API void update(double deltaTime);
+
+  /**
+   * Sets the maximum time spent updating components per frame. Zero, the
+   * default, disables the budget.
+   */
+  CORE_API void setFrameBudget(double seconds);
+
+  CORE_API double getFrameBudget() const;
+
+  /**
+   * Sets the function that adjusts the frequencies. It's evaluated whenever
+   * a component is rescheduled after its update. Pass an empty function to
+   * use the desired frequencies as they are.
+   */
+  CORE_API void setFrequencyFunction(FrequencyFunction const & function);
+
+  /** Returns the number of scheduled components. */
+  CORE_API size_t getNumberOfComponents() const;
+
+  CORE_API UpdateSchedulerStatistics const & getStatistics() const;
+
+private:
+  friend class Component;
+
+  struct Entry
+  {
+    Component * pComponent;
+
+    /** The time of the last update. */
+    double lastUpdateTime;
+
+    /** The number of frames between two updates. */
+    uint32_t interval;
+
+    /** The bucket the entry waits in. */
+    uint32_t bucket;
+
+    /** The position in the bucket. */
+    uint32_t position;
+  };
+
+  UpdateScheduler();
+
+  /** Schedules the component, called when it gets a frequency. */
+  void add(Component * pComponent);
+
+  /** Removes the component from the schedule. */
+  void remove(Component * pComponent);
+
+  /** Reconsiders the interval of the component after a frequency change. */
+  void reschedule(Component * pComponent);
+
+  /** Returns the number of frames between two updates of the entry. */
+  uint32_t getInterval(Entry const & entry) const;
+
+  /**
+   * Puts the entry into a bucket. If the interval changed, the least loaded
+   * of the next interval buckets is picked, otherwise the entry keeps its
+   * phase.
+   */
+  void insert(uint32_t entryIndex, uint32_t interval);
+
+  /** Removes the entry from its bucket. */
+  void unlink(uint32_t entryIndex);
+
+  std::vector<Entry> m_entries{};
+
+  std::vector<uint32_t> m_freeEntries{};
+
+  /** The entries due in the frames ahead, indexed by frame modulo size. */
+  std::vector<std::vector<uint32_t>> m_buckets;
+
+  /** Due entries that didn't fit into the budget of the last frame. */
+  std::vector<uint32_t> m_deferred{};
+
+  uint64_t m_frame{0};
+
+  double m_time{0.0};
+
+  /** Smoothed frame time used to turn frequencies into intervals. */
+  double m_averageDeltaTime{1.0 / 60.0};
+
+  double m_frameBudget{0.0};
+
+  FrequencyFunction m_frequencyFunction{};
+
+  UpdateSchedulerStatistics m_statistics{};
+};
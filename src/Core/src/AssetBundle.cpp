@@ -0,0 +1,352 @@
+#include "Core/AssetBundle.h"
+#include "Core/MemoryStats.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace AssetBundleFormat;
+
+namespace
+{
+
+/** Accounts the mapped bundles, the bytes are address space, not heap. */
+MemoryCategory & getBundleMemory()
+{
+  static MemoryCategory & category =
+      MemoryStats::getInstance().getSubsystem("AssetBundle");
+  return category;
+}
+
+} // namespace
+
+/********** Impl start ************/
+
+class AssetBundle::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  bool open(std::string const & filename);
+
+  void close();
+
+  bool isOpen() const;
+
+  size_t getNumberOfAtlases() const;
+
+  AtlasEntry const & getAtlas(size_t index) const;
+
+  void const * getAtlasPixels(size_t index) const;
+
+  size_t getNumberOfSprites() const;
+
+  SpriteEntry const & getSprite(size_t index) const;
+
+  SpriteEntry const * findSprite(uint64_t nameHash) const;
+
+private:
+  /** Maps the whole file read-only. */
+  bool map(std::string const & filename);
+
+  /** Releases the mapping and all handles. */
+  void unmap();
+
+  /**
+   * Checks that the header, all tables and atlases lie inside the mapping
+   * and that every sprite lies inside its atlas.
+   */
+  bool validate() const;
+
+  /** The first byte of the mapped file. */
+  unsigned char const * m_data{nullptr};
+
+  /** The size of the mapped file in bytes. */
+  size_t m_size{0};
+
+  Header const * m_header{nullptr};
+
+  AtlasEntry const * m_atlases{nullptr};
+
+  SpriteEntry const * m_sprites{nullptr};
+
+#ifdef _WIN32
+  HANDLE m_file{INVALID_HANDLE_VALUE};
+
+  HANDLE m_mapping{nullptr};
+#endif
+};
+
+AssetBundle::Impl::Impl() = default;
+
+AssetBundle::Impl::~Impl() { close(); }
+
+bool AssetBundle::Impl::open(std::string const & filename)
+{
+  close();
+  if (!map(filename))
+    return false;
+  if (m_size < sizeof(Header))
+  {
+    close();
+    return false;
+  }
+  m_header = reinterpret_cast<Header const *>(m_data);
+  if (!validate())
+  {
+    close();
+    return false;
+  }
+  m_atlases =
+      reinterpret_cast<AtlasEntry const *>(m_data + m_header->atlasTableOffset);
+  m_sprites = reinterpret_cast<SpriteEntry const *>(
+      m_data + m_header->spriteTableOffset);
+  getBundleMemory().recordAllocation(m_size);
+  return true;
+}
+
+void AssetBundle::Impl::close()
+{
+  if (isOpen())
+  {
+    getBundleMemory().recordDeallocation(m_size);
+  }
+  unmap();
+  m_header = nullptr;
+  m_atlases = nullptr;
+  m_sprites = nullptr;
+}
+
+bool AssetBundle::Impl::isOpen() const { return m_header != nullptr; }
+
+size_t AssetBundle::Impl::getNumberOfAtlases() const
+{
+  return m_header != nullptr ? m_header->numberOfAtlases : 0;
+}
+
+AtlasEntry const & AssetBundle::Impl::getAtlas(size_t index) const
+{
+  return m_atlases[index];
+}
+
+void const * AssetBundle::Impl::getAtlasPixels(size_t index) const
+{
+  return m_data + m_atlases[index].dataOffset;
+}
+
+size_t AssetBundle::Impl::getNumberOfSprites() const
+{
+  return m_header != nullptr ? m_header->numberOfSprites : 0;
+}
+
+SpriteEntry const & AssetBundle::Impl::getSprite(size_t index) const
+{
+  return m_sprites[index];
+}
+
+SpriteEntry const * AssetBundle::Impl::findSprite(uint64_t nameHash) const
+{
+  if (m_header == nullptr)
+    return nullptr;
+  SpriteEntry const * pLast = m_sprites + m_header->numberOfSprites;
+  SpriteEntry const * pIter = std::lower_bound(
+      m_sprites, pLast, nameHash,
+      [](SpriteEntry const & sprite, uint64_t hash) {
+        return sprite.nameHash < hash;
+      });
+  if (pIter != pLast && pIter->nameHash == nameHash)
+    return pIter;
+  return nullptr;
+}
+
+bool AssetBundle::Impl::validate() const
+{
+  Header const & header = *m_header;
+  if (header.magic != MAGIC || header.version != VERSION ||
+      header.fileSize != m_size)
+    return false;
+  // compared by subtraction, crafted offsets and sizes must not wrap
+  if (header.atlasTableOffset % alignof(AtlasEntry) != 0 ||
+      header.spriteTableOffset % alignof(SpriteEntry) != 0 ||
+      header.atlasTableOffset > m_size ||
+      header.numberOfAtlases >
+          (m_size - header.atlasTableOffset) / sizeof(AtlasEntry) ||
+      header.spriteTableOffset > m_size ||
+      header.numberOfSprites >
+          (m_size - header.spriteTableOffset) / sizeof(SpriteEntry))
+    return false;
+  AtlasEntry const * pAtlases =
+      reinterpret_cast<AtlasEntry const *>(m_data + header.atlasTableOffset);
+  for (uint32_t i = 0; i < header.numberOfAtlases; ++i)
+  {
+    AtlasEntry const & atlas = pAtlases[i];
+    if (atlas.pixelFormat != PIXEL_FORMAT_RGBA8 || atlas.width == 0 ||
+        atlas.height == 0 || atlas.dataOffset > m_size ||
+        atlas.dataSize > m_size - atlas.dataOffset ||
+        atlas.dataSize / 4u / atlas.width != atlas.height ||
+        atlas.dataSize !=
+            static_cast<uint64_t>(atlas.width) * atlas.height * 4u)
+      return false;
+  }
+  SpriteEntry const * pSprites =
+      reinterpret_cast<SpriteEntry const *>(m_data + header.spriteTableOffset);
+  for (uint32_t i = 0; i < header.numberOfSprites; ++i)
+  {
+    SpriteEntry const & sprite = pSprites[i];
+    if (sprite.atlasIndex >= header.numberOfAtlases)
+      return false;
+    AtlasEntry const & atlas = pAtlases[sprite.atlasIndex];
+    if (static_cast<uint32_t>(sprite.x) + sprite.width > atlas.width ||
+        static_cast<uint32_t>(sprite.y) + sprite.height > atlas.height)
+      return false;
+  }
+  return true;
+}
+
+#ifdef _WIN32
+
+bool AssetBundle::Impl::map(std::string const & filename)
+{
+  m_file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                       nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                       nullptr);
+  if (m_file == INVALID_HANDLE_VALUE)
+    return false;
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(m_file, &fileSize) || fileSize.QuadPart == 0)
+  {
+    unmap();
+    return false;
+  }
+  m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping == nullptr)
+  {
+    unmap();
+    return false;
+  }
+  m_data = static_cast<unsigned char const *>(
+      MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+  if (m_data == nullptr)
+  {
+    unmap();
+    return false;
+  }
+  m_size = static_cast<size_t>(fileSize.QuadPart);
+  return true;
+}
+
+void AssetBundle::Impl::unmap()
+{
+  if (m_data != nullptr)
+    UnmapViewOfFile(m_data);
+  if (m_mapping != nullptr)
+    CloseHandle(m_mapping);
+  if (m_file != INVALID_HANDLE_VALUE)
+    CloseHandle(m_file);
+  m_data = nullptr;
+  m_size = 0;
+  m_mapping = nullptr;
+  m_file = INVALID_HANDLE_VALUE;
+}
+
+#else
+
+bool AssetBundle::Impl::map(std::string const & filename)
+{
+  int const file = ::open(filename.c_str(), O_RDONLY);
+  if (file < 0)
+    return false;
+  struct stat fileStat;
+  if (fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+  {
+    ::close(file);
+    return false;
+  }
+  size_t const size = static_cast<size_t>(fileStat.st_size);
+  void * pData = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+  ::close(file); // the mapping keeps the file alive
+  if (pData == MAP_FAILED)
+    return false;
+  m_data = static_cast<unsigned char const *>(pData);
+  m_size = size;
+  return true;
+}
+
+void AssetBundle::Impl::unmap()
+{
+  if (m_data != nullptr)
+    munmap(const_cast<unsigned char *>(m_data), m_size);
+  m_data = nullptr;
+  m_size = 0;
+}
+
+#endif
+
+/******************** Impl end *************************************/
+
+AssetBundle::AssetBundle() : m_impl(new Impl()) {}
+
+AssetBundle::~AssetBundle() = default;
+
+bool AssetBundle::open(std::string const & filename)
+{
+  return m_impl->open(filename);
+}
+
+void AssetBundle::close() { m_impl->close(); }
+
+bool AssetBundle::isOpen() const { return m_impl->isOpen(); }
+
+size_t AssetBundle::getNumberOfAtlases() const
+{
+  return m_impl->getNumberOfAtlases();
+}
+
+AtlasEntry const & AssetBundle::getAtlas(size_t index) const
+{
+  return m_impl->getAtlas(index);
+}
+
+void const * AssetBundle::getAtlasPixels(size_t index) const
+{
+  return m_impl->getAtlasPixels(index);
+}
+
+size_t AssetBundle::getNumberOfSprites() const
+{
+  return m_impl->getNumberOfSprites();
+}
+
+SpriteEntry const & AssetBundle::getSprite(size_t index) const
+{
+  return m_impl->getSprite(index);
+}
+
+SpriteEntry const * AssetBundle::findSprite(uint64_t nameHash) const
+{
+  return m_impl->findSprite(nameHash);
+}
+
+SpriteEntry const * AssetBundle::findSprite(std::string const & name) const
+{
+  return m_impl->findSprite(hashName(name.data(), name.size()));
+}
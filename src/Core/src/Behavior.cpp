@@ -0,0 +1,136 @@
+#include "Core/Behavior.h"
+#include "Core/PoolAllocator.h"
+#include <cmath>
+
+namespace
+{
+
+PoolAllocator & getFramePool()
+{
+  static PoolAllocator pool("Behavior frames");
+  return pool;
+}
+
+} // namespace
+
+void * Behavior::promise_type::operator new(size_t size)
+{
+  return getFramePool().allocate(size);
+}
+
+void Behavior::promise_type::operator delete(void * p, size_t size)
+{
+  getFramePool().deallocate(p, size);
+}
+
+/********** BehaviorComponent ************/
+
+BehaviorComponent::BehaviorComponent() = default;
+
+BehaviorComponent::~BehaviorComponent() { stopBehaviors(); }
+
+void BehaviorComponent::startBehavior(Behavior behavior)
+{
+  Behavior::Handle handle = behavior.m_handle;
+  behavior.m_handle = nullptr;
+  handle.promise().m_owner = this;
+  m_behaviors.push_back(handle.promise());
+  handle.resume();
+}
+
+void BehaviorComponent::stopBehaviors()
+{
+  // destroying a frame unlinks its promise and pending wait nodes
+  while (!m_behaviors.empty())
+  {
+    Behavior::Handle::from_promise(m_behaviors.front()).destroy();
+  }
+}
+
+bool BehaviorComponent::hasBehaviors() const { return !m_behaviors.empty(); }
+
+void BehaviorComponent::onActivationChanged()
+{
+  if (isActive() && !m_pausedBehaviors.empty())
+  {
+    while (!m_pausedBehaviors.empty())
+    {
+      BehaviorScheduler::getInstance().resumeNextFrame(
+          static_cast<BehaviorWaitNode &>(m_pausedBehaviors.pop_front()));
+    }
+  }
+}
+
+/********** BehaviorScheduler ************/
+
+BehaviorScheduler & BehaviorScheduler::getInstance()
+{
+  static BehaviorScheduler instance;
+  return instance;
+}
+
+BehaviorScheduler::BehaviorScheduler() = default;
+
+void BehaviorScheduler::update(double deltaTime)
+{
+  m_time += deltaTime;
+  m_tick = static_cast<uint64_t>(m_time * double(TICKS_PER_SECOND));
+
+  // everything that waits for this frame goes into one list first, so that
+  // behaviors waiting for the next frame again end up in the next update
+  TimerList ready;
+  m_nextFrame.spliceTo(ready);
+  m_timers.advance(m_tick, ready);
+
+  m_numberOfResumed = 0;
+  while (!ready.empty())
+  {
+    resume(static_cast<BehaviorWaitNode &>(ready.pop_front()));
+  }
+}
+
+double BehaviorScheduler::getTime() const { return m_time; }
+
+size_t BehaviorScheduler::getNumberOfResumed() const
+{
+  return m_numberOfResumed;
+}
+
+void BehaviorScheduler::resumeNextFrame(BehaviorWaitNode & node)
+{
+  m_nextFrame.push_back(node);
+}
+
+void BehaviorScheduler::resumeAfter(BehaviorWaitNode & node, double seconds)
+{
+  // negative and NaN delays resume on the next tick
+  seconds = seconds > 0.0 ? seconds : 0.0;
+  uint64_t const ticks =
+      static_cast<uint64_t>(std::ceil(seconds * double(TICKS_PER_SECOND)));
+  // a delay never resumes within the frame it was requested in
+  m_timers.schedule(node, m_tick + (ticks > 0 ? ticks : 1));
+}
+
+void BehaviorScheduler::resume(BehaviorWaitNode & node)
+{
+  BehaviorComponent * pOwner = node.handle.promise().m_owner;
+  if (pOwner != nullptr && !pOwner->isActive())
+  {
+    pOwner->m_pausedBehaviors.push_back(node);
+    return;
+  }
+  ++m_numberOfResumed;
+  node.handle.resume();
+}
+
+/********** BehaviorEvent ************/
+
+void BehaviorEvent::signal()
+{
+  BehaviorScheduler & scheduler = BehaviorScheduler::getInstance();
+  while (!m_waiting.empty())
+  {
+    scheduler.resumeNextFrame(
+        static_cast<BehaviorWaitNode &>(m_waiting.pop_front()));
+  }
+}
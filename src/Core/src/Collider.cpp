@@ -0,0 +1,76 @@
+#include "Core/Collider.h"
+#include "Core/RigidBody.h"
+#include "Core/SceneObject.h"
+
+Collider::Collider() = default;
+
+Collider::~Collider() = default;
+
+Component * Collider::clone() const
+{
+  Collider * pCopy = new Collider();
+  pCopy->m_shape = m_shape;
+  pCopy->m_halfExtents = m_halfExtents;
+  pCopy->m_friction = m_friction;
+  pCopy->m_restitution = m_restitution;
+  return pCopy;
+}
+
+void Collider::setCircle(float radius)
+{
+  m_shape = SHAPE_CIRCLE;
+  m_halfExtents = Vector2(radius, radius);
+  updateRigidBody();
+}
+
+void Collider::setBox(float halfWidth, float halfHeight)
+{
+  m_shape = SHAPE_BOX;
+  m_halfExtents = Vector2(halfWidth, halfHeight);
+  updateRigidBody();
+}
+
+ShapeType Collider::getShape() const { return m_shape; }
+
+Vector2 Collider::getHalfExtents() const { return m_halfExtents; }
+
+void Collider::setFriction(float friction)
+{
+  m_friction = friction;
+  updateRigidBody();
+}
+
+float Collider::getFriction() const { return m_friction; }
+
+void Collider::setRestitution(float restitution)
+{
+  m_restitution = restitution;
+  updateRigidBody();
+}
+
+float Collider::getRestitution() const { return m_restitution; }
+
+void Collider::onActivationChanged()
+{
+  if (m_sceneObject == nullptr && m_lastSceneObject != nullptr)
+  {
+    RigidBody * pBody = m_lastSceneObject->getComponent<RigidBody>();
+    if (pBody != nullptr)
+    {
+      pBody->updateDefinition();
+    }
+  }
+  m_lastSceneObject = m_sceneObject;
+  updateRigidBody();
+}
+
+void Collider::updateRigidBody()
+{
+  if (m_sceneObject == nullptr)
+    return;
+  RigidBody * pBody = m_sceneObject->getComponent<RigidBody>();
+  if (pBody != nullptr)
+  {
+    pBody->updateDefinition();
+  }
+}
@@ -1,7 +1,108 @@
 #include "Core/Component.h"
+#include "ComponentIndex.h"
+#include "Core/MemoryStats.h"
 #include "Core/SceneObject.h"
+#include "Core/UpdateScheduler.h"
+#include "ScenePools.h"
+#include "SceneVersions.h"
+#include <algorithm>
+#include <atomic>
+#include <new>
 
-Component::Component() = default;
+namespace
+{
+
+/**
+ * The blocks returned by Component::operator new on this thread whose
+ * constructor didn't run yet. The Component constructor looks for the block
+ * it lies in, Component doesn't have to be the first base of the type. It's
+ * a stack because constructors can allocate other components before the
+ * Component base of the outer one is constructed.
+ */
+struct PendingAllocations
+{
+  static size_t const CAPACITY = 8;
+
+  struct Block
+  {
+    char const * p;
+    size_t size;
+  };
+
+  Block blocks[CAPACITY];
+
+  size_t count{0};
+
+  void push(void const * p, size_t size)
+  {
+    if (count == CAPACITY)
+    {
+      // blocks whose construction failed, the oldest is the least useful
+      std::copy(blocks + 1, blocks + CAPACITY, blocks);
+      --count;
+    }
+    blocks[count++] = Block{static_cast<char const *>(p), size};
+  }
+
+  /** Removes the block containing p and those above it, returns its size. */
+  size_t pop(void const * p)
+  {
+    char const * const pByte = static_cast<char const *>(p);
+    for (size_t i = count; i > 0; --i)
+    {
+      Block const & block = blocks[i - 1];
+      if (pByte >= block.p && pByte < block.p + block.size)
+      {
+        count = i - 1;
+        return block.size;
+      }
+    }
+    return 0;
+  }
+};
+
+thread_local PendingAllocations pendingAllocations;
+
+/** The next state version, zero is never used. */
+std::atomic<uint64_t> nextStateVersion{1};
+
+/** Threads take versions in blocks to rarely touch the shared counter. */
+uint64_t const STATE_VERSION_BLOCK = 1024;
+
+struct StateVersions
+{
+  uint64_t next{0};
+  uint64_t end{0};
+};
+
+thread_local StateVersions stateVersions;
+
+uint64_t getNewStateVersion()
+{
+  if (stateVersions.next == stateVersions.end)
+  {
+    stateVersions.next = nextStateVersion.fetch_add(
+        STATE_VERSION_BLOCK, std::memory_order_relaxed);
+    stateVersions.end = stateVersions.next + STATE_VERSION_BLOCK;
+  }
+  return stateVersions.next++;
+}
+
+MemoryCategory & getComponentMemory()
+{
+  static MemoryCategory & category =
+      MemoryStats::getInstance().getObjectType("Component");
+  return category;
+}
+
+} // namespace
+
+Component::Component()
+    : m_allocationSize(pendingAllocations.pop(this)),
+      m_updateEntry(UpdateScheduler::INVALID_ENTRY),
+      m_stateVersion(getNewStateVersion())
+{
+}
 
 Component::~Component()
 {
@@ -15,10 +116,110 @@ void Component::update(double) {}
 
 void Component::render() const {}
 
+Component * Component::clone() const { return nullptr; }
+
+Component * Component::cloneInto(void *) const { return nullptr; }
+
+void Component::onActivationChanged() {}
+
 SceneObject const * Component::getSceneObject() const { return m_sceneObject; }
 
 SceneObject * Component::getSceneObject() { return m_sceneObject; }
 
-void Component::setEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+void Component::setEnabled(bool isEnabled)
+{
+  if (m_isEnabled != isEnabled)
+  {
+    m_isEnabled = isEnabled;
+    if (m_sceneObject != nullptr)
+    {
+      SceneVersions::markActivationChanged(*m_sceneObject);
+    }
+    ComponentIndex::getInstance().onComponentChanged(*this);
+    onActivationChanged();
+  }
+}
+
+bool Component::isEnabled() const { return m_isEnabled; }
+
+bool Component::isActive() const
+{
+  return m_isEnabled && m_sceneObject != nullptr &&
+         m_sceneObject->isEnabledInHierarchy();
+}
+
+void Component::setUpdateFrequency(double hertz)
+{
+  m_updateFrequency = hertz > 0.0 ? hertz : 0.0;
+  updateSchedulerRegistration();
+}
+
+double Component::getUpdateFrequency() const { return m_updateFrequency; }
+
+void Component::updateSchedulerRegistration()
+{
+  bool const isScheduled = m_updateFrequency > 0.0 && m_sceneObject != nullptr;
+  if (isScheduled && m_updateEntry == UpdateScheduler::INVALID_ENTRY)
+  {
+    UpdateScheduler::getInstance().add(this);
+  }
+  else if (!isScheduled && m_updateEntry != UpdateScheduler::INVALID_ENTRY)
+  {
+    UpdateScheduler::getInstance().remove(this);
+  }
+  else if (isScheduled)
+  {
+    UpdateScheduler::getInstance().reschedule(this);
+  }
+}
+
+size_t Component::getStateSize() const { return 0; }
 
-bool Component::isEnabled() const { return m_isEnabled; }
\ No newline at end of file
+void Component::saveState(void *) const {}
+
+void Component::loadState(void const *) {}
+
+uint64_t Component::getStateVersion() const { return m_stateVersion; }
+
+void Component::markStateChanged() { m_stateVersion = getNewStateVersion(); }
+
+size_t Component::getAllocationSize() const { return m_allocationSize; }
+
+void * Component::operator new(size_t size)
+{
+  void * p = getComponentPool().allocate(size);
+  getComponentMemory().recordAllocation(size);
+  pendingAllocations.push(p, size);
+  return p;
+}
+
+void * Component::operator new(size_t size, std::align_val_t alignment)
+{
+  void * p = ::operator new(size, alignment);
+  getComponentMemory().recordAllocation(size);
+  pendingAllocations.push(p, size);
+  return p;
+}
+
+void allocateComponents(size_t size, size_t count, void ** ppBlocks)
+{
+  getComponentPool().allocate(size, count, ppBlocks);
+  getComponentMemory().recordAllocations(count, count * size);
+}
+
+void Component::operator delete(void * p, size_t size)
+{
+  // the virtual destructor passes the size of the dynamic type, a throwing
+  // constructor leaves a pending block
+  pendingAllocations.pop(p);
+  getComponentMemory().recordDeallocation(size);
+  getComponentPool().deallocate(p, size);
+}
+
+void Component::operator delete(void * p, size_t size,
+                                std::align_val_t alignment)
+{
+  pendingAllocations.pop(p);
+  getComponentMemory().recordDeallocation(size);
+  ::operator delete(p, size, alignment);
+}
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "ComponentIndex.h"
+#include "Core/Component.h"
+#include <algorithm>
+
+ComponentIndex & ComponentIndex::getInstance()
+{
+  static ComponentIndex instance;
+  return instance;
+}
+
+ComponentIndex::ComponentIndex() = default;
+
+void ComponentIndex::attach(Component & component, size_t typeId)
+{
+  attach(component, typeId, m_components[typeId]);
+  onComponentChanged(component);
+}
+
+std::vector<Component *> & ComponentIndex::getList(size_t typeId)
+{
+  return m_components[typeId];
+}
+
+void ComponentIndex::attach(Component & component, size_t typeId,
+                            std::vector<Component *> & list)
+{
+  component.m_typeId = typeId;
+  component.m_indexPosition = static_cast<uint32_t>(list.size());
+  list.push_back(&component);
+}
+
+void ComponentIndex::detach(Component & component, SceneObject & object)
+{
+  remove(component);
+  auto iter = m_queriesByType.find(component.m_typeId);
+  if (iter != m_queriesByType.end())
+  {
+    for (ComponentQuery::Impl * pQuery : iter->second)
+    {
+      pQuery->evaluate(object);
+    }
+  }
+}
+
+void ComponentIndex::remove(Component & component)
+{
+  std::vector<Component *> & components = m_components[component.m_typeId];
+  uint32_t const position = component.m_indexPosition;
+  if (position < components.size() && components[position] == &component)
+  {
+    components[position] = components.back();
+    components[position]->m_indexPosition = position;
+    components.pop_back();
+  }
+}
+
+void ComponentIndex::onComponentChanged(Component & component)
+{
+  if (component.m_sceneObject == nullptr)
+    return;
+  auto iter = m_queriesByType.find(component.m_typeId);
+  if (iter != m_queriesByType.end())
+  {
+    for (ComponentQuery::Impl * pQuery : iter->second)
+    {
+      pQuery->evaluate(*component.m_sceneObject);
+    }
+  }
+}
+
+void ComponentIndex::onObjectChanged(SceneObject & object)
+{
+  for (ComponentQuery::Impl * pQuery : m_queries)
+  {
+    pQuery->evaluate(object);
+  }
+}
+
+void ComponentIndex::onObjectDestroyed(SceneObject const & object)
+{
+  for (ComponentQuery::Impl * pQuery : m_queries)
+  {
+    pQuery->remove(object);
+  }
+}
+
+std::vector<Component *> const &
+ComponentIndex::getComponents(size_t typeId) const
+{
+  static std::vector<Component *> const none;
+  auto iter = m_components.find(typeId);
+  return iter != m_components.end() ? iter->second : none;
+}
+
+void ComponentIndex::addQuery(ComponentQuery::Impl * pQuery)
+{
+  m_queries.push_back(pQuery);
+  std::vector<size_t> types = pQuery->getTypes();
+  std::sort(types.begin(), types.end());
+  types.erase(std::unique(types.begin(), types.end()), types.end());
+  for (size_t typeId : types)
+  {
+    m_queriesByType[typeId].push_back(pQuery);
+  }
+}
+
+void ComponentIndex::removeQuery(ComponentQuery::Impl * pQuery)
+{
+  m_queries.erase(std::remove(m_queries.begin(), m_queries.end(), pQuery),
+                  m_queries.end());
+  for (auto iter = m_queriesByType.begin(); iter != m_queriesByType.end();)
+  {
+    std::vector<ComponentQuery::Impl *> & queries = iter->second;
+    queries.erase(std::remove(queries.begin(), queries.end(), pQuery),
+                  queries.end());
+    iter = queries.empty() ? m_queriesByType.erase(iter) : std::next(iter);
+  }
+}
@@ -0,0 +1,207 @@
+#include "Core/ComponentQuery.h"
+#include "ComponentIndex.h"
+#include "Core/Component.h"
+#include "SceneObjectImpl.h"
+#include <algorithm>
+
+/********** Impl start ************/
+
+ComponentQuery::Impl::Impl() { ComponentIndex::getInstance().addQuery(this); }
+
+ComponentQuery::Impl::~Impl()
+{
+  ComponentIndex::getInstance().removeQuery(this);
+}
+
+void ComponentQuery::Impl::require(size_t typeId)
+{
+  if (std::find(m_required.begin(), m_required.end(), typeId) !=
+      m_required.end())
+    return;
+  m_required.push_back(typeId);
+  rebuild();
+}
+
+void ComponentQuery::Impl::exclude(size_t typeId)
+{
+  if (std::find(m_excluded.begin(), m_excluded.end(), typeId) !=
+      m_excluded.end())
+    return;
+  m_excluded.push_back(typeId);
+  rebuild();
+}
+
+size_t ComponentQuery::Impl::getNumberOfObjects() const
+{
+  return m_objects.size();
+}
+
+SceneObject * ComponentQuery::Impl::getObject(size_t index) const
+{
+  return m_objects[index];
+}
+
+size_t ComponentQuery::Impl::getColumn(size_t typeId) const
+{
+  auto iter = std::find(m_required.begin(), m_required.end(), typeId);
+  return iter != m_required.end()
+             ? static_cast<size_t>(iter - m_required.begin())
+             : INVALID_COLUMN;
+}
+
+Component * ComponentQuery::Impl::getComponent(size_t index,
+                                               size_t column) const
+{
+  return m_components[index * m_required.size() + column];
+}
+
+void ComponentQuery::Impl::parallelFor(
+    size_t grainSize, JobSystem::RangeFunction const & function) const
+{
+  JobSystem::getInstance().parallelFor(m_objects.size(), grainSize, function);
+}
+
+std::vector<size_t> ComponentQuery::Impl::getTypes() const
+{
+  std::vector<size_t> types(m_required);
+  types.insert(types.end(), m_excluded.begin(), m_excluded.end());
+  return types;
+}
+
+void ComponentQuery::Impl::evaluate(SceneObject & object)
+{
+  SceneObject::Impl const & impl = *object.m_impl;
+  bool isMatch = !m_required.empty() && impl.isEnabledInHierarchy();
+  m_candidate.clear();
+  for (size_t i = 0; isMatch && i < m_required.size(); ++i)
+  {
+    Component * pComponent = impl.getComponent(m_required[i]);
+    isMatch = pComponent != nullptr && pComponent->isEnabled();
+    if (isMatch)
+    {
+      m_candidate.push_back(pComponent);
+    }
+  }
+  for (size_t i = 0; isMatch && i < m_excluded.size(); ++i)
+  {
+    Component const * pComponent = impl.getComponent(m_excluded[i]);
+    isMatch = pComponent == nullptr || !pComponent->isEnabled();
+  }
+
+  auto row = m_rows.find(&object);
+  if (!isMatch)
+  {
+    if (row != m_rows.end())
+    {
+      remove(object);
+    }
+  }
+  else if (row == m_rows.end())
+  {
+    m_rows.emplace(&object, m_objects.size());
+    m_objects.push_back(&object);
+    m_components.insert(m_components.end(), m_candidate.begin(),
+                        m_candidate.end());
+  }
+  else
+  {
+    // a component may have been replaced by another one of the same type
+    std::copy(m_candidate.begin(), m_candidate.end(),
+              m_components.begin() + row->second * m_required.size());
+  }
+}
+
+void ComponentQuery::Impl::remove(SceneObject const & object)
+{
+  auto row = m_rows.find(&object);
+  if (row == m_rows.end())
+    return;
+  // move the last match into the gap to keep the matches contiguous
+  size_t const index = row->second;
+  size_t const last = m_objects.size() - 1;
+  size_t const stride = m_required.size();
+  m_rows.erase(row);
+  if (index != last)
+  {
+    m_objects[index] = m_objects[last];
+    std::copy(m_components.begin() + last * stride,
+              m_components.begin() + (last + 1) * stride,
+              m_components.begin() + index * stride);
+    m_rows[m_objects[index]] = index;
+  }
+  m_objects.pop_back();
+  m_components.resize(last * stride);
+}
+
+void ComponentQuery::Impl::rebuild()
+{
+  ComponentIndex & index = ComponentIndex::getInstance();
+  index.removeQuery(this);
+  index.addQuery(this);
+
+  m_objects.clear();
+  m_components.clear();
+  m_rows.clear();
+  if (m_required.empty())
+    return;
+
+  // the matches are among the objects of the rarest required type
+  std::vector<Component *> const * pCandidates =
+      &index.getComponents(m_required.front());
+  for (size_t typeId : m_required)
+  {
+    std::vector<Component *> const & components = index.getComponents(typeId);
+    if (components.size() < pCandidates->size())
+    {
+      pCandidates = &components;
+    }
+  }
+  for (Component * pComponent : *pCandidates)
+  {
+    evaluate(*pComponent->getSceneObject());
+  }
+}
+
+/******************** Impl end *************************************/
+
+ComponentQuery::ComponentQuery() : m_impl(new Impl()) {}
+
+ComponentQuery::~ComponentQuery() = default;
+
+ComponentQuery & ComponentQuery::require(std::type_info const & type)
+{
+  m_impl->require(type.hash_code());
+  return *this;
+}
+
+ComponentQuery & ComponentQuery::exclude(std::type_info const & type)
+{
+  m_impl->exclude(type.hash_code());
+  return *this;
+}
+
+size_t ComponentQuery::getNumberOfObjects() const
+{
+  return m_impl->getNumberOfObjects();
+}
+
+SceneObject * ComponentQuery::getObject(size_t index) const
+{
+  return m_impl->getObject(index);
+}
+
+size_t ComponentQuery::getColumn(std::type_info const & type) const
+{
+  return m_impl->getColumn(type.hash_code());
+}
+
+Component * ComponentQuery::getComponent(size_t index, size_t column) const
+{
+  return m_impl->getComponent(index, column);
+}
+
+void ComponentQuery::parallelFor(
+    size_t grainSize, JobSystem::RangeFunction const & function) const
+{
+  m_impl->parallelFor(grainSize, function);
+}
@@ -0,0 +1,186 @@
+#include "Core/FramePipeline.h"
+#include "Core/RenderWorld.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+/********** Impl start ************/
+
+class FramePipeline::Impl final
+{
+public:
+  Impl(RenderFunction const & render, bool isPipelined);
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  void submitFrame();
+
+  void waitForRenderer();
+
+  bool isPipelined() const;
+
+  FrameStatistics const & getStatistics() const;
+
+private:
+  using Clock = std::chrono::steady_clock;
+
+  /** The loop of the render thread. */
+  void run();
+
+  RenderFunction m_render;
+
+  bool const m_isPipelined;
+
+  RenderSnapshot m_snapshots[RenderWorld::NUMBER_OF_BUFFERS];
+
+  /** True while the renderer owns the snapshot of the same index. */
+  bool m_isBusy[RenderWorld::NUMBER_OF_BUFFERS] = {};
+
+  /** The snapshots waiting for the render thread, oldest first. */
+  std::deque<size_t> m_queue{};
+
+  uint64_t m_frame{0};
+
+  bool m_isStopping{false};
+
+  FrameStatistics m_statistics{};
+
+  std::mutex m_mutex{};
+
+  std::condition_variable m_condition{};
+
+  std::thread m_thread{};
+};
+
+FramePipeline::Impl::Impl(RenderFunction const & render, bool isPipelined)
+    : m_render(render), m_isPipelined(isPipelined)
+{
+  // the new snapshots start empty and need a full extraction
+  RenderWorld::getInstance().markAllDirty();
+  if (m_isPipelined)
+  {
+    m_thread = std::thread(&Impl::run, this);
+  }
+}
+
+FramePipeline::Impl::~Impl()
+{
+  if (m_thread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isStopping = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+  }
+}
+
+void FramePipeline::Impl::submitFrame()
+{
+  size_t const bufferIndex = m_frame % RenderWorld::NUMBER_OF_BUFFERS;
+  RenderSnapshot & snapshot = m_snapshots[bufferIndex];
+
+  // the renderer may still draw the frame before the last one from it
+  Clock::time_point start = Clock::now();
+  if (m_isPipelined)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [&]() { return !m_isBusy[bufferIndex]; });
+  }
+  Clock::time_point const extractStart = Clock::now();
+  m_statistics.waitSeconds =
+      std::chrono::duration<double>(extractStart - start).count();
+
+  snapshot.frame = m_frame;
+  m_statistics.extractedItems =
+      RenderWorld::getInstance().extract(snapshot, bufferIndex);
+  m_statistics.extractSeconds =
+      std::chrono::duration<double>(Clock::now() - extractStart).count();
+  ++m_frame;
+
+  if (m_isPipelined)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_isBusy[bufferIndex] = true;
+      m_queue.push_back(bufferIndex);
+    }
+    m_condition.notify_all();
+  }
+  else
+  {
+    m_render(snapshot);
+  }
+}
+
+void FramePipeline::Impl::waitForRenderer()
+{
+  if (m_isPipelined)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [&]() {
+      for (bool isBusy : m_isBusy)
+      {
+        if (isBusy)
+          return false;
+      }
+      return true;
+    });
+  }
+}
+
+bool FramePipeline::Impl::isPipelined() const { return m_isPipelined; }
+
+FrameStatistics const & FramePipeline::Impl::getStatistics() const
+{
+  return m_statistics;
+}
+
+void FramePipeline::Impl::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_condition.wait(lock, [&]() { return m_isStopping || !m_queue.empty(); });
+    if (m_queue.empty())
+      return; // stopping and nothing left to draw
+    size_t const bufferIndex = m_queue.front();
+    m_queue.pop_front();
+    lock.unlock();
+    m_render(m_snapshots[bufferIndex]);
+    lock.lock();
+    m_isBusy[bufferIndex] = false;
+    m_condition.notify_all();
+  }
+}
+
+/******************** Impl end *************************************/
+
+FramePipeline::FramePipeline(RenderFunction const & render, bool isPipelined)
+    : m_impl(new Impl(render, isPipelined))
+{
+}
+
+FramePipeline::~FramePipeline() = default;
+
+void FramePipeline::submitFrame() { m_impl->submitFrame(); }
+
+void FramePipeline::waitForRenderer() { m_impl->waitForRenderer(); }
+
+bool FramePipeline::isPipelined() const { return m_impl->isPipelined(); }
+
+FrameStatistics const & FramePipeline::getStatistics() const
+{
+  return m_impl->getStatistics();
+}
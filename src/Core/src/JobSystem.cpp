@@ -0,0 +1,208 @@
+#include "Core/JobSystem.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/********** Impl start ************/
+
+class JobSystem::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  void parallelFor(size_t count, size_t grainSize,
+                   RangeFunction const & function);
+
+  size_t getNumberOfThreads() const;
+
+  void setNumberOfThreads(size_t numberOfThreads);
+
+private:
+  void startWorkers(size_t numberOfThreads);
+
+  void stopWorkers();
+
+  void runWorker();
+
+  /** Takes chunks of the current loop until none are left. */
+  void processChunks();
+
+  std::vector<std::thread> m_workers{};
+
+  std::mutex m_mutex{};
+
+  std::condition_variable m_wakeUp{};
+
+  std::condition_variable m_finished{};
+
+  /** Incremented for every loop, so workers join each loop only once. */
+  uint64_t m_generation{0};
+
+  bool m_isStopping{false};
+
+  /** Set while a loop runs, further loops run serially. */
+  std::atomic<bool> m_isBusy{false};
+
+  RangeFunction const * m_function{nullptr};
+
+  size_t m_count{0};
+
+  size_t m_grainSize{1};
+
+  std::atomic<size_t> m_nextChunk{0};
+
+  /** The number of workers still inside the current loop. */
+  size_t m_activeWorkers{0};
+};
+
+JobSystem::Impl::Impl() { startWorkers(0); }
+
+JobSystem::Impl::~Impl() { stopWorkers(); }
+
+void JobSystem::Impl::parallelFor(size_t count, size_t grainSize,
+                                  RangeFunction const & function)
+{
+  grainSize = std::max<size_t>(grainSize, 1);
+  bool expected = false;
+  if (m_workers.empty() || count <= grainSize ||
+      !m_isBusy.compare_exchange_strong(expected, true))
+  {
+    for (size_t begin = 0; begin < count; begin += grainSize)
+    {
+      function(begin, std::min(begin + grainSize, count));
+    }
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_function = &function;
+    m_count = count;
+    m_grainSize = grainSize;
+    m_nextChunk.store(0, std::memory_order_relaxed);
+    m_activeWorkers = m_workers.size();
+    ++m_generation;
+  }
+  m_wakeUp.notify_all();
+  processChunks();
+
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_finished.wait(lock, [this] { return m_activeWorkers == 0; });
+  m_function = nullptr;
+  m_isBusy.store(false);
+}
+
+size_t JobSystem::Impl::getNumberOfThreads() const
+{
+  return m_workers.size() + 1;
+}
+
+void JobSystem::Impl::setNumberOfThreads(size_t numberOfThreads)
+{
+  stopWorkers();
+  startWorkers(numberOfThreads);
+}
+
+void JobSystem::Impl::startWorkers(size_t numberOfThreads)
+{
+  if (numberOfThreads == 0)
+  {
+    numberOfThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  m_isStopping = false;
+  for (size_t i = 1; i < numberOfThreads; ++i)
+  {
+    m_workers.emplace_back(&Impl::runWorker, this);
+  }
+}
+
+void JobSystem::Impl::stopWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_wakeUp.notify_all();
+  for (std::thread & worker : m_workers)
+  {
+    worker.join();
+  }
+  m_workers.clear();
+}
+
+void JobSystem::Impl::runWorker()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  // Workers started after earlier loops must not join the last one again.
+  uint64_t generation = m_generation;
+  while (true)
+  {
+    m_wakeUp.wait(lock, [this, generation] {
+      return m_isStopping || m_generation != generation;
+    });
+    if (m_isStopping)
+      return;
+    generation = m_generation;
+    lock.unlock();
+    processChunks();
+    lock.lock();
+    if (--m_activeWorkers == 0)
+    {
+      m_finished.notify_one();
+    }
+  }
+}
+
+void JobSystem::Impl::processChunks()
+{
+  size_t const numberOfChunks = (m_count + m_grainSize - 1) / m_grainSize;
+  size_t chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+  while (chunk < numberOfChunks)
+  {
+    size_t const begin = chunk * m_grainSize;
+    (*m_function)(begin, std::min(begin + m_grainSize, m_count));
+    chunk = m_nextChunk.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+/******************** Impl end *************************************/
+
+JobSystem & JobSystem::getInstance()
+{
+  static JobSystem instance;
+  return instance;
+}
+
+JobSystem::JobSystem() : m_impl(new Impl()) {}
+
+JobSystem::~JobSystem() = default;
+
+void JobSystem::parallelFor(size_t count, size_t grainSize,
+                            RangeFunction const & function)
+{
+  m_impl->parallelFor(count, grainSize, function);
+}
+
+size_t JobSystem::getNumberOfThreads() const
+{
+  return m_impl->getNumberOfThreads();
+}
+
+void JobSystem::setNumberOfThreads(size_t numberOfThreads)
+{
+  m_impl->setNumberOfThreads(numberOfThreads);
+}
@@ -0,0 +1,186 @@
+#include "Core/LogReader.h"
+#include "LogText.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+/********** Impl start ************/
+
+class LogReader::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  bool open(std::string const & filename);
+
+  bool read(LogEntry & entry);
+
+  uint64_t getStartTime() const;
+
+  bool isTruncated() const;
+
+private:
+  /** Reads the value at the read position and advances it. */
+  template <class T> bool readValue(T & value, size_t end)
+  {
+    if (end - m_position < sizeof(T))
+    {
+      return false;
+    }
+    std::memcpy(&value, m_data.data() + m_position, sizeof(T));
+    m_position += sizeof(T);
+    return true;
+  }
+
+  std::vector<uint8_t> m_data{};
+
+  size_t m_position{0};
+
+  uint64_t m_startTime{0};
+
+  bool m_isTruncated{false};
+
+  std::unordered_map<uint32_t, std::string> m_formats{};
+};
+
+LogReader::Impl::Impl() = default;
+
+LogReader::Impl::~Impl() = default;
+
+bool LogReader::Impl::open(std::string const & filename)
+{
+  m_data.clear();
+  m_formats.clear();
+  m_position = 0;
+  m_startTime = 0;
+  m_isTruncated = false;
+  std::ifstream file(filename, std::ios::binary);
+  if (!file)
+  {
+    return false;
+  }
+  m_data.assign(std::istreambuf_iterator<char>(file),
+                std::istreambuf_iterator<char>());
+
+  LogFormat::Header header;
+  if (!readValue(header, m_data.size()) || header.magic != LogFormat::MAGIC ||
+      header.version != LogFormat::VERSION)
+  {
+    m_data.clear();
+    m_position = 0;
+    return false;
+  }
+  m_startTime = header.startTime;
+  return true;
+}
+
+bool LogReader::Impl::read(LogEntry & entry)
+{
+  LogFormat::RecordHeader record;
+  while (m_position != m_data.size())
+  {
+    if (!readValue(record, m_data.size()) ||
+        m_data.size() - m_position < record.size)
+    {
+      m_isTruncated = true;
+      m_position = m_data.size();
+      return false;
+    }
+    size_t const end = m_position + record.size;
+    entry.severity = static_cast<LogSeverity>(record.severity);
+    entry.category = static_cast<LogCategory>(record.category);
+    entry.message.clear();
+    bool isValid = record.severity < NUMBER_OF_SEVERITIES &&
+                   record.category < NUMBER_OF_CATEGORIES;
+    if (record.type == LogFormat::RECORD_FORMAT)
+    {
+      uint32_t id = 0;
+      isValid = readValue(id, end);
+      m_formats[id].assign(
+          reinterpret_cast<char const *>(m_data.data() + m_position),
+          end - m_position);
+      m_position = end;
+      if (isValid)
+      {
+        continue;
+      }
+    }
+    else if (record.type == LogFormat::RECORD_MESSAGE)
+    {
+      LogFormat::MessageHeader message{};
+      isValid = isValid && readValue(message, end);
+      auto const format = m_formats.find(message.format);
+      isValid = isValid && format != m_formats.end() &&
+                appendMessage(entry.message, format->second.data(),
+                              format->second.size(), m_data.data() + m_position,
+                              end - m_position);
+      entry.timestamp = message.timestamp;
+      entry.thread = message.thread;
+    }
+    else if (record.type == LogFormat::RECORD_DROPPED)
+    {
+      LogFormat::DroppedRecord dropped{};
+      isValid = isValid && readValue(dropped, end);
+      entry.timestamp = dropped.timestamp;
+      entry.thread = dropped.thread;
+      entry.message = std::to_string(dropped.numberOfMessages) +
+                      " messages were dropped";
+    }
+    else
+    {
+      isValid = false;
+    }
+    m_position = end;
+    if (!isValid)
+    {
+      m_isTruncated = true;
+      m_position = m_data.size();
+      return false;
+    }
+    return true;
+  }
+  return false;
+}
+
+uint64_t LogReader::Impl::getStartTime() const { return m_startTime; }
+
+bool LogReader::Impl::isTruncated() const { return m_isTruncated; }
+
+/******************** Impl end *************************************/
+
+LogReader::LogReader() : m_impl(new Impl()) {}
+
+LogReader::~LogReader() = default;
+
+bool LogReader::open(std::string const & filename)
+{
+  return m_impl->open(filename);
+}
+
+bool LogReader::read(LogEntry & entry) { return m_impl->read(entry); }
+
+uint64_t LogReader::getStartTime() const { return m_impl->getStartTime(); }
+
+bool LogReader::isTruncated() const { return m_impl->isTruncated(); }
+
+std::string LogReader::formatEntry(LogEntry const & entry)
+{
+  std::string line;
+  appendLinePrefix(line, entry.timestamp, entry.thread,
+                   static_cast<uint8_t>(entry.severity),
+                   static_cast<uint8_t>(entry.category));
+  line += entry.message;
+  return line;
+}
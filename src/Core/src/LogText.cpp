@@ -0,0 +1,187 @@
+#include "LogText.h"
+#include "Core/LogFormat.h"
+#include "Core/Logger.h"
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+/**
+ * Appends the argument at pData and advances pData past it. Returns false if
+ * the argument is malformed.
+ */
+bool appendArgument(std::string & text, uint8_t const *& pData,
+                    uint8_t const * pEnd)
+{
+  if (pData == pEnd)
+  {
+    return false;
+  }
+  uint8_t const type = *pData++;
+  size_t const available = static_cast<size_t>(pEnd - pData);
+  char buffer[32];
+  std::to_chars_result result{buffer, std::errc()};
+  switch (type)
+  {
+  case LogFormat::ARGUMENT_BOOL:
+  case LogFormat::ARGUMENT_CHARACTER:
+    if (available < 1)
+    {
+      return false;
+    }
+    if (type == LogFormat::ARGUMENT_BOOL)
+    {
+      text += *pData != 0 ? "true" : "false";
+    }
+    else
+    {
+      text += static_cast<char>(*pData);
+    }
+    ++pData;
+    return true;
+  case LogFormat::ARGUMENT_FLOAT:
+  {
+    float value = 0.0f;
+    if (available < sizeof(value))
+    {
+      return false;
+    }
+    std::memcpy(&value, pData, sizeof(value));
+    pData += sizeof(value);
+    result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    break;
+  }
+  case LogFormat::ARGUMENT_STRING:
+  {
+    uint16_t length = 0;
+    if (available < sizeof(length))
+    {
+      return false;
+    }
+    std::memcpy(&length, pData, sizeof(length));
+    if (available - sizeof(length) < length)
+    {
+      return false;
+    }
+    text.append(reinterpret_cast<char const *>(pData + sizeof(length)),
+                length);
+    pData += sizeof(length) + length;
+    return true;
+  }
+  case LogFormat::ARGUMENT_INTEGER:
+  case LogFormat::ARGUMENT_UNSIGNED:
+  case LogFormat::ARGUMENT_DOUBLE:
+  case LogFormat::ARGUMENT_POINTER:
+  {
+    uint64_t value = 0;
+    if (available < sizeof(value))
+    {
+      return false;
+    }
+    std::memcpy(&value, pData, sizeof(value));
+    pData += sizeof(value);
+    if (type == LogFormat::ARGUMENT_INTEGER)
+    {
+      result = std::to_chars(buffer, buffer + sizeof(buffer),
+                             static_cast<int64_t>(value));
+    }
+    else if (type == LogFormat::ARGUMENT_UNSIGNED)
+    {
+      result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    }
+    else if (type == LogFormat::ARGUMENT_DOUBLE)
+    {
+      double number = 0.0;
+      std::memcpy(&number, &value, sizeof(number));
+      result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    }
+    else
+    {
+      text += "0x";
+      result = std::to_chars(buffer, buffer + sizeof(buffer), value, 16);
+    }
+    break;
+  }
+  default:
+    return false;
+  }
+  text.append(buffer, result.ptr);
+  return true;
+}
+
+} // namespace
+
+bool appendMessage(std::string & text, char const * pFormat,
+                   size_t formatLength, uint8_t const * pArguments,
+                   size_t argumentSize)
+{
+  uint8_t const * pData = pArguments;
+  uint8_t const * pEnd = pArguments + argumentSize;
+  char const * pFormatEnd = pFormat + formatLength;
+  while (pFormat != pFormatEnd)
+  {
+    char const * pBrace = pFormat;
+    while (pBrace != pFormatEnd && *pBrace != '{' && *pBrace != '}')
+    {
+      ++pBrace;
+    }
+    text.append(pFormat, pBrace);
+    if (pBrace == pFormatEnd)
+    {
+      break;
+    }
+    char const next = pBrace + 1 != pFormatEnd ? pBrace[1] : '\0';
+    if (pBrace[0] == '{' && next == '}' && pData != pEnd)
+    {
+      if (!appendArgument(text, pData, pEnd))
+      {
+        return false;
+      }
+      pFormat = pBrace + 2;
+    }
+    else if (next == pBrace[0] || (pBrace[0] == '{' && next == '}'))
+    {
+      // escaped braces are written once, {} without an argument as it is
+      text.append(pBrace, next == pBrace[0] ? 1 : 2);
+      pFormat = pBrace + 2;
+    }
+    else
+    {
+      text += pBrace[0];
+      pFormat = pBrace + 1;
+    }
+  }
+  while (pData != pEnd)
+  {
+    text += ' ';
+    if (!appendArgument(text, pData, pEnd))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void appendLinePrefix(std::string & text, uint64_t timestamp, uint32_t thread,
+                      uint8_t severity, uint8_t category)
+{
+  char buffer[96];
+  int const length = std::snprintf(
+      buffer, sizeof(buffer), "%12.6f %-7s %-9s #%-2u ",
+      static_cast<double>(timestamp) * 1e-9,
+      severity < NUMBER_OF_SEVERITIES
+          ? getSeverityName(static_cast<LogSeverity>(severity))
+          : "?",
+      category < NUMBER_OF_CATEGORIES
+          ? getCategoryName(static_cast<LogCategory>(category))
+          : "?",
+      static_cast<unsigned>(thread));
+  if (length > 0)
+  {
+    text.append(buffer, static_cast<size_t>(length) < sizeof(buffer)
+                            ? static_cast<size_t>(length)
+                            : sizeof(buffer) - 1);
+  }
+}
@@ -0,0 +1,678 @@
+#include "Core/Logger.h"
+#include "LogText.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+/** The bytes of the ring buffer of every logging thread, a power of two. */
+size_t const BUFFER_SIZE = size_t{1} << 17;
+
+/** Messages start at multiples of it in the ring buffers. */
+size_t const RECORD_ALIGNMENT = 8;
+
+/** The severity of the records that fill the end of a ring buffer. */
+uint8_t const PADDING = 0xFF;
+
+/** How long the writer thread sleeps if nobody waits for a flush. */
+std::chrono::milliseconds const WRITE_INTERVAL(2);
+
+/** A message in a ring buffer, followed by its encoded arguments. */
+struct BufferRecord
+{
+  /** The bytes of the record including alignment. */
+  uint32_t size;
+
+  uint16_t argumentSize;
+
+  uint8_t severity;
+
+  uint8_t category;
+
+  /** The steady clock in nanoseconds. */
+  uint64_t timestamp;
+
+  char const * format;
+};
+
+/** The part of a record that is written for padding records. */
+size_t const PADDING_SIZE = 8;
+
+static_assert(PADDING_SIZE <= RECORD_ALIGNMENT &&
+                  sizeof(BufferRecord) % RECORD_ALIGNMENT == 0,
+              "Padding records must fit into every gap.");
+
+/**
+ * The ring buffer of one logging thread. The thread is the only one that
+ * writes messages and the writer thread the only one that reads them.
+ */
+struct ThreadBuffer
+{
+  std::unique_ptr<uint8_t[]> pData{new uint8_t[BUFFER_SIZE]};
+
+  /** The positions only grow, the buffer offset is the position modulo. */
+  alignas(64) std::atomic<uint64_t> writePosition{0};
+
+  alignas(64) std::atomic<uint64_t> readPosition{0};
+
+  /** The last read position the logging thread has seen. */
+  alignas(64) uint64_t cachedReadPosition{0};
+
+  /** The write position after the message that is being written. */
+  uint64_t pendingPosition{0};
+
+  std::atomic<uint64_t> numberOfDropped{0};
+
+  /** Set when the thread ended, the buffer is removed once it's empty. */
+  std::atomic<bool> isAbandoned{false};
+
+  uint32_t thread{0};
+};
+
+/** Marks the buffer of the thread as abandoned when the thread ends. */
+struct ThreadBufferOwner
+{
+  ~ThreadBufferOwner()
+  {
+    if (pBuffer)
+    {
+      pBuffer->isAbandoned.store(true, std::memory_order_release);
+    }
+  }
+
+  std::shared_ptr<ThreadBuffer> pBuffer{};
+};
+
+thread_local ThreadBufferOwner threadBufferOwner;
+
+/** The buffer of the thread without the guard of threadBufferOwner. */
+thread_local ThreadBuffer * pThreadBuffer = nullptr;
+
+uint64_t getSteadyTime()
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+template <class T>
+void appendBytes(std::vector<uint8_t> & bytes, T const & value)
+{
+  uint8_t const * pValue = reinterpret_cast<uint8_t const *>(&value);
+  bytes.insert(bytes.end(), pValue, pValue + sizeof(T));
+}
+
+} // namespace
+
+char const * getSeverityName(LogSeverity severity)
+{
+  switch (severity)
+  {
+  case SEVERITY_TRACE:
+    return "TRACE";
+  case SEVERITY_DEBUG:
+    return "DEBUG";
+  case SEVERITY_INFO:
+    return "INFO";
+  case SEVERITY_WARNING:
+    return "WARNING";
+  case SEVERITY_ERROR:
+    return "ERROR";
+  case NUMBER_OF_SEVERITIES:
+    break;
+  }
+  return "";
+}
+
+char const * getCategoryName(LogCategory category)
+{
+  switch (category)
+  {
+  case CATEGORY_GENERAL:
+    return "General";
+  case CATEGORY_CORE:
+    return "Core";
+  case CATEGORY_RENDERING:
+    return "Rendering";
+  case CATEGORY_PHYSICS:
+    return "Physics";
+  case CATEGORY_NETWORK:
+    return "Network";
+  case CATEGORY_ASSETS:
+    return "Assets";
+  case CATEGORY_INPUT:
+    return "Input";
+  case CATEGORY_GAME:
+    return "Game";
+  case NUMBER_OF_CATEGORIES:
+    break;
+  }
+  return "";
+}
+
+/********** Impl start ************/
+
+class Logger::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  /** Creates the buffer of the calling thread. */
+  ThreadBuffer * registerThread();
+
+  void setConsoleOutput(bool isEnabled);
+
+  bool openTextFile(std::string const & filename);
+
+  bool openBinaryFile(std::string const & filename);
+
+  void closeFiles();
+
+  void flush();
+
+  uint64_t getNumberOfDroppedMessages() const;
+
+private:
+  /** A collected message, sorted by time before it's written. */
+  struct Message
+  {
+    uint64_t timestamp;
+
+    uint32_t thread;
+
+    /** The offset of the record in the collected bytes. */
+    uint32_t offset;
+  };
+
+  /** The loop of the writer thread. */
+  void run();
+
+  /** Moves the messages of all ring buffers to the collected bytes. */
+  void collect();
+
+  /** Writes the collected messages and drops to all outputs. */
+  void write();
+
+  void writeBinaryMessage(BufferRecord const & record,
+                          uint8_t const * pArguments, uint32_t thread);
+
+  void writeBinaryDropped(uint64_t timestamp, uint32_t thread,
+                          uint64_t numberOfMessages);
+
+  /** The steady time of the timestamp zero. */
+  uint64_t const m_start;
+
+  /** Guards the list of buffers, taken when threads log the first time. */
+  std::mutex m_bufferMutex{};
+
+  std::vector<std::shared_ptr<ThreadBuffer>> m_buffers{};
+
+  uint32_t m_nextThread{0};
+
+  /** The buffers being collected, only used by the writer thread. */
+  std::vector<std::shared_ptr<ThreadBuffer>> m_collected{};
+
+  std::vector<uint8_t> m_bytes{};
+
+  std::vector<Message> m_messages{};
+
+  /** Drops per thread since the last write. */
+  std::vector<std::pair<uint32_t, uint64_t>> m_drops{};
+
+  std::atomic<uint64_t> m_numberOfDropped{0};
+
+  /** Guards the outputs and the state of the writer thread. */
+  std::mutex m_mutex{};
+
+  std::condition_variable m_condition{};
+
+  bool m_isConsoleOutput{true};
+
+  std::ofstream m_textFile{};
+
+  std::ofstream m_binaryFile{};
+
+  /** The ids of the format strings written to the binary file. */
+  std::unordered_map<char const *, uint32_t> m_formatIds{};
+
+  std::string m_text{};
+
+  std::vector<uint8_t> m_binary{};
+
+  uint64_t m_flushRequest{0};
+
+  uint64_t m_flushDone{0};
+
+  bool m_isStopping{false};
+
+  std::thread m_thread{};
+};
+
+Logger::Impl::Impl() : m_start(getSteadyTime())
+{
+  m_thread = std::thread(&Impl::run, this);
+}
+
+Logger::Impl::~Impl()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_condition.notify_all();
+  m_thread.join();
+}
+
+ThreadBuffer * Logger::Impl::registerThread()
+{
+  std::shared_ptr<ThreadBuffer> pBuffer = std::make_shared<ThreadBuffer>();
+  {
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    pBuffer->thread = m_nextThread++;
+    m_buffers.push_back(pBuffer);
+  }
+  threadBufferOwner.pBuffer = pBuffer;
+  pThreadBuffer = pBuffer.get();
+  return pThreadBuffer;
+}
+
+void Logger::Impl::setConsoleOutput(bool isEnabled)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_isConsoleOutput = isEnabled;
+}
+
+bool Logger::Impl::openTextFile(std::string const & filename)
+{
+  flush();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_textFile.close();
+  m_textFile.clear();
+  m_textFile.open(filename, std::ios::binary | std::ios::trunc);
+  return m_textFile.is_open();
+}
+
+bool Logger::Impl::openBinaryFile(std::string const & filename)
+{
+  flush();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_binaryFile.close();
+  m_binaryFile.clear();
+  m_formatIds.clear();
+  m_binaryFile.open(filename, std::ios::binary | std::ios::trunc);
+  if (!m_binaryFile.is_open())
+  {
+    return false;
+  }
+  // the system time that corresponds to the steady time m_start
+  uint64_t const systemTime = static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+  LogFormat::Header const header{LogFormat::MAGIC, LogFormat::VERSION,
+                                 systemTime - (getSteadyTime() - m_start)};
+  m_binaryFile.write(reinterpret_cast<char const *>(&header), sizeof(header));
+  m_binaryFile.flush();
+  return m_binaryFile.good();
+}
+
+void Logger::Impl::closeFiles()
+{
+  flush();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_textFile.close();
+  m_binaryFile.close();
+}
+
+void Logger::Impl::flush()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  uint64_t const request = ++m_flushRequest;
+  m_condition.notify_all();
+  m_condition.wait(lock, [this, request] { return m_flushDone >= request; });
+}
+
+uint64_t Logger::Impl::getNumberOfDroppedMessages() const
+{
+  return m_numberOfDropped.load(std::memory_order_relaxed);
+}
+
+void Logger::Impl::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    // messages logged before a flush request are collected after it
+    uint64_t const request = m_flushRequest;
+    bool const isStopping = m_isStopping;
+    collect();
+    write();
+    m_flushDone = request;
+    m_condition.notify_all();
+    if (isStopping)
+    {
+      break;
+    }
+    m_condition.wait_for(lock, WRITE_INTERVAL, [this, request] {
+      return m_flushRequest != request || m_isStopping;
+    });
+  }
+}
+
+void Logger::Impl::collect()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    m_collected = m_buffers;
+  }
+  m_bytes.clear();
+  m_messages.clear();
+  m_drops.clear();
+  bool hasAbandoned = false;
+  for (std::shared_ptr<ThreadBuffer> const & pBuffer : m_collected)
+  {
+    // a thread marks its buffer abandoned after its last message
+    bool const isAbandoned =
+        pBuffer->isAbandoned.load(std::memory_order_acquire);
+    uint64_t position = pBuffer->readPosition.load(std::memory_order_relaxed);
+    uint64_t const end =
+        pBuffer->writePosition.load(std::memory_order_acquire);
+    while (position != end)
+    {
+      uint8_t const * pRecord =
+          pBuffer->pData.get() + (position & (BUFFER_SIZE - 1));
+      BufferRecord record;
+      std::memcpy(&record, pRecord, PADDING_SIZE);
+      if (record.severity != PADDING)
+      {
+        std::memcpy(&record, pRecord, sizeof(record));
+        m_messages.push_back(Message{record.timestamp, pBuffer->thread,
+                                     static_cast<uint32_t>(m_bytes.size())});
+        m_bytes.insert(m_bytes.end(), pRecord, pRecord + record.size);
+      }
+      position += record.size;
+    }
+    pBuffer->readPosition.store(position, std::memory_order_release);
+
+    uint64_t const numberOfDropped =
+        pBuffer->numberOfDropped.exchange(0, std::memory_order_relaxed);
+    if (numberOfDropped != 0)
+    {
+      m_drops.emplace_back(pBuffer->thread, numberOfDropped);
+      m_numberOfDropped.fetch_add(numberOfDropped, std::memory_order_relaxed);
+    }
+    hasAbandoned = hasAbandoned || isAbandoned;
+  }
+
+  if (hasAbandoned)
+  {
+    std::lock_guard<std::mutex> lock(m_bufferMutex);
+    m_buffers.erase(std::remove_if(m_buffers.begin(), m_buffers.end(),
+                                   [](auto const & pBuffer) {
+                                     return pBuffer->isAbandoned.load(
+                                                std::memory_order_acquire) &&
+                                            pBuffer->readPosition.load(
+                                                std::memory_order_relaxed) ==
+                                                pBuffer->writePosition.load(
+                                                    std::memory_order_acquire);
+                                   }),
+                    m_buffers.end());
+  }
+  m_collected.clear();
+
+  // threads are collected one after the other, the output is ordered by time
+  std::stable_sort(m_messages.begin(), m_messages.end(),
+                   [](Message const & a, Message const & b) {
+                     return a.timestamp < b.timestamp;
+                   });
+}
+
+void Logger::Impl::write()
+{
+  if (m_messages.empty() && m_drops.empty())
+  {
+    return;
+  }
+  bool const isText = m_isConsoleOutput || m_textFile.is_open();
+  bool const isBinary = m_binaryFile.is_open();
+  uint64_t const now = getSteadyTime() - m_start;
+  m_text.clear();
+  m_binary.clear();
+  for (Message const & message : m_messages)
+  {
+    BufferRecord record;
+    std::memcpy(&record, m_bytes.data() + message.offset, sizeof(record));
+    uint8_t const * pArguments =
+        m_bytes.data() + message.offset + sizeof(record);
+    if (isText)
+    {
+      appendLinePrefix(m_text, record.timestamp - m_start, message.thread,
+                       record.severity, record.category);
+      appendMessage(m_text, record.format, std::strlen(record.format),
+                    pArguments, record.argumentSize);
+      m_text += '\n';
+    }
+    if (isBinary)
+    {
+      writeBinaryMessage(record, pArguments, message.thread);
+    }
+  }
+  for (auto const & drop : m_drops)
+  {
+    if (isText)
+    {
+      appendLinePrefix(m_text, now, drop.first, SEVERITY_WARNING,
+                       CATEGORY_CORE);
+      m_text += std::to_string(drop.second);
+      m_text += " messages were dropped\n";
+    }
+    if (isBinary)
+    {
+      writeBinaryDropped(now, drop.first, drop.second);
+    }
+  }
+
+  if (m_isConsoleOutput)
+  {
+    std::cout.write(m_text.data(), static_cast<std::streamsize>(m_text.size()));
+    std::cout.flush();
+  }
+  if (m_textFile.is_open())
+  {
+    m_textFile.write(m_text.data(), static_cast<std::streamsize>(m_text.size()));
+    m_textFile.flush();
+  }
+  if (isBinary)
+  {
+    m_binaryFile.write(reinterpret_cast<char const *>(m_binary.data()),
+                       static_cast<std::streamsize>(m_binary.size()));
+    m_binaryFile.flush();
+  }
+}
+
+void Logger::Impl::writeBinaryMessage(BufferRecord const & record,
+                                      uint8_t const * pArguments,
+                                      uint32_t thread)
+{
+  auto found = m_formatIds.find(record.format);
+  if (found == m_formatIds.end())
+  {
+    uint32_t const id = static_cast<uint32_t>(m_formatIds.size());
+    found = m_formatIds.emplace(record.format, id).first;
+    size_t const length = std::strlen(record.format);
+    appendBytes(m_binary,
+                LogFormat::RecordHeader{
+                    LogFormat::RECORD_FORMAT, 0, 0, 0,
+                    static_cast<uint32_t>(sizeof(id) + length)});
+    appendBytes(m_binary, id);
+    m_binary.insert(m_binary.end(), record.format, record.format + length);
+  }
+  appendBytes(m_binary, LogFormat::RecordHeader{
+                            LogFormat::RECORD_MESSAGE, record.severity,
+                            record.category, 0,
+                            static_cast<uint32_t>(
+                                sizeof(LogFormat::MessageHeader) +
+                                record.argumentSize)});
+  appendBytes(m_binary, LogFormat::MessageHeader{record.timestamp - m_start,
+                                                 thread, found->second});
+  m_binary.insert(m_binary.end(), pArguments,
+                  pArguments + record.argumentSize);
+}
+
+void Logger::Impl::writeBinaryDropped(uint64_t timestamp, uint32_t thread,
+                                      uint64_t numberOfMessages)
+{
+  appendBytes(m_binary,
+              LogFormat::RecordHeader{
+                  LogFormat::RECORD_DROPPED, SEVERITY_WARNING, CATEGORY_CORE,
+                  0, static_cast<uint32_t>(sizeof(LogFormat::DroppedRecord))});
+  appendBytes(m_binary,
+              LogFormat::DroppedRecord{timestamp, numberOfMessages, thread, 0});
+}
+
+/******************** Impl end *************************************/
+
+Logger & Logger::getInstance()
+{
+  static Logger instance;
+  return instance;
+}
+
+Logger::Logger() : m_impl(new Impl()) { updateCategoryMasks(); }
+
+Logger::~Logger() = default;
+
+void Logger::setMinimumSeverity(LogSeverity severity)
+{
+  m_minimumSeverity.store(severity, std::memory_order_relaxed);
+  updateCategoryMasks();
+}
+
+void Logger::setCategoryEnabled(LogCategory category, bool isEnabled)
+{
+  if (isEnabled)
+  {
+    m_enabledCategories.fetch_or(1u << category, std::memory_order_relaxed);
+  }
+  else
+  {
+    m_enabledCategories.fetch_and(~(1u << category),
+                                  std::memory_order_relaxed);
+  }
+  updateCategoryMasks();
+}
+
+void Logger::setConsoleOutput(bool isEnabled)
+{
+  m_impl->setConsoleOutput(isEnabled);
+}
+
+bool Logger::openTextFile(std::string const & filename)
+{
+  return m_impl->openTextFile(filename);
+}
+
+bool Logger::openBinaryFile(std::string const & filename)
+{
+  return m_impl->openBinaryFile(filename);
+}
+
+void Logger::closeFiles() { m_impl->closeFiles(); }
+
+void Logger::flush() { m_impl->flush(); }
+
+uint64_t Logger::getNumberOfDroppedMessages() const
+{
+  return m_impl->getNumberOfDroppedMessages();
+}
+
+uint8_t * Logger::beginMessage(LogSeverity severity, LogCategory category,
+                               char const * format, size_t argumentSize)
+{
+  ThreadBuffer * pBuffer = pThreadBuffer;
+  if (pBuffer == nullptr)
+  {
+    pBuffer = m_impl->registerThread();
+  }
+
+  // a message that doesn't fit before the end of the buffer starts at its
+  // beginning behind a padding record
+  uint64_t position = pBuffer->writePosition.load(std::memory_order_relaxed);
+  size_t const offset = static_cast<size_t>(position & (BUFFER_SIZE - 1));
+  size_t const gap = BUFFER_SIZE - offset;
+  size_t const size = (sizeof(BufferRecord) + argumentSize +
+                       RECORD_ALIGNMENT - 1) &
+                      ~(RECORD_ALIGNMENT - 1);
+  size_t const needed = size <= gap ? size : gap + size;
+  if (argumentSize > UINT16_MAX ||
+      position + needed - pBuffer->cachedReadPosition > BUFFER_SIZE)
+  {
+    pBuffer->cachedReadPosition =
+        pBuffer->readPosition.load(std::memory_order_acquire);
+    if (argumentSize > UINT16_MAX ||
+        position + needed - pBuffer->cachedReadPosition > BUFFER_SIZE)
+    {
+      pBuffer->numberOfDropped.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+  }
+
+  uint8_t * pRecord = pBuffer->pData.get() + offset;
+  if (size > gap)
+  {
+    BufferRecord const padding{static_cast<uint32_t>(gap), 0, PADDING, 0, 0,
+                               nullptr};
+    std::memcpy(pRecord, &padding, PADDING_SIZE);
+    position += gap;
+    pRecord = pBuffer->pData.get();
+  }
+  BufferRecord const record{static_cast<uint32_t>(size),
+                            static_cast<uint16_t>(argumentSize),
+                            static_cast<uint8_t>(severity),
+                            static_cast<uint8_t>(category), getSteadyTime(),
+                            format};
+  std::memcpy(pRecord, &record, sizeof(record));
+  pBuffer->pendingPosition = position + size;
+  return pRecord + sizeof(record);
+}
+
+void Logger::endMessage()
+{
+  pThreadBuffer->writePosition.store(pThreadBuffer->pendingPosition,
+                                     std::memory_order_release);
+}
+
+void Logger::updateCategoryMasks()
+{
+  LogSeverity const minimumSeverity =
+      m_minimumSeverity.load(std::memory_order_relaxed);
+  uint32_t const enabledCategories =
+      m_enabledCategories.load(std::memory_order_relaxed);
+  for (size_t s = 0; s < NUMBER_OF_SEVERITIES; ++s)
+  {
+    m_categoryMasks[s].store(s >= static_cast<size_t>(minimumSeverity)
+                                 ? enabledCategories
+                                 : 0,
+                             std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,154 @@
+#include "Core/MemoryStats.h"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <ostream>
+#ifdef __GNUG__
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
+namespace
+{
+
+char const * getTypeName(MemoryCategoryType type)
+{
+  switch (type)
+  {
+  case MEMORY_SUBSYSTEM:
+    return "Subsystems";
+  case MEMORY_OBJECT_TYPE:
+    return "Object types";
+  case MEMORY_COMPONENT_TYPE:
+    return "Component types";
+  }
+  return "";
+}
+
+/** Returns the readable name of the type, GCC and Clang mangle it. */
+std::string getReadableName(std::type_info const & type)
+{
+#ifdef __GNUG__
+  int status = 0;
+  std::unique_ptr<char, void (*)(void *)> pName(
+      abi::__cxa_demangle(type.name(), nullptr, nullptr, &status), std::free);
+  if (status == 0 && pName)
+    return pName.get();
+#endif
+  return type.name();
+}
+
+} // namespace
+
+MemorySnapshot MemorySnapshot::diff(MemorySnapshot const & earlier,
+                                    MemorySnapshot const & later)
+{
+  MemorySnapshot result;
+  for (Entry const & entry : later.entries)
+  {
+    auto iter = std::find_if(
+        earlier.entries.begin(), earlier.entries.end(), [&](Entry const & e) {
+          return e.type == entry.type && e.name == entry.name;
+        });
+    Entry delta = entry;
+    if (iter != earlier.entries.end())
+    {
+      delta.counters.liveCount -= iter->counters.liveCount;
+      delta.counters.liveBytes -= iter->counters.liveBytes;
+      delta.counters.peakBytes -= iter->counters.peakBytes;
+      delta.counters.totalAllocations -= iter->counters.totalAllocations;
+    }
+    if (delta.counters.liveCount != 0 || delta.counters.liveBytes != 0 ||
+        delta.counters.peakBytes != 0 || delta.counters.totalAllocations != 0)
+    {
+      result.entries.push_back(delta);
+    }
+  }
+  return result;
+}
+
+void MemorySnapshot::dump(std::ostream & stream) const
+{
+  std::vector<Entry> sorted = entries;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](Entry const & a, Entry const & b) {
+                     if (a.type != b.type)
+                       return a.type < b.type;
+                     return a.counters.liveBytes > b.counters.liveBytes;
+                   });
+  for (size_t i = 0; i < sorted.size(); ++i)
+  {
+    Entry const & entry = sorted[i];
+    if (i == 0 || sorted[i - 1].type != entry.type)
+    {
+      stream << getTypeName(entry.type) << '\n'
+             << std::setw(40) << std::left << "  name" << std::right
+             << std::setw(12) << "count" << std::setw(16) << "bytes"
+             << std::setw(16) << "peak" << std::setw(12) << "allocs" << '\n';
+    }
+    stream << "  " << std::setw(38) << std::left << entry.name << std::right
+           << std::setw(12) << entry.counters.liveCount << std::setw(16)
+           << entry.counters.liveBytes << std::setw(16)
+           << entry.counters.peakBytes << std::setw(12)
+           << entry.counters.totalAllocations << '\n';
+  }
+}
+
+MemoryStats & MemoryStats::getInstance()
+{
+  static MemoryStats instance;
+  return instance;
+}
+
+MemoryStats::MemoryStats() = default;
+
+MemoryCategory & MemoryStats::getSubsystem(std::string const & name)
+{
+  return getCategory(name, MEMORY_SUBSYSTEM);
+}
+
+MemoryCategory & MemoryStats::getObjectType(std::string const & name)
+{
+  return getCategory(name, MEMORY_OBJECT_TYPE);
+}
+
+MemoryCategory & MemoryStats::getComponentType(std::type_info const & type)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto iter = m_componentTypes.find(std::type_index(type));
+  if (iter != m_componentTypes.end())
+    return *iter->second;
+  m_categories.emplace_back(getReadableName(type), MEMORY_COMPONENT_TYPE);
+  m_componentTypes.emplace(std::type_index(type), &m_categories.back());
+  return m_categories.back();
+}
+
+MemorySnapshot MemoryStats::takeSnapshot() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  MemorySnapshot snapshot;
+  snapshot.entries.reserve(m_categories.size());
+  for (MemoryCategory const & category : m_categories)
+  {
+    MemorySnapshot::Entry entry;
+    entry.name = category.getName();
+    entry.type = category.getType();
+    entry.counters = category.getCounters();
+    snapshot.entries.push_back(entry);
+  }
+  return snapshot;
+}
+
+MemoryCategory & MemoryStats::getCategory(std::string const & name,
+                                          MemoryCategoryType type)
+{
+  // subsystems and object types share the map, the type is part of the key
+  std::string const key = std::to_string(type) + name;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto iter = m_namedCategories.find(key);
+  if (iter != m_namedCategories.end())
+    return *iter->second;
+  m_categories.emplace_back(name, type);
+  m_namedCategories.emplace(key, &m_categories.back());
+  return m_categories.back();
+}
@@ -0,0 +1,223 @@
+#include "Core/ParticleEmitter.h"
+#include "Core/JobSystem.h"
+#include "Core/MemoryStats.h"
+#include "ParticleKernels.h"
+#include <algorithm>
+#include <new>
+
+namespace
+{
+
+/** The number of arrays per particle. */
+size_t const NUMBER_OF_ARRAYS = 5;
+
+std::align_val_t const ARRAY_ALIGNMENT{32};
+
+MemoryCategory & getParticleMemory()
+{
+  static MemoryCategory & category =
+      MemoryStats::getInstance().getSubsystem("Particles");
+  return category;
+}
+
+/** Returns the next number of a xorshift generator in [0, 1). */
+float nextRandom(uint32_t & state)
+{
+  state ^= state << 13;
+  state ^= state >> 17;
+  state ^= state << 5;
+  return static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+}
+
+} // namespace
+
+ParticleEmitter::ParticleEmitter() { allocate(); }
+
+ParticleEmitter::~ParticleEmitter()
+{
+  if (m_memory != nullptr)
+  {
+    ::operator delete(m_memory, ARRAY_ALIGNMENT);
+    getParticleMemory().recordDeallocation(m_allocatedBytes);
+  }
+}
+
+void ParticleEmitter::update(double deltaTime)
+{
+  if (deltaTime <= 0.0)
+    return;
+
+  m_spawnRemainder += deltaTime * m_settings.rate;
+  size_t const numberOfSpawned = static_cast<size_t>(m_spawnRemainder);
+  m_spawnRemainder -= static_cast<double>(numberOfSpawned);
+  spawn(numberOfSpawned);
+  if (m_numberOfParticles == 0)
+    return;
+
+  ParticleArrays const particles{m_positionX, m_positionY, m_velocityX,
+                                 m_velocityY, m_life};
+  ParticleStep step;
+  step.deltaTime = static_cast<float>(deltaTime);
+  step.accelerationX = m_settings.accelerationX;
+  step.accelerationY = m_settings.accelerationY;
+  step.damping = std::max(0.0f, 1.0f - m_settings.drag * step.deltaTime);
+  ParticleKernel const kernel =
+      isVectorized() ? integrateParticlesAvx2 : integrateParticlesScalar;
+
+  // chunks start at whole vectors
+  m_chunkSize = m_grainSize == 0 ? m_numberOfParticles : m_grainSize;
+  m_chunkSize =
+      (m_chunkSize + PARTICLE_LANES - 1) / PARTICLE_LANES * PARTICLE_LANES;
+  size_t const numberOfChunks =
+      (m_numberOfParticles + m_chunkSize - 1) / m_chunkSize;
+  m_deadPerChunk.assign(numberOfChunks, 0);
+  auto const integrate = [&](size_t begin, size_t end)
+  {
+    m_deadPerChunk[begin / m_chunkSize] =
+        kernel(particles, begin, end, step, m_dead.data() + begin);
+  };
+  if (numberOfChunks > 1)
+  {
+    JobSystem::getInstance().parallelFor(m_numberOfParticles, m_chunkSize,
+                                         integrate);
+  }
+  else
+  {
+    integrate(0, m_numberOfParticles);
+  }
+  compact();
+}
+
+Component * ParticleEmitter::clone() const
+{
+  ParticleEmitter * pCopy = new ParticleEmitter();
+  pCopy->setSettings(m_settings);
+  pCopy->m_grainSize = m_grainSize;
+  pCopy->m_isVectorized = m_isVectorized;
+  return pCopy;
+}
+
+void ParticleEmitter::setSettings(ParticleEmitterSettings const & settings)
+{
+  bool const isResized = settings.capacity != m_settings.capacity;
+  m_settings = settings;
+  if (isResized)
+  {
+    allocate();
+  }
+}
+
+ParticleEmitterSettings const & ParticleEmitter::getSettings() const
+{
+  return m_settings;
+}
+
+void ParticleEmitter::emit(size_t count) { spawn(count); }
+
+void ParticleEmitter::clear()
+{
+  m_numberOfParticles = 0;
+  m_spawnRemainder = 0.0;
+}
+
+size_t ParticleEmitter::getNumberOfParticles() const
+{
+  return m_numberOfParticles;
+}
+
+size_t ParticleEmitter::getCapacity() const { return m_settings.capacity; }
+
+void ParticleEmitter::setParallelGrainSize(size_t grainSize)
+{
+  m_grainSize = grainSize;
+}
+
+size_t ParticleEmitter::getParallelGrainSize() const { return m_grainSize; }
+
+void ParticleEmitter::setVectorized(bool isVectorized)
+{
+  m_isVectorized = isVectorized;
+}
+
+bool ParticleEmitter::isVectorized() const
+{
+  return m_isVectorized && hasAvx2ParticleKernel();
+}
+
+float const * ParticleEmitter::getPositionsX() const { return m_positionX; }
+
+float const * ParticleEmitter::getPositionsY() const { return m_positionY; }
+
+float const * ParticleEmitter::getVelocitiesX() const { return m_velocityX; }
+
+float const * ParticleEmitter::getVelocitiesY() const { return m_velocityY; }
+
+float const * ParticleEmitter::getLives() const { return m_life; }
+
+void ParticleEmitter::allocate()
+{
+  if (m_memory != nullptr)
+  {
+    ::operator delete(m_memory, ARRAY_ALIGNMENT);
+    getParticleMemory().recordDeallocation(m_allocatedBytes);
+  }
+
+  // whole vectors per array keep every array aligned
+  size_t const stride = (m_settings.capacity + PARTICLE_LANES - 1) /
+                        PARTICLE_LANES * PARTICLE_LANES;
+  m_allocatedBytes = std::max<size_t>(stride, PARTICLE_LANES) *
+                     NUMBER_OF_ARRAYS * sizeof(float);
+  m_memory =
+      static_cast<float *>(::operator new(m_allocatedBytes, ARRAY_ALIGNMENT));
+  std::fill(m_memory, m_memory + m_allocatedBytes / sizeof(float), 0.0f);
+  getParticleMemory().recordAllocation(m_allocatedBytes);
+  m_positionX = m_memory;
+  m_positionY = m_positionX + stride;
+  m_velocityX = m_positionY + stride;
+  m_velocityY = m_velocityX + stride;
+  m_life = m_velocityY + stride;
+  m_dead.assign(stride, 0);
+  m_numberOfParticles = 0;
+}
+
+void ParticleEmitter::spawn(size_t count)
+{
+  count = std::min(count, m_settings.capacity - m_numberOfParticles);
+  ParticleEmitterSettings const & s = m_settings;
+  for (size_t i = m_numberOfParticles; i < m_numberOfParticles + count; ++i)
+  {
+    float const offsetX = (2.0f * nextRandom(m_random) - 1.0f) * s.spread;
+    float const offsetY = (2.0f * nextRandom(m_random) - 1.0f) * s.spread;
+    m_positionX[i] = s.positionX + offsetX;
+    m_positionY[i] = s.positionY + offsetY;
+    m_velocityX[i] = s.velocityX + (2.0f * nextRandom(m_random) - 1.0f) *
+                                       s.velocityVariance;
+    m_velocityY[i] = s.velocityY + (2.0f * nextRandom(m_random) - 1.0f) *
+                                       s.velocityVariance;
+    m_life[i] = s.minimumLifetime +
+                nextRandom(m_random) * (s.maximumLifetime - s.minimumLifetime);
+  }
+  m_numberOfParticles += count;
+}
+
+void ParticleEmitter::compact()
+{
+  // back to front, so the particle moved into a gap is always alive
+  for (size_t chunk = m_deadPerChunk.size(); chunk-- > 0;)
+  {
+    uint32_t const * pDead = m_dead.data() + chunk * m_chunkSize;
+    for (size_t i = m_deadPerChunk[chunk]; i-- > 0;)
+    {
+      size_t const index = pDead[i];
+      size_t const last = --m_numberOfParticles;
+      if (index != last)
+      {
+        m_positionX[index] = m_positionX[last];
+        m_positionY[index] = m_positionY[last];
+        m_velocityX[index] = m_velocityX[last];
+        m_velocityY[index] = m_velocityY[last];
+        m_life[index] = m_life[last];
+      }
+    }
+  }
+}
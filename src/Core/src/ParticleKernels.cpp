@@ -0,0 +1,27 @@
+#include "ParticleKernels.h"
+
+size_t integrateParticlesScalar(ParticleArrays const & particles, size_t begin,
+                                size_t end, ParticleStep const & step,
+                                uint32_t * pDead)
+{
+  size_t numberOfDead = 0;
+  for (size_t i = begin; i < end; ++i)
+  {
+    float const velocityX =
+        (particles.velocityX[i] + step.accelerationX * step.deltaTime) *
+        step.damping;
+    float const velocityY =
+        (particles.velocityY[i] + step.accelerationY * step.deltaTime) *
+        step.damping;
+    particles.velocityX[i] = velocityX;
+    particles.velocityY[i] = velocityY;
+    particles.positionX[i] += velocityX * step.deltaTime;
+    particles.positionY[i] += velocityY * step.deltaTime;
+    particles.life[i] -= step.deltaTime;
+    if (particles.life[i] <= 0.0f)
+    {
+      pDead[numberOfDead++] = static_cast<uint32_t>(i);
+    }
+  }
+  return numberOfDead;
+}
@@ -0,0 +1,110 @@
+#include "ParticleKernels.h"
+
+// The file is compiled with AVX2 and FMA enabled on x86, see CMakeLists.txt.
+// Nothing in here may run before hasAvx2ParticleKernel returned true.
+#if defined(__AVX2__)
+
+#include <immintrin.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+
+bool isAvx2Supported()
+{
+#if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 1);
+  bool const hasFma = (info[2] & (1 << 12)) != 0;
+  bool const hasAvx = (info[2] & (1 << 28)) != 0;
+  bool const hasXsave = (info[2] & (1 << 27)) != 0;
+  if (!hasFma || !hasAvx || !hasXsave || (_xgetbv(0) & 6) != 6)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#else
+  return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+} // namespace
+
+size_t integrateParticlesAvx2(ParticleArrays const & particles, size_t begin,
+                              size_t end, ParticleStep const & step,
+                              uint32_t * pDead)
+{
+  __m256 const deltaTime = _mm256_set1_ps(step.deltaTime);
+  __m256 const deltaVelocityX =
+      _mm256_set1_ps(step.accelerationX * step.deltaTime);
+  __m256 const deltaVelocityY =
+      _mm256_set1_ps(step.accelerationY * step.deltaTime);
+  __m256 const damping = _mm256_set1_ps(step.damping);
+  __m256 const zero = _mm256_setzero_ps();
+
+  size_t numberOfDead = 0;
+  for (size_t i = begin; i < end; i += PARTICLE_LANES)
+  {
+    __m256 velocityX = _mm256_load_ps(particles.velocityX + i);
+    __m256 velocityY = _mm256_load_ps(particles.velocityY + i);
+    velocityX = _mm256_mul_ps(_mm256_add_ps(velocityX, deltaVelocityX), damping);
+    velocityY = _mm256_mul_ps(_mm256_add_ps(velocityY, deltaVelocityY), damping);
+    _mm256_store_ps(particles.velocityX + i, velocityX);
+    _mm256_store_ps(particles.velocityY + i, velocityY);
+
+    __m256 const positionX = _mm256_fmadd_ps(
+        velocityX, deltaTime, _mm256_load_ps(particles.positionX + i));
+    __m256 const positionY = _mm256_fmadd_ps(
+        velocityY, deltaTime, _mm256_load_ps(particles.positionY + i));
+    _mm256_store_ps(particles.positionX + i, positionX);
+    _mm256_store_ps(particles.positionY + i, positionY);
+
+    __m256 const life =
+        _mm256_sub_ps(_mm256_load_ps(particles.life + i), deltaTime);
+    _mm256_store_ps(particles.life + i, life);
+
+    unsigned int dead = static_cast<unsigned int>(
+        _mm256_movemask_ps(_mm256_cmp_ps(life, zero, _CMP_LE_OQ)));
+    if (dead != 0)
+    {
+      // the padding behind the range doesn't count
+      if (end - i < PARTICLE_LANES)
+      {
+        dead &= (1u << (end - i)) - 1u;
+      }
+      while (dead != 0)
+      {
+#if defined(_MSC_VER)
+        unsigned long lane;
+        _BitScanForward(&lane, dead);
+#else
+        unsigned int const lane = static_cast<unsigned int>(__builtin_ctz(dead));
+#endif
+        pDead[numberOfDead++] = static_cast<uint32_t>(i + lane);
+        dead &= dead - 1u;
+      }
+    }
+  }
+  return numberOfDead;
+}
+
+bool hasAvx2ParticleKernel()
+{
+  static bool const isSupported = isAvx2Supported();
+  return isSupported;
+}
+
+#else
+
+size_t integrateParticlesAvx2(ParticleArrays const & particles, size_t begin,
+                              size_t end, ParticleStep const & step,
+                              uint32_t * pDead)
+{
+  return integrateParticlesScalar(particles, begin, end, step, pDead);
+}
+
+bool hasAvx2ParticleKernel() { return false; }
+
+#endif
@@ -0,0 +1,309 @@
+#include "PhysicsCollision.h"
+#include <cmath>
+#include <utility>
+
+namespace
+{
+
+/** The edges of a box, counter clockwise starting at the right side. */
+enum BoxEdge
+{
+  NO_EDGE = 0,
+  EDGE_1 = 1,
+  EDGE_2 = 2,
+  EDGE_3 = 3,
+  EDGE_4 = 4
+};
+
+enum SeparatingAxis
+{
+  FACE_A_X = 0,
+  FACE_A_Y = 1,
+  FACE_B_X = 2,
+  FACE_B_Y = 3
+};
+
+/** The edges a clipped vertex of box box contacts lies on. */
+struct FeaturePair
+{
+  uint8_t inEdge1;
+  uint8_t outEdge1;
+  uint8_t inEdge2;
+  uint8_t outEdge2;
+};
+
+struct ClipVertex
+{
+  Vector2 position;
+  FeaturePair feature;
+};
+
+uint32_t toFeature(FeaturePair const & pair)
+{
+  return static_cast<uint32_t>(pair.inEdge1) |
+         static_cast<uint32_t>(pair.outEdge1) << 8 |
+         static_cast<uint32_t>(pair.inEdge2) << 16 |
+         static_cast<uint32_t>(pair.outEdge2) << 24;
+}
+
+void flip(FeaturePair & pair)
+{
+  std::swap(pair.inEdge1, pair.inEdge2);
+  std::swap(pair.outEdge1, pair.outEdge2);
+}
+
+/** Clips the segment to the half plane normal * x <= offset. */
+uint32_t clipSegmentToLine(ClipVertex * pOut, ClipVertex const * pIn,
+                           Vector2 const & normal, float offset,
+                           uint8_t clipEdge)
+{
+  uint32_t numberOfPoints = 0;
+  float const distance0 = normal.dot(pIn[0].position) - offset;
+  float const distance1 = normal.dot(pIn[1].position) - offset;
+  if (distance0 <= 0.0f)
+  {
+    pOut[numberOfPoints++] = pIn[0];
+  }
+  if (distance1 <= 0.0f)
+  {
+    pOut[numberOfPoints++] = pIn[1];
+  }
+  if (distance0 * distance1 < 0.0f)
+  {
+    float const interpolation = distance0 / (distance0 - distance1);
+    ClipVertex & vertex = pOut[numberOfPoints++];
+    vertex.position =
+        pIn[0].position + interpolation * (pIn[1].position - pIn[0].position);
+    if (distance0 > 0.0f)
+    {
+      vertex.feature = pIn[0].feature;
+      vertex.feature.inEdge1 = clipEdge;
+      vertex.feature.inEdge2 = NO_EDGE;
+    }
+    else
+    {
+      vertex.feature = pIn[1].feature;
+      vertex.feature.outEdge1 = clipEdge;
+      vertex.feature.outEdge2 = NO_EDGE;
+    }
+  }
+  return numberOfPoints;
+}
+
+/** Finds the edge of the box that is most anti parallel to the normal. */
+void computeIncidentEdge(ClipVertex * pEdge, CollisionShape const & box,
+                         Vector2 const & normal)
+{
+  Vector2 const & h = box.halfExtents;
+  Vector2 const n = -(box.rotation.transpose() * normal);
+  Vector2 const nAbs = n.cwiseAbs();
+  auto const set = [pEdge](int index, float x, float y, uint8_t in,
+                           uint8_t out)
+  {
+    pEdge[index].position = Vector2(x, y);
+    pEdge[index].feature = FeaturePair{NO_EDGE, NO_EDGE, in, out};
+  };
+  if (nAbs.x() > nAbs.y())
+  {
+    if (n.x() > 0.0f)
+    {
+      set(0, h.x(), -h.y(), EDGE_3, EDGE_4);
+      set(1, h.x(), h.y(), EDGE_4, EDGE_1);
+    }
+    else
+    {
+      set(0, -h.x(), h.y(), EDGE_1, EDGE_2);
+      set(1, -h.x(), -h.y(), EDGE_2, EDGE_3);
+    }
+  }
+  else
+  {
+    if (n.y() > 0.0f)
+    {
+      set(0, h.x(), h.y(), EDGE_4, EDGE_1);
+      set(1, -h.x(), h.y(), EDGE_1, EDGE_2);
+    }
+    else
+    {
+      set(0, -h.x(), -h.y(), EDGE_2, EDGE_3);
+      set(1, h.x(), -h.y(), EDGE_3, EDGE_4);
+    }
+  }
+  pEdge[0].position = box.position + box.rotation * pEdge[0].position;
+  pEdge[1].position = box.position + box.rotation * pEdge[1].position;
+}
+
+uint32_t collideBoxes(CollisionShape const & a, CollisionShape const & b,
+                      Vector2 & normal, ContactPoint * pPoints)
+{
+  Vector2 const & hA = a.halfExtents;
+  Vector2 const & hB = b.halfExtents;
+  Vector2 const dp = b.position - a.position;
+  Vector2 const dA = a.rotation.transpose() * dp;
+  Vector2 const dB = b.rotation.transpose() * dp;
+  Matrix2 const c = a.rotation.transpose() * b.rotation;
+  Matrix2 const absC = c.cwiseAbs();
+
+  Vector2 const faceA = dA.cwiseAbs() - hA - absC * hB;
+  if (faceA.x() > 0.0f || faceA.y() > 0.0f)
+    return 0;
+  Vector2 const faceB = dB.cwiseAbs() - absC.transpose() * hA - hB;
+  if (faceB.x() > 0.0f || faceB.y() > 0.0f)
+    return 0;
+
+  // prefer the faces of a for stable contacts in stacks
+  float const relativeTolerance = 0.95f;
+  float const absoluteTolerance = 0.01f;
+  SeparatingAxis axis = FACE_A_X;
+  float separation = faceA.x();
+  normal = dA.x() > 0.0f ? Vector2(a.rotation.col(0))
+                         : Vector2(-a.rotation.col(0));
+  if (faceA.y() > relativeTolerance * separation + absoluteTolerance * hA.y())
+  {
+    axis = FACE_A_Y;
+    separation = faceA.y();
+    normal = dA.y() > 0.0f ? Vector2(a.rotation.col(1))
+                           : Vector2(-a.rotation.col(1));
+  }
+  if (faceB.x() > relativeTolerance * separation + absoluteTolerance * hB.x())
+  {
+    axis = FACE_B_X;
+    separation = faceB.x();
+    normal = dB.x() > 0.0f ? Vector2(b.rotation.col(0))
+                           : Vector2(-b.rotation.col(0));
+  }
+  if (faceB.y() > relativeTolerance * separation + absoluteTolerance * hB.y())
+  {
+    axis = FACE_B_Y;
+    separation = faceB.y();
+    normal = dB.y() > 0.0f ? Vector2(b.rotation.col(1))
+                           : Vector2(-b.rotation.col(1));
+  }
+
+  // the reference face and its side planes
+  CollisionShape const & reference = axis <= FACE_A_Y ? a : b;
+  CollisionShape const & incident = axis <= FACE_A_Y ? b : a;
+  Vector2 const frontNormal = axis <= FACE_A_Y ? normal : Vector2(-normal);
+  bool const isX = axis == FACE_A_X || axis == FACE_B_X;
+  Vector2 const & h = reference.halfExtents;
+  float const front =
+      reference.position.dot(frontNormal) + (isX ? h.x() : h.y());
+  Vector2 const sideNormal =
+      isX ? Vector2(reference.rotation.col(1)) : Vector2(reference.rotation.col(0));
+  float const side = reference.position.dot(sideNormal);
+  float const negativeSide = -side + (isX ? h.y() : h.x());
+  float const positiveSide = side + (isX ? h.y() : h.x());
+  uint8_t const negativeEdge = isX ? EDGE_3 : EDGE_2;
+  uint8_t const positiveEdge = isX ? EDGE_1 : EDGE_4;
+
+  ClipVertex incidentEdge[2];
+  computeIncidentEdge(incidentEdge, incident, frontNormal);
+  ClipVertex clipPoints1[2];
+  ClipVertex clipPoints2[2];
+  if (clipSegmentToLine(clipPoints1, incidentEdge, -sideNormal, negativeSide,
+                        negativeEdge) < 2)
+    return 0;
+  if (clipSegmentToLine(clipPoints2, clipPoints1, sideNormal, positiveSide,
+                        positiveEdge) < 2)
+    return 0;
+
+  uint32_t numberOfPoints = 0;
+  for (ClipVertex & vertex : clipPoints2)
+  {
+    float const distance = frontNormal.dot(vertex.position) - front;
+    if (distance <= 0.0f)
+    {
+      if (axis > FACE_A_Y)
+      {
+        flip(vertex.feature);
+      }
+      ContactPoint & point = pPoints[numberOfPoints++];
+      point.separation = distance;
+      point.position = vertex.position - distance * frontNormal;
+      point.feature = toFeature(vertex.feature);
+    }
+  }
+  return numberOfPoints;
+}
+
+uint32_t collideCircles(CollisionShape const & a, CollisionShape const & b,
+                        Vector2 & normal, ContactPoint * pPoints)
+{
+  Vector2 const d = b.position - a.position;
+  float const radii = a.halfExtents.x() + b.halfExtents.x();
+  float const distanceSquared = d.squaredNorm();
+  if (distanceSquared > radii * radii)
+    return 0;
+  float const distance = std::sqrt(distanceSquared);
+  normal = distance > 1e-6f ? Vector2(d / distance) : Vector2(0.0f, 1.0f);
+  pPoints[0].separation = distance - radii;
+  pPoints[0].position = a.position + a.halfExtents.x() * normal;
+  pPoints[0].feature = 0;
+  return 1;
+}
+
+uint32_t collideBoxCircle(CollisionShape const & box,
+                          CollisionShape const & circle, Vector2 & normal,
+                          ContactPoint * pPoints)
+{
+  Vector2 const & h = box.halfExtents;
+  float const radius = circle.halfExtents.x();
+  Vector2 const center =
+      box.rotation.transpose() * (circle.position - box.position);
+  Vector2 const closest(std::fmin(std::fmax(center.x(), -h.x()), h.x()),
+                        std::fmin(std::fmax(center.y(), -h.y()), h.y()));
+  Vector2 localNormal;
+  float separation = 0.0f;
+  Vector2 surface = closest;
+  if (closest == center)
+  {
+    // the center is inside, push it out through the nearest face
+    Vector2 const depth = h - center.cwiseAbs();
+    if (depth.x() < depth.y())
+    {
+      localNormal = Vector2(center.x() >= 0.0f ? 1.0f : -1.0f, 0.0f);
+      surface.x() = localNormal.x() * h.x();
+      separation = -depth.x() - radius;
+    }
+    else
+    {
+      localNormal = Vector2(0.0f, center.y() >= 0.0f ? 1.0f : -1.0f);
+      surface.y() = localNormal.y() * h.y();
+      separation = -depth.y() - radius;
+    }
+  }
+  else
+  {
+    Vector2 const d = center - closest;
+    float const distance = d.norm();
+    if (distance > radius)
+      return 0;
+    localNormal = d / distance;
+    separation = distance - radius;
+  }
+  normal = box.rotation * localNormal;
+  pPoints[0].separation = separation;
+  pPoints[0].position = box.position + box.rotation * surface;
+  pPoints[0].feature = 0;
+  return 1;
+}
+
+} // namespace
+
+uint32_t collide(CollisionShape const & a, CollisionShape const & b,
+                 Vector2 & normal, ContactPoint * pPoints)
+{
+  if (a.type == SHAPE_BOX && b.type == SHAPE_BOX)
+    return collideBoxes(a, b, normal, pPoints);
+  if (a.type == SHAPE_CIRCLE && b.type == SHAPE_CIRCLE)
+    return collideCircles(a, b, normal, pPoints);
+  if (a.type == SHAPE_BOX && b.type == SHAPE_CIRCLE)
+    return collideBoxCircle(a, b, normal, pPoints);
+  if (a.type == SHAPE_CIRCLE && b.type == SHAPE_BOX)
+  {
+    uint32_t const numberOfPoints = collideBoxCircle(b, a, normal, pPoints);
+    normal = -normal;
+    return numberOfPoints;
+  }
+  return 0;
+}
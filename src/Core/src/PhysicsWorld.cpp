@@ -0,0 +1,1007 @@
+#include "Core/PhysicsWorld.h"
+#include "Core/Component.h"
+#include "Core/JobSystem.h"
+#include "PhysicsCollision.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** The fraction of the overlap that is resolved per step. */
+float const BIAS_FACTOR = 0.2f;
+
+/** The overlap that is tolerated to keep resting contacts stable. */
+float const ALLOWED_PENETRATION = 0.01f;
+
+/** Slower impacts don't bounce, so resting bodies come to rest. */
+float const RESTITUTION_THRESHOLD = 1.0f;
+
+/** Pairs per narrowphase job. */
+size_t const NARROWPHASE_GRAIN = 256;
+
+uint32_t const NO_ISLAND = 0xffffffffu;
+
+struct BodyMass
+{
+  float inverseMass;
+  float inverseInertia;
+};
+
+/** The bounding box of a body and the grid cells it covers. */
+struct Bounds
+{
+  float minimumX;
+  float minimumY;
+  float maximumX;
+  float maximumY;
+  int32_t firstCellX;
+  int32_t firstCellY;
+  int32_t lastCellX;
+  int32_t lastCellY;
+};
+
+struct CellEntry
+{
+  uint64_t cell;
+  uint32_t body;
+
+  /** The bucket of the cell in the hash grid. */
+  uint32_t bucket;
+};
+
+struct BodyPair
+{
+  uint32_t bodyA;
+  uint32_t bodyB;
+};
+
+/** The impulses of a manifold kept for warm starting the next step. */
+struct CachedManifold
+{
+  uint64_t key;
+  uint32_t numberOfPoints;
+  uint32_t features[2];
+  float normalImpulses[2];
+  float tangentImpulses[2];
+};
+
+uint64_t getCellKey(int32_t x, int32_t y)
+{
+  return static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32 |
+         static_cast<uint32_t>(y);
+}
+
+/** Spreads the cell keys over the buckets of a table of 2^bits entries. */
+uint32_t getBucket(uint64_t cell, uint32_t bits)
+{
+  return static_cast<uint32_t>((cell * 0x9e3779b97f4a7c15ull) >> (64 - bits));
+}
+
+uint64_t getPairKey(uint32_t bodyA, uint32_t bodyB)
+{
+  return static_cast<uint64_t>(bodyA) << 32 | bodyB;
+}
+
+/** The cross product of two vectors. */
+float cross(Vector2 const & a, Vector2 const & b)
+{
+  return a.x() * b.y() - a.y() * b.x();
+}
+
+/** The cross product of an angular velocity and a vector. */
+Vector2 cross(float w, Vector2 const & r) { return Vector2(-w * r.y(), w * r.x()); }
+
+Matrix2 getRotation(float angle)
+{
+  float const c = std::cos(angle);
+  float const s = std::sin(angle);
+  Matrix2 rotation;
+  rotation << c, -s, s, c;
+  return rotation;
+}
+
+} // namespace
+
+/********** Impl start ************/
+
+class PhysicsWorld::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  uint32_t createBody(Component * pOwner);
+
+  void destroyBody(uint32_t slot);
+
+  void setDefinition(uint32_t slot, BodyDefinition const & definition);
+
+  BodyDefinition const & getDefinition(uint32_t slot) const;
+
+  BodyMotion & editMotion(uint32_t slot);
+
+  BodyMotion const & getMotion(uint32_t slot) const;
+
+  BodyMotion getInterpolatedMotion(uint32_t slot) const;
+
+  void setEnabled(uint32_t slot, bool isEnabled);
+
+  bool isEnabled(uint32_t slot) const;
+
+  void teleport(uint32_t slot);
+
+  void applyImpulse(uint32_t slot, Vector2 const & impulse);
+
+  void update(double deltaTime);
+
+  void step();
+
+  void setTimeStep(double seconds);
+
+  double getTimeStep() const;
+
+  void setMaximumSteps(size_t maximumSteps);
+
+  void setIterations(size_t iterations);
+
+  void setGravity(Vector2 const & gravity);
+
+  Vector2 getGravity() const;
+
+  size_t getNumberOfSlots() const;
+
+  PhysicsStatistics const & getStatistics() const;
+
+private:
+  bool isDynamic(uint32_t slot) const;
+
+  /** Places the shapes and finds the pairs of overlapping bounding boxes. */
+  void findPairs();
+
+  /** Computes the contacts of all pairs and warm starts them. */
+  void findContacts();
+
+  /** Sorts the touching manifolds by island. */
+  void buildIslands();
+
+  /** Solves the manifolds [begin, end) of one island. */
+  void solveIsland(size_t begin, size_t end, float deltaTime);
+
+  void prepareManifold(Manifold & manifold, float inverseDeltaTime);
+
+  void applyImpulses(Manifold & manifold);
+
+  uint32_t findIsland(uint32_t body);
+
+  /** Returns the manifold of the pair in the last step or nullptr. */
+  CachedManifold const * findCachedManifold(BodyPair const & pair) const;
+
+  std::vector<BodyMotion> m_motions{};
+
+  /** The motions before the last step, for interpolation. */
+  std::vector<BodyMotion> m_previousMotions{};
+
+  std::vector<BodyDefinition> m_definitions{};
+
+  std::vector<BodyMass> m_masses{};
+
+  std::vector<uint8_t> m_isEnabled{};
+
+  /** The component whose state is the motion of the body, or nullptr. */
+  std::vector<Component *> m_owners{};
+
+  std::vector<uint32_t> m_freeSlots{};
+
+  Vector2 m_gravity{0.0f, -9.81f};
+
+  double m_timeStep{1.0 / 120.0};
+
+  size_t m_maximumSteps{8};
+
+  size_t m_iterations{10};
+
+  /** The time that didn't fill a whole step yet. */
+  double m_accumulator{0.0};
+
+  PhysicsStatistics m_statistics{};
+
+  /** The buffers of a step, kept to avoid allocations. */
+  std::vector<CollisionShape> m_shapes{};
+  std::vector<Bounds> m_bounds{};
+  std::vector<uint32_t> m_activeBodies{};
+  std::vector<CellEntry> m_cells{};
+  std::vector<CellEntry> m_sortedCells{};
+  std::vector<uint32_t> m_bucketOffsets{};
+  std::vector<BodyPair> m_pairs{};
+  std::vector<Manifold> m_candidates{};
+  std::vector<Manifold> m_manifolds{};
+  std::vector<uint32_t> m_islandParents{};
+  std::vector<uint32_t> m_islandOfRoot{};
+  std::vector<uint32_t> m_islandOfManifold{};
+  std::vector<size_t> m_islandOffsets{};
+  std::vector<size_t> m_islandNext{};
+
+  /** The touching manifolds of the last step sorted by their first body. */
+  std::vector<CachedManifold> m_cache{};
+
+  /** The cached manifolds of body a are [m_cacheOffsets[a], [a + 1]). */
+  std::vector<uint32_t> m_cacheOffsets{};
+
+  /** The next free entry of each body while the cache is filled. */
+  std::vector<uint32_t> m_cacheNext{};
+};
+
+PhysicsWorld::Impl::Impl() = default;
+
+PhysicsWorld::Impl::~Impl() = default;
+
+uint32_t PhysicsWorld::Impl::createBody(Component * pOwner)
+{
+  uint32_t slot = 0;
+  if (m_freeSlots.empty())
+  {
+    slot = static_cast<uint32_t>(m_motions.size());
+    m_motions.emplace_back();
+    m_previousMotions.emplace_back();
+    m_definitions.emplace_back();
+    m_masses.emplace_back();
+    m_isEnabled.push_back(0);
+    m_owners.push_back(nullptr);
+  }
+  else
+  {
+    slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  }
+  m_motions[slot] = BodyMotion();
+  m_previousMotions[slot] = BodyMotion();
+  m_isEnabled[slot] = 0;
+  m_owners[slot] = pOwner;
+  setDefinition(slot, BodyDefinition());
+  return slot;
+}
+
+void PhysicsWorld::Impl::destroyBody(uint32_t slot)
+{
+  m_isEnabled[slot] = 0;
+  m_owners[slot] = nullptr;
+  m_freeSlots.push_back(slot);
+  // a new body in the slot mustn't inherit the impulses
+  for (CachedManifold & cached : m_cache)
+  {
+    if (cached.key >> 32 == slot || (cached.key & 0xffffffffu) == slot)
+    {
+      cached.numberOfPoints = 0;
+    }
+  }
+}
+
+void PhysicsWorld::Impl::setDefinition(uint32_t slot,
+                                       BodyDefinition const & definition)
+{
+  m_definitions[slot] = definition;
+  BodyMass & mass = m_masses[slot];
+  if (definition.type != BODY_DYNAMIC)
+  {
+    mass.inverseMass = 0.0f;
+    mass.inverseInertia = 0.0f;
+    return;
+  }
+
+  float const w = definition.halfWidth;
+  float const h = definition.halfHeight;
+  float area = 1.0f;
+  float inertiaPerMass = 1.0f;
+  if (definition.shape == SHAPE_BOX)
+  {
+    area = 4.0f * w * h;
+    inertiaPerMass = (w * w + h * h) / 3.0f;
+  }
+  else if (definition.shape == SHAPE_CIRCLE)
+  {
+    area = 3.14159265f * w * w;
+    inertiaPerMass = 0.5f * w * w;
+  }
+  float const bodyMass = definition.density * area;
+  mass.inverseMass = bodyMass > 0.0f ? 1.0f / bodyMass : 1.0f;
+  mass.inverseInertia = bodyMass > 0.0f && inertiaPerMass > 0.0f
+                            ? 1.0f / (bodyMass * inertiaPerMass)
+                            : 0.0f;
+}
+
+BodyDefinition const & PhysicsWorld::Impl::getDefinition(uint32_t slot) const
+{
+  return m_definitions[slot];
+}
+
+BodyMotion & PhysicsWorld::Impl::editMotion(uint32_t slot)
+{
+  return m_motions[slot];
+}
+
+BodyMotion const & PhysicsWorld::Impl::getMotion(uint32_t slot) const
+{
+  return m_motions[slot];
+}
+
+BodyMotion PhysicsWorld::Impl::getInterpolatedMotion(uint32_t slot) const
+{
+  float const t = static_cast<float>(m_accumulator / m_timeStep);
+  BodyMotion const & previous = m_previousMotions[slot];
+  BodyMotion motion = m_motions[slot];
+  motion.positionX = previous.positionX + t * (motion.positionX - previous.positionX);
+  motion.positionY = previous.positionY + t * (motion.positionY - previous.positionY);
+  motion.angle = previous.angle + t * (motion.angle - previous.angle);
+  return motion;
+}
+
+void PhysicsWorld::Impl::setEnabled(uint32_t slot, bool isEnabled)
+{
+  m_isEnabled[slot] = isEnabled ? 1 : 0;
+  // a body that appears somewhere else mustn't be interpolated from there
+  m_previousMotions[slot] = m_motions[slot];
+}
+
+bool PhysicsWorld::Impl::isEnabled(uint32_t slot) const
+{
+  return m_isEnabled[slot] != 0;
+}
+
+void PhysicsWorld::Impl::teleport(uint32_t slot)
+{
+  m_previousMotions[slot] = m_motions[slot];
+}
+
+void PhysicsWorld::Impl::applyImpulse(uint32_t slot, Vector2 const & impulse)
+{
+  BodyMotion & motion = m_motions[slot];
+  motion.velocityX += m_masses[slot].inverseMass * impulse.x();
+  motion.velocityY += m_masses[slot].inverseMass * impulse.y();
+}
+
+void PhysicsWorld::Impl::update(double deltaTime)
+{
+  m_accumulator += deltaTime;
+  size_t numberOfSteps = 0;
+  while (m_accumulator >= m_timeStep && numberOfSteps < m_maximumSteps)
+  {
+    step();
+    m_accumulator -= m_timeStep;
+    ++numberOfSteps;
+  }
+  if (m_accumulator >= m_timeStep)
+  {
+    m_accumulator = std::fmod(m_accumulator, m_timeStep);
+  }
+  m_statistics.numberOfSteps = numberOfSteps;
+}
+
+void PhysicsWorld::Impl::step()
+{
+  float const deltaTime = static_cast<float>(m_timeStep);
+  m_previousMotions = m_motions;
+
+  Clock::time_point const start = Clock::now();
+  findPairs();
+  Clock::time_point const broadphaseEnd = Clock::now();
+  findContacts();
+  buildIslands();
+  Clock::time_point const narrowphaseEnd = Clock::now();
+
+  // gravity first, so resting contacts cancel it in the same step
+  Vector2 const deltaVelocity = m_gravity * deltaTime;
+  for (uint32_t slot = 0; slot < m_motions.size(); ++slot)
+  {
+    if (m_isEnabled[slot] != 0 && isDynamic(slot))
+    {
+      m_motions[slot].velocityX += deltaVelocity.x();
+      m_motions[slot].velocityY += deltaVelocity.y();
+    }
+  }
+
+  size_t const numberOfIslands = m_islandOffsets.size() - 1;
+  size_t const grainSize = std::max<size_t>(
+      1, numberOfIslands / (8 * JobSystem::getInstance().getNumberOfThreads()));
+  JobSystem::getInstance().parallelFor(
+      numberOfIslands, grainSize,
+      [this, deltaTime](size_t begin, size_t end)
+      {
+        for (size_t island = begin; island < end; ++island)
+        {
+          solveIsland(m_islandOffsets[island], m_islandOffsets[island + 1],
+                      deltaTime);
+        }
+      });
+
+  for (uint32_t slot = 0; slot < m_motions.size(); ++slot)
+  {
+    if (m_isEnabled[slot] != 0 && m_definitions[slot].type != BODY_STATIC)
+    {
+      BodyMotion & motion = m_motions[slot];
+      motion.positionX += motion.velocityX * deltaTime;
+      motion.positionY += motion.velocityY * deltaTime;
+      motion.angle += motion.angularVelocity * deltaTime;
+      if (m_owners[slot] != nullptr)
+      {
+        m_owners[slot]->markStateChanged();
+      }
+    }
+  }
+
+  // keep the impulses for warm starting the next step, grouped by body a
+  m_cacheOffsets.assign(m_motions.size() + 1, 0);
+  for (Manifold const & manifold : m_manifolds)
+  {
+    ++m_cacheOffsets[manifold.bodyA + 1];
+  }
+  for (size_t slot = 1; slot < m_cacheOffsets.size(); ++slot)
+  {
+    m_cacheOffsets[slot] += m_cacheOffsets[slot - 1];
+  }
+  m_cache.resize(m_manifolds.size());
+  m_cacheNext.assign(m_cacheOffsets.begin(), m_cacheOffsets.end() - 1);
+  for (Manifold const & manifold : m_manifolds)
+  {
+    CachedManifold & cached = m_cache[m_cacheNext[manifold.bodyA]++];
+    cached.key = getPairKey(manifold.bodyA, manifold.bodyB);
+    cached.numberOfPoints = manifold.numberOfPoints;
+    for (uint32_t p = 0; p < manifold.numberOfPoints; ++p)
+    {
+      cached.features[p] = manifold.points[p].feature;
+      cached.normalImpulses[p] = manifold.points[p].normalImpulse;
+      cached.tangentImpulses[p] = manifold.points[p].tangentImpulse;
+    }
+  }
+
+  m_statistics.numberOfBodies = m_activeBodies.size();
+  m_statistics.numberOfPairs = m_pairs.size();
+  m_statistics.numberOfContacts = m_manifolds.size();
+  m_statistics.numberOfIslands = numberOfIslands;
+  m_statistics.broadphaseSeconds =
+      std::chrono::duration<double>(broadphaseEnd - start).count();
+  m_statistics.narrowphaseSeconds =
+      std::chrono::duration<double>(narrowphaseEnd - broadphaseEnd).count();
+  m_statistics.solverSeconds =
+      std::chrono::duration<double>(Clock::now() - narrowphaseEnd).count();
+}
+
+void PhysicsWorld::Impl::setTimeStep(double seconds)
+{
+  m_timeStep = seconds > 0.0 ? seconds : m_timeStep;
+}
+
+double PhysicsWorld::Impl::getTimeStep() const { return m_timeStep; }
+
+void PhysicsWorld::Impl::setMaximumSteps(size_t maximumSteps)
+{
+  m_maximumSteps = std::max<size_t>(maximumSteps, 1);
+}
+
+void PhysicsWorld::Impl::setIterations(size_t iterations)
+{
+  m_iterations = iterations;
+}
+
+void PhysicsWorld::Impl::setGravity(Vector2 const & gravity)
+{
+  m_gravity = gravity;
+}
+
+Vector2 PhysicsWorld::Impl::getGravity() const { return m_gravity; }
+
+size_t PhysicsWorld::Impl::getNumberOfSlots() const { return m_motions.size(); }
+
+PhysicsStatistics const & PhysicsWorld::Impl::getStatistics() const
+{
+  return m_statistics;
+}
+
+bool PhysicsWorld::Impl::isDynamic(uint32_t slot) const
+{
+  return m_definitions[slot].type == BODY_DYNAMIC;
+}
+
+void PhysicsWorld::Impl::findPairs()
+{
+  size_t const numberOfSlots = m_motions.size();
+  m_shapes.resize(numberOfSlots);
+  m_bounds.resize(numberOfSlots);
+  m_activeBodies.clear();
+  m_pairs.clear();
+
+  // the cells are as large as the largest dynamic body
+  float cellSize = 0.0f;
+  for (uint32_t slot = 0; slot < numberOfSlots; ++slot)
+  {
+    BodyDefinition const & definition = m_definitions[slot];
+    if (m_isEnabled[slot] == 0 || definition.shape == SHAPE_NONE)
+      continue;
+    BodyMotion const & motion = m_motions[slot];
+    CollisionShape & shape = m_shapes[slot];
+    shape.type = definition.shape;
+    shape.position = Vector2(motion.positionX, motion.positionY);
+    shape.rotation = getRotation(motion.angle);
+    shape.halfExtents =
+        definition.shape == SHAPE_BOX
+            ? Vector2(definition.halfWidth, definition.halfHeight)
+            : Vector2(definition.halfWidth, definition.halfWidth);
+    Vector2 const extents = definition.shape == SHAPE_BOX
+                                ? Vector2(shape.rotation.cwiseAbs() *
+                                          shape.halfExtents)
+                                : shape.halfExtents;
+    Bounds & bounds = m_bounds[slot];
+    bounds.minimumX = motion.positionX - extents.x();
+    bounds.minimumY = motion.positionY - extents.y();
+    bounds.maximumX = motion.positionX + extents.x();
+    bounds.maximumY = motion.positionY + extents.y();
+    if (definition.type == BODY_DYNAMIC)
+    {
+      cellSize = std::max(cellSize, 2.0f * std::max(extents.x(), extents.y()));
+    }
+    m_activeBodies.push_back(slot);
+  }
+  if (cellSize <= 0.0f)
+    return;
+
+  float const inverseCellSize = 1.0f / cellSize;
+  m_cells.clear();
+  for (uint32_t slot : m_activeBodies)
+  {
+    Bounds & bounds = m_bounds[slot];
+    bounds.firstCellX =
+        static_cast<int32_t>(std::floor(bounds.minimumX * inverseCellSize));
+    bounds.firstCellY =
+        static_cast<int32_t>(std::floor(bounds.minimumY * inverseCellSize));
+    bounds.lastCellX =
+        static_cast<int32_t>(std::floor(bounds.maximumX * inverseCellSize));
+    bounds.lastCellY =
+        static_cast<int32_t>(std::floor(bounds.maximumY * inverseCellSize));
+    for (int32_t x = bounds.firstCellX; x <= bounds.lastCellX; ++x)
+    {
+      for (int32_t y = bounds.firstCellY; y <= bounds.lastCellY; ++y)
+      {
+        m_cells.push_back(CellEntry{getCellKey(x, y), slot, 0});
+      }
+    }
+  }
+
+  // a counting sort into hash buckets keeps the bodies of a cell in order
+  uint32_t bits = 1;
+  while ((size_t(1) << bits) < 2 * m_cells.size())
+  {
+    ++bits;
+  }
+  m_bucketOffsets.assign((size_t(1) << bits) + 1, 0);
+  for (CellEntry & entry : m_cells)
+  {
+    entry.bucket = getBucket(entry.cell, bits);
+    ++m_bucketOffsets[entry.bucket + 1];
+  }
+  for (size_t bucket = 1; bucket < m_bucketOffsets.size(); ++bucket)
+  {
+    m_bucketOffsets[bucket] += m_bucketOffsets[bucket - 1];
+  }
+  m_sortedCells.resize(m_cells.size());
+  for (CellEntry const & entry : m_cells)
+  {
+    m_sortedCells[m_bucketOffsets[entry.bucket]++] = entry;
+  }
+
+  // the offsets now point at the end of each bucket
+  uint32_t begin = 0;
+  for (size_t bucket = 0; bucket + 1 < m_bucketOffsets.size(); ++bucket)
+  {
+    uint32_t const end = m_bucketOffsets[bucket];
+    for (uint32_t i = begin; i < end; ++i)
+    {
+      CellEntry const & entryA = m_sortedCells[i];
+      Bounds const & a = m_bounds[entryA.body];
+      int32_t const cellX = static_cast<int32_t>(entryA.cell >> 32);
+      int32_t const cellY = static_cast<int32_t>(entryA.cell);
+      for (uint32_t j = i + 1; j < end; ++j)
+      {
+        CellEntry const & entryB = m_sortedCells[j];
+        Bounds const & b = m_bounds[entryB.body];
+        if (entryA.cell != entryB.cell ||
+            (!isDynamic(entryA.body) && !isDynamic(entryB.body)) ||
+            a.maximumX < b.minimumX || b.maximumX < a.minimumX ||
+            a.maximumY < b.minimumY || b.maximumY < a.minimumY)
+          continue;
+        // pairs sharing several cells are only reported by the first one
+        if (cellX != std::max(a.firstCellX, b.firstCellX) ||
+            cellY != std::max(a.firstCellY, b.firstCellY))
+          continue;
+        m_pairs.push_back(BodyPair{entryA.body, entryB.body});
+      }
+    }
+    begin = end;
+  }
+}
+
+void PhysicsWorld::Impl::findContacts()
+{
+  m_candidates.resize(m_pairs.size());
+  JobSystem::getInstance().parallelFor(
+      m_pairs.size(), NARROWPHASE_GRAIN,
+      [this](size_t begin, size_t end)
+      {
+        for (size_t i = begin; i < end; ++i)
+        {
+          BodyPair const & pair = m_pairs[i];
+          Manifold & manifold = m_candidates[i];
+          manifold.bodyA = pair.bodyA;
+          manifold.bodyB = pair.bodyB;
+          manifold.numberOfPoints =
+              collide(m_shapes[pair.bodyA], m_shapes[pair.bodyB],
+                      manifold.normal, manifold.points);
+          if (manifold.numberOfPoints == 0)
+            continue;
+          BodyDefinition const & a = m_definitions[pair.bodyA];
+          BodyDefinition const & b = m_definitions[pair.bodyB];
+          manifold.friction = std::sqrt(a.friction * b.friction);
+          manifold.restitution = std::max(a.restitution, b.restitution);
+
+          // reuse the impulses of points with the same features
+          CachedManifold const * cached = findCachedManifold(pair);
+          bool const isCached = cached != nullptr;
+          for (uint32_t p = 0; p < manifold.numberOfPoints; ++p)
+          {
+            ContactPoint & point = manifold.points[p];
+            point.normalImpulse = 0.0f;
+            point.tangentImpulse = 0.0f;
+            for (uint32_t c = 0; isCached && c < cached->numberOfPoints; ++c)
+            {
+              if (cached->features[c] == point.feature)
+              {
+                point.normalImpulse = cached->normalImpulses[c];
+                point.tangentImpulse = cached->tangentImpulses[c];
+                break;
+              }
+            }
+          }
+        }
+      });
+
+  m_manifolds.clear();
+  for (Manifold const & manifold : m_candidates)
+  {
+    if (manifold.numberOfPoints > 0)
+    {
+      m_manifolds.push_back(manifold);
+    }
+  }
+}
+
+void PhysicsWorld::Impl::buildIslands()
+{
+  // union find over the dynamic bodies, static bodies don't connect
+  m_islandParents.resize(m_motions.size());
+  for (uint32_t slot = 0; slot < m_islandParents.size(); ++slot)
+  {
+    m_islandParents[slot] = slot;
+  }
+  for (Manifold const & manifold : m_manifolds)
+  {
+    if (isDynamic(manifold.bodyA) && isDynamic(manifold.bodyB))
+    {
+      uint32_t const rootA = findIsland(manifold.bodyA);
+      uint32_t const rootB = findIsland(manifold.bodyB);
+      m_islandParents[std::max(rootA, rootB)] = std::min(rootA, rootB);
+    }
+  }
+
+  // islands are numbered in the order of their first manifold
+  m_islandOfRoot.assign(m_motions.size(), NO_ISLAND);
+  m_islandOfManifold.resize(m_manifolds.size());
+  m_islandOffsets.assign(1, 0);
+  for (size_t i = 0; i < m_manifolds.size(); ++i)
+  {
+    Manifold const & manifold = m_manifolds[i];
+    uint32_t const root = findIsland(
+        isDynamic(manifold.bodyA) ? manifold.bodyA : manifold.bodyB);
+    if (m_islandOfRoot[root] == NO_ISLAND)
+    {
+      m_islandOfRoot[root] = static_cast<uint32_t>(m_islandOffsets.size() - 1);
+      m_islandOffsets.push_back(0);
+    }
+    m_islandOfManifold[i] = m_islandOfRoot[root];
+    ++m_islandOffsets[m_islandOfRoot[root] + 1];
+  }
+  for (size_t island = 1; island < m_islandOffsets.size(); ++island)
+  {
+    m_islandOffsets[island] += m_islandOffsets[island - 1];
+  }
+
+  // a stable counting sort keeps the order inside the islands
+  m_candidates.resize(m_manifolds.size());
+  m_islandNext.assign(m_islandOffsets.begin(), m_islandOffsets.end() - 1);
+  for (size_t i = 0; i < m_manifolds.size(); ++i)
+  {
+    m_candidates[m_islandNext[m_islandOfManifold[i]]++] = m_manifolds[i];
+  }
+  m_manifolds.swap(m_candidates);
+}
+
+void PhysicsWorld::Impl::solveIsland(size_t begin, size_t end, float deltaTime)
+{
+  float const inverseDeltaTime = 1.0f / deltaTime;
+  for (size_t i = begin; i < end; ++i)
+  {
+    prepareManifold(m_manifolds[i], inverseDeltaTime);
+  }
+  for (size_t iteration = 0; iteration < m_iterations; ++iteration)
+  {
+    for (size_t i = begin; i < end; ++i)
+    {
+      applyImpulses(m_manifolds[i]);
+    }
+  }
+}
+
+void PhysicsWorld::Impl::prepareManifold(Manifold & manifold,
+                                         float inverseDeltaTime)
+{
+  BodyMotion & a = m_motions[manifold.bodyA];
+  BodyMotion & b = m_motions[manifold.bodyB];
+  BodyMass const & massA = m_masses[manifold.bodyA];
+  BodyMass const & massB = m_masses[manifold.bodyB];
+  Vector2 const & normal = manifold.normal;
+  Vector2 const tangent(normal.y(), -normal.x());
+  Vector2 velocityA(a.velocityX, a.velocityY);
+  Vector2 velocityB(b.velocityX, b.velocityY);
+  float angularVelocityA = a.angularVelocity;
+  float angularVelocityB = b.angularVelocity;
+
+  for (uint32_t p = 0; p < manifold.numberOfPoints; ++p)
+  {
+    ContactPoint & point = manifold.points[p];
+    point.r1 = point.position - Vector2(a.positionX, a.positionY);
+    point.r2 = point.position - Vector2(b.positionX, b.positionY);
+
+    float const rn1 = point.r1.dot(normal);
+    float const rn2 = point.r2.dot(normal);
+    float const normalMass =
+        massA.inverseMass + massB.inverseMass +
+        massA.inverseInertia * (point.r1.squaredNorm() - rn1 * rn1) +
+        massB.inverseInertia * (point.r2.squaredNorm() - rn2 * rn2);
+    point.massNormal = 1.0f / normalMass;
+
+    float const rt1 = point.r1.dot(tangent);
+    float const rt2 = point.r2.dot(tangent);
+    float const tangentMass =
+        massA.inverseMass + massB.inverseMass +
+        massA.inverseInertia * (point.r1.squaredNorm() - rt1 * rt1) +
+        massB.inverseInertia * (point.r2.squaredNorm() - rt2 * rt2);
+    point.massTangent = 1.0f / tangentMass;
+
+    point.bias = -BIAS_FACTOR * inverseDeltaTime *
+                 std::min(0.0f, point.separation + ALLOWED_PENETRATION);
+    Vector2 const relativeVelocity =
+        velocityB + cross(angularVelocityB, point.r2) - velocityA -
+        cross(angularVelocityA, point.r1);
+    float const normalVelocity = relativeVelocity.dot(normal);
+    if (normalVelocity < -RESTITUTION_THRESHOLD)
+    {
+      point.bias =
+          std::max(point.bias, -manifold.restitution * normalVelocity);
+    }
+
+    Vector2 const impulse =
+        point.normalImpulse * normal + point.tangentImpulse * tangent;
+    velocityA -= massA.inverseMass * impulse;
+    angularVelocityA -= massA.inverseInertia * cross(point.r1, impulse);
+    velocityB += massB.inverseMass * impulse;
+    angularVelocityB += massB.inverseInertia * cross(point.r2, impulse);
+  }
+
+  // only dynamic bodies are written, static ones are shared by islands
+  if (isDynamic(manifold.bodyA))
+  {
+    a.velocityX = velocityA.x();
+    a.velocityY = velocityA.y();
+    a.angularVelocity = angularVelocityA;
+  }
+  if (isDynamic(manifold.bodyB))
+  {
+    b.velocityX = velocityB.x();
+    b.velocityY = velocityB.y();
+    b.angularVelocity = angularVelocityB;
+  }
+}
+
+void PhysicsWorld::Impl::applyImpulses(Manifold & manifold)
+{
+  BodyMotion & a = m_motions[manifold.bodyA];
+  BodyMotion & b = m_motions[manifold.bodyB];
+  BodyMass const & massA = m_masses[manifold.bodyA];
+  BodyMass const & massB = m_masses[manifold.bodyB];
+  Vector2 const & normal = manifold.normal;
+  Vector2 const tangent(normal.y(), -normal.x());
+  Vector2 velocityA(a.velocityX, a.velocityY);
+  Vector2 velocityB(b.velocityX, b.velocityY);
+  float angularVelocityA = a.angularVelocity;
+  float angularVelocityB = b.angularVelocity;
+
+  for (uint32_t p = 0; p < manifold.numberOfPoints; ++p)
+  {
+    ContactPoint & point = manifold.points[p];
+
+    // normal impulse, accumulated impulses may only push
+    Vector2 relativeVelocity = velocityB + cross(angularVelocityB, point.r2) -
+                               velocityA - cross(angularVelocityA, point.r1);
+    float const normalVelocity = relativeVelocity.dot(normal);
+    float const previousNormal = point.normalImpulse;
+    point.normalImpulse = std::max(
+        previousNormal + point.massNormal * (-normalVelocity + point.bias),
+        0.0f);
+    Vector2 impulse = (point.normalImpulse - previousNormal) * normal;
+    velocityA -= massA.inverseMass * impulse;
+    angularVelocityA -= massA.inverseInertia * cross(point.r1, impulse);
+    velocityB += massB.inverseMass * impulse;
+    angularVelocityB += massB.inverseInertia * cross(point.r2, impulse);
+
+    // friction impulse within the friction cone
+    relativeVelocity = velocityB + cross(angularVelocityB, point.r2) -
+                       velocityA - cross(angularVelocityA, point.r1);
+    float const tangentVelocity = relativeVelocity.dot(tangent);
+    float const maximumFriction = manifold.friction * point.normalImpulse;
+    float const previousTangent = point.tangentImpulse;
+    point.tangentImpulse =
+        std::clamp(previousTangent - point.massTangent * tangentVelocity,
+                   -maximumFriction, maximumFriction);
+    impulse = (point.tangentImpulse - previousTangent) * tangent;
+    velocityA -= massA.inverseMass * impulse;
+    angularVelocityA -= massA.inverseInertia * cross(point.r1, impulse);
+    velocityB += massB.inverseMass * impulse;
+    angularVelocityB += massB.inverseInertia * cross(point.r2, impulse);
+  }
+
+  if (isDynamic(manifold.bodyA))
+  {
+    a.velocityX = velocityA.x();
+    a.velocityY = velocityA.y();
+    a.angularVelocity = angularVelocityA;
+  }
+  if (isDynamic(manifold.bodyB))
+  {
+    b.velocityX = velocityB.x();
+    b.velocityY = velocityB.y();
+    b.angularVelocity = angularVelocityB;
+  }
+}
+
+CachedManifold const *
+PhysicsWorld::Impl::findCachedManifold(BodyPair const & pair) const
+{
+  if (pair.bodyA + size_t(1) >= m_cacheOffsets.size())
+    return nullptr;
+  uint64_t const key = getPairKey(pair.bodyA, pair.bodyB);
+  for (uint32_t i = m_cacheOffsets[pair.bodyA];
+       i < m_cacheOffsets[pair.bodyA + 1]; ++i)
+  {
+    if (m_cache[i].key == key)
+      return &m_cache[i];
+  }
+  return nullptr;
+}
+
+uint32_t PhysicsWorld::Impl::findIsland(uint32_t body)
+{
+  while (m_islandParents[body] != body)
+  {
+    m_islandParents[body] = m_islandParents[m_islandParents[body]];
+    body = m_islandParents[body];
+  }
+  return body;
+}
+
+/******************** Impl end *************************************/
+
+PhysicsWorld & PhysicsWorld::getInstance()
+{
+  static PhysicsWorld instance;
+  return instance;
+}
+
+PhysicsWorld::PhysicsWorld() : m_impl(new Impl()) {}
+
+PhysicsWorld::~PhysicsWorld() = default;
+
+uint32_t PhysicsWorld::createBody(Component * pOwner)
+{
+  return m_impl->createBody(pOwner);
+}
+
+void PhysicsWorld::destroyBody(uint32_t slot) { m_impl->destroyBody(slot); }
+
+void PhysicsWorld::setDefinition(uint32_t slot,
+                                 BodyDefinition const & definition)
+{
+  m_impl->setDefinition(slot, definition);
+}
+
+BodyDefinition const & PhysicsWorld::getDefinition(uint32_t slot) const
+{
+  return m_impl->getDefinition(slot);
+}
+
+BodyMotion & PhysicsWorld::editMotion(uint32_t slot)
+{
+  return m_impl->editMotion(slot);
+}
+
+BodyMotion const & PhysicsWorld::getMotion(uint32_t slot) const
+{
+  return m_impl->getMotion(slot);
+}
+
+BodyMotion PhysicsWorld::getInterpolatedMotion(uint32_t slot) const
+{
+  return m_impl->getInterpolatedMotion(slot);
+}
+
+void PhysicsWorld::setEnabled(uint32_t slot, bool isEnabled)
+{
+  m_impl->setEnabled(slot, isEnabled);
+}
+
+bool PhysicsWorld::isEnabled(uint32_t slot) const
+{
+  return m_impl->isEnabled(slot);
+}
+
+void PhysicsWorld::teleport(uint32_t slot) { m_impl->teleport(slot); }
+
+void PhysicsWorld::applyImpulse(uint32_t slot, Vector2 const & impulse)
+{
+  m_impl->applyImpulse(slot, impulse);
+}
+
+void PhysicsWorld::update(double deltaTime) { m_impl->update(deltaTime); }
+
+void PhysicsWorld::step() { m_impl->step(); }
+
+void PhysicsWorld::setTimeStep(double seconds) { m_impl->setTimeStep(seconds); }
+
+double PhysicsWorld::getTimeStep() const { return m_impl->getTimeStep(); }
+
+void PhysicsWorld::setMaximumSteps(size_t maximumSteps)
+{
+  m_impl->setMaximumSteps(maximumSteps);
+}
+
+void PhysicsWorld::setIterations(size_t iterations)
+{
+  m_impl->setIterations(iterations);
+}
+
+void PhysicsWorld::setGravity(Vector2 const & gravity)
+{
+  m_impl->setGravity(gravity);
+}
+
+Vector2 PhysicsWorld::getGravity() const { return m_impl->getGravity(); }
+
+size_t PhysicsWorld::getNumberOfSlots() const
+{
+  return m_impl->getNumberOfSlots();
+}
+
+PhysicsStatistics const & PhysicsWorld::getStatistics() const
+{
+  return m_impl->getStatistics();
+}
@@ -0,0 +1,117 @@
+#include "Core/PoolAllocator.h"
+#include "Core/MemoryStats.h"
+#include <algorithm>
+#include <new>
+
+namespace
+{
+
+/** The bytes of a chunk when the pool refills on its own. */
+size_t const CHUNK_SIZE = 64 * 1024;
+
+} // namespace
+
+PoolAllocator::PoolAllocator(char const * pSubsystemName)
+    : m_freeBlocks(MAX_BLOCK_SIZE / GRANULARITY),
+      m_memory(MemoryStats::getInstance().getSubsystem(pSubsystemName))
+{
+}
+
+PoolAllocator::~PoolAllocator()
+{
+  for (void * pChunk : m_chunks)
+  {
+    ::operator delete(pChunk, std::align_val_t(GRANULARITY));
+  }
+}
+
+void * PoolAllocator::allocate(size_t size)
+{
+  if (size > MAX_BLOCK_SIZE)
+  {
+    m_memory.recordAllocation(size);
+    return ::operator new(size, std::align_val_t(GRANULARITY));
+  }
+  size_t const sizeClass = getSizeClass(size);
+  std::vector<void *> & freeBlocks = m_freeBlocks[sizeClass];
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (freeBlocks.empty())
+  {
+    size_t const blockSize = (sizeClass + 1) * GRANULARITY;
+    refill(sizeClass, std::max<size_t>(CHUNK_SIZE / blockSize, 1));
+  }
+  void * pBlock = freeBlocks.back();
+  freeBlocks.pop_back();
+  return pBlock;
+}
+
+void PoolAllocator::allocate(size_t size, size_t count, void ** ppBlocks)
+{
+  if (size > MAX_BLOCK_SIZE)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      ppBlocks[i] = allocate(size);
+    }
+    return;
+  }
+  std::vector<void *> & freeBlocks = m_freeBlocks[getSizeClass(size)];
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (freeBlocks.size() < count)
+  {
+    refill(getSizeClass(size), count - freeBlocks.size());
+  }
+  // in the order single allocations would return them
+  std::reverse_copy(freeBlocks.end() - static_cast<ptrdiff_t>(count),
+                    freeBlocks.end(), ppBlocks);
+  freeBlocks.resize(freeBlocks.size() - count);
+}
+
+void PoolAllocator::deallocate(void * p, size_t size)
+{
+  if (p == nullptr)
+    return;
+  if (size > MAX_BLOCK_SIZE)
+  {
+    m_memory.recordDeallocation(size);
+    ::operator delete(p, std::align_val_t(GRANULARITY));
+    return;
+  }
+  std::vector<void *> & freeBlocks = m_freeBlocks[getSizeClass(size)];
+  std::lock_guard<std::mutex> lock(m_mutex);
+  freeBlocks.push_back(p);
+}
+
+void PoolAllocator::reserve(size_t size, size_t count)
+{
+  if (size > MAX_BLOCK_SIZE)
+    return;
+  size_t const sizeClass = getSizeClass(size);
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_freeBlocks[sizeClass].size() < count)
+  {
+    refill(sizeClass, count - m_freeBlocks[sizeClass].size());
+  }
+}
+
+size_t PoolAllocator::getSizeClass(size_t size)
+{
+  return size == 0 ? 0 : (size - 1) / GRANULARITY;
+}
+
+void PoolAllocator::refill(size_t sizeClass, size_t count)
+{
+  size_t const blockSize = (sizeClass + 1) * GRANULARITY;
+  char * pChunk = static_cast<char *>(
+      ::operator new(blockSize * count, std::align_val_t(GRANULARITY)));
+  m_chunks.push_back(pChunk);
+  m_memory.recordAllocation(blockSize * count);
+
+  // the blocks stay untouched and are handed out in address order
+  std::vector<void *> & freeBlocks = m_freeBlocks[sizeClass];
+  freeBlocks.reserve(freeBlocks.size() + count);
+  for (size_t i = count; i > 0; --i)
+  {
+    freeBlocks.push_back(pChunk + (i - 1) * blockSize);
+  }
+}
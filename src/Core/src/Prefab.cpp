@@ -0,0 +1,316 @@
+#include "Core/Prefab.h"
+#include "ComponentIndex.h"
+#include "Core/Component.h"
+#include "Core/MemoryStats.h"
+#include "Core/SceneObject.h"
+#include "SceneObjectImpl.h"
+#include "ScenePools.h"
+#include "SceneVersions.h"
+#include <cstdint>
+#include <typeinfo>
+#include <utility>
+
+/********** Impl start ************/
+
+class Prefab::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  bool capture(SceneObject const & root);
+
+  bool isEmpty() const;
+
+  size_t getNumberOfObjects() const;
+
+  size_t getNumberOfComponents() const;
+
+  void instantiate(size_t count, std::vector<SceneObject *> & roots,
+                   SceneObject * pParent) const;
+
+private:
+  /** One scene object of the template, stored in depth first order. */
+  struct Node
+  {
+    /** The index of the parent node, unused for the root. */
+    uint32_t parent;
+
+    uint32_t numberOfChildren;
+
+    /** The range of the node's prototypes. */
+    uint32_t firstComponent;
+
+    uint32_t numberOfComponents;
+
+    bool isEnabled;
+  };
+
+  /** Appends the subtree of the scene object in depth first order. */
+  bool captureNode(SceneObject const & object, uint32_t parent);
+
+  /** Deletes all nodes and prototypes. */
+  void clear();
+
+  /**
+   * Returns the allocation size if the prototype can be copied into pool
+   * memory with cloneInto, zero if it has to be cloned.
+   */
+  static size_t getBlockSize(Component const & prototype);
+
+  std::vector<Node> m_nodes{};
+
+  /** Detached copies of all components, owned by the prefab. */
+  std::vector<Component *> m_prototypes{};
+
+  /** The block size of every prototype, see getBlockSize. */
+  std::vector<size_t> m_blockSizes{};
+};
+
+Prefab::Impl::Impl() = default;
+
+Prefab::Impl::~Impl() { clear(); }
+
+bool Prefab::Impl::capture(SceneObject const & root)
+{
+  clear();
+  if (!captureNode(root, 0))
+  {
+    clear();
+    return false;
+  }
+  return true;
+}
+
+bool Prefab::Impl::isEmpty() const { return m_nodes.empty(); }
+
+size_t Prefab::Impl::getNumberOfObjects() const { return m_nodes.size(); }
+
+size_t Prefab::Impl::getNumberOfComponents() const
+{
+  return m_prototypes.size();
+}
+
+void Prefab::Impl::instantiate(size_t count, std::vector<SceneObject *> & roots,
+                               SceneObject * pParent) const
+{
+  if (m_nodes.empty() || count == 0)
+    return;
+
+  // the component memory of all instances, one pool trip per prototype
+  size_t const numberOfNodes = m_nodes.size();
+  size_t const numberOfPrototypes = m_prototypes.size();
+  std::vector<void *> blocks(numberOfPrototypes * count, nullptr);
+  for (size_t p = 0; p < numberOfPrototypes; ++p)
+  {
+    if (m_blockSizes[p] > 0)
+    {
+      allocateComponents(m_blockSizes[p], count, blocks.data() + p * count);
+    }
+  }
+
+  // what's needed per prototype is looked up once
+  struct Column
+  {
+    size_t typeId;
+    MemoryCategory * pCategory;
+    std::vector<Component *> * pList;
+  };
+  ComponentIndex & index = ComponentIndex::getInstance();
+  std::vector<Column> columns(numberOfPrototypes);
+  for (size_t p = 0; p < numberOfPrototypes; ++p)
+  {
+    std::type_info const & type = typeid(*m_prototypes[p]);
+    Column & column = columns[p];
+    column.typeId = type.hash_code();
+    column.pCategory = &MemoryStats::getInstance().getComponentType(type);
+    column.pList = &index.getList(column.typeId);
+    column.pList->reserve(column.pList->size() + count);
+  }
+
+  roots.reserve(roots.size() + count);
+  if (pParent != nullptr)
+  {
+    pParent->m_impl->m_children.reserve(
+        pParent->m_impl->m_children.size() + count);
+  }
+
+  // one instance at a time, so its objects and components are still in the
+  // cache for every step
+  std::vector<SceneObject *> objects(numberOfNodes);
+  for (size_t instance = 0; instance < count; ++instance)
+  {
+    SceneObject::Impl::createObjects(numberOfNodes, objects.data());
+
+    // link the hierarchy, parents always precede their children
+    for (size_t i = 0; i < numberOfNodes; ++i)
+    {
+      Node const & node = m_nodes[i];
+      SceneObject::Impl & impl = *objects[i]->m_impl;
+      impl.m_isEnabled = node.isEnabled;
+      impl.m_children.reserve(node.numberOfChildren);
+      SceneObject * pObjectParent = i > 0 ? objects[node.parent] : pParent;
+      if (pObjectParent != nullptr)
+      {
+        impl.m_parent = pObjectParent;
+        pObjectParent->m_impl->m_children.push_back(objects[i]);
+      }
+    }
+    roots.push_back(objects[0]);
+
+    // components last, so they see their final place in the hierarchy
+    for (size_t i = 0; i < numberOfNodes; ++i)
+    {
+      Node const & node = m_nodes[i];
+      SceneObject::Impl & impl = *objects[i]->m_impl;
+      for (uint32_t c = 0; c < node.numberOfComponents; ++c)
+      {
+        size_t const p = node.firstComponent + c;
+        Component const & prototype = *m_prototypes[p];
+        Component * pComponent = nullptr;
+        if (m_blockSizes[p] > 0)
+        {
+          pComponent = prototype.cloneInto(blocks[p * count + instance]);
+          pComponent->m_allocationSize = m_blockSizes[p];
+        }
+        else
+        {
+          pComponent = prototype.clone();
+        }
+        pComponent->m_isEnabled = prototype.m_isEnabled;
+        pComponent->m_updateFrequency = prototype.m_updateFrequency;
+        pComponent->m_sceneObject = objects[i];
+        pComponent->m_memoryCategory = columns[p].pCategory;
+        impl.m_components.push_back(
+            std::make_pair(columns[p].typeId, pComponent));
+        ComponentIndex::attach(*pComponent, columns[p].typeId,
+                               *columns[p].pList);
+        if (pComponent->m_updateFrequency > 0.0)
+        {
+          pComponent->updateSchedulerRegistration();
+        }
+      }
+      impl.updateMemoryUsage();
+    }
+
+    // the instance is complete, notify once per object and component
+    for (size_t i = 0; i < numberOfNodes; ++i)
+    {
+      index.onObjectChanged(*objects[i]);
+      for (auto const & component : objects[i]->m_impl->m_components)
+      {
+        component.second->onActivationChanged();
+      }
+    }
+  }
+
+  for (size_t p = 0; p < numberOfPrototypes; ++p)
+  {
+    columns[p].pCategory->recordAllocations(
+        count, count * m_prototypes[p]->getAllocationSize());
+  }
+  if (pParent != nullptr)
+  {
+    SceneVersions::markStructureChanged(*pParent);
+    pParent->m_impl->updateMemoryUsage();
+  }
+}
+
+size_t Prefab::Impl::getBlockSize(Component const & prototype)
+{
+  size_t const size = prototype.getAllocationSize();
+  if (size == 0)
+    return 0;
+  void * pMemory = Component::operator new(size);
+  Component * pCopy = prototype.cloneInto(pMemory);
+  if (pCopy == nullptr)
+  {
+    Component::operator delete(pMemory, size);
+    return 0;
+  }
+  delete pCopy;
+  return size;
+}
+
+bool Prefab::Impl::captureNode(SceneObject const & object, uint32_t parent)
+{
+  SceneObject::Impl const & impl = *object.m_impl;
+  uint32_t const index = static_cast<uint32_t>(m_nodes.size());
+  Node node;
+  node.parent = parent;
+  node.numberOfChildren = static_cast<uint32_t>(impl.m_children.size());
+  node.firstComponent = static_cast<uint32_t>(m_prototypes.size());
+  node.numberOfComponents = static_cast<uint32_t>(impl.m_components.size());
+  node.isEnabled = impl.m_isEnabled;
+  m_nodes.push_back(node);
+
+  for (auto const & component : impl.m_components)
+  {
+    Component * pPrototype = component.second->clone();
+    if (pPrototype == nullptr)
+      return false;
+    pPrototype->setEnabled(component.second->isEnabled());
+    pPrototype->setUpdateFrequency(component.second->getUpdateFrequency());
+    m_prototypes.push_back(pPrototype);
+    m_blockSizes.push_back(getBlockSize(*pPrototype));
+  }
+  for (SceneObject const * pChild : impl.m_children)
+  {
+    if (!captureNode(*pChild, index))
+      return false;
+  }
+  return true;
+}
+
+void Prefab::Impl::clear()
+{
+  for (Component * pPrototype : m_prototypes)
+  {
+    delete pPrototype;
+  }
+  m_prototypes.clear();
+  m_blockSizes.clear();
+  m_nodes.clear();
+}
+
+/******************** Impl end *************************************/
+
+Prefab::Prefab() : m_impl(new Impl()) {}
+
+Prefab::~Prefab() = default;
+
+bool Prefab::capture(SceneObject const & root) { return m_impl->capture(root); }
+
+bool Prefab::isEmpty() const { return m_impl->isEmpty(); }
+
+size_t Prefab::getNumberOfObjects() const
+{
+  return m_impl->getNumberOfObjects();
+}
+
+size_t Prefab::getNumberOfComponents() const
+{
+  return m_impl->getNumberOfComponents();
+}
+
+SceneObject * Prefab::instantiate(SceneObject * pParent) const
+{
+  std::vector<SceneObject *> roots;
+  m_impl->instantiate(1, roots, pParent);
+  return roots.empty() ? nullptr : roots.front();
+}
+
+void Prefab::instantiate(size_t count, std::vector<SceneObject *> & roots,
+                         SceneObject * pParent) const
+{
+  m_impl->instantiate(count, roots, pParent);
+}
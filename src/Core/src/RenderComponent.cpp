@@ -0,0 +1,122 @@
+#include "Core/RenderComponent.h"
+#include "Core/RenderWorld.h"
+#include <cstring>
+
+RenderComponent::RenderComponent()
+    : m_slot(RenderWorld::getInstance().createItem())
+{
+}
+
+RenderComponent::~RenderComponent()
+{
+  RenderWorld::getInstance().destroyItem(m_slot);
+}
+
+Component * RenderComponent::clone() const
+{
+  RenderComponent * pCopy = new RenderComponent();
+  DrawItem & item = RenderWorld::getInstance().editItem(pCopy->m_slot);
+  item = RenderWorld::getInstance().getItem(m_slot);
+  item.isVisible = false; // until the copy is attached
+  return pCopy;
+}
+
+size_t RenderComponent::getStateSize() const { return sizeof(DrawItem); }
+
+void RenderComponent::saveState(void * pState) const
+{
+  std::memcpy(pState, &RenderWorld::getInstance().getItem(m_slot),
+              sizeof(DrawItem));
+}
+
+void RenderComponent::loadState(void const * pState)
+{
+  // the visibility follows the activation, which is restored on its own
+  DrawItem & item = RenderWorld::getInstance().editItem(m_slot);
+  bool const isVisible = item.isVisible;
+  std::memcpy(&item, pState, sizeof(DrawItem));
+  item.isVisible = isVisible;
+}
+
+void RenderComponent::setPosition(Vector2 const & position)
+{
+  markStateChanged();
+  DrawItem & item = RenderWorld::getInstance().editItem(m_slot);
+  item.positionX = position.x();
+  item.positionY = position.y();
+}
+
+Vector2 RenderComponent::getPosition() const
+{
+  DrawItem const & item = RenderWorld::getInstance().getItem(m_slot);
+  return Vector2(item.positionX, item.positionY);
+}
+
+void RenderComponent::setRotation(float rotation)
+{
+  markStateChanged();
+  RenderWorld::getInstance().editItem(m_slot).rotation = rotation;
+}
+
+float RenderComponent::getRotation() const
+{
+  return RenderWorld::getInstance().getItem(m_slot).rotation;
+}
+
+void RenderComponent::setScale(Vector2 const & scale)
+{
+  markStateChanged();
+  DrawItem & item = RenderWorld::getInstance().editItem(m_slot);
+  item.scaleX = scale.x();
+  item.scaleY = scale.y();
+}
+
+Vector2 RenderComponent::getScale() const
+{
+  DrawItem const & item = RenderWorld::getInstance().getItem(m_slot);
+  return Vector2(item.scaleX, item.scaleY);
+}
+
+void RenderComponent::setSprite(uint64_t spriteId)
+{
+  markStateChanged();
+  RenderWorld::getInstance().editItem(m_slot).spriteId = spriteId;
+}
+
+uint64_t RenderComponent::getSprite() const
+{
+  return RenderWorld::getInstance().getItem(m_slot).spriteId;
+}
+
+void RenderComponent::setColor(uint32_t color)
+{
+  markStateChanged();
+  RenderWorld::getInstance().editItem(m_slot).color = color;
+}
+
+uint32_t RenderComponent::getColor() const
+{
+  return RenderWorld::getInstance().getItem(m_slot).color;
+}
+
+void RenderComponent::setLayer(int32_t layer)
+{
+  markStateChanged();
+  RenderWorld::getInstance().editItem(m_slot).layer = layer;
+}
+
+int32_t RenderComponent::getLayer() const
+{
+  return RenderWorld::getInstance().getItem(m_slot).layer;
+}
+
+uint32_t RenderComponent::getSlot() const { return m_slot; }
+
+void RenderComponent::onActivationChanged()
+{
+  bool const isVisible = isActive();
+  if (RenderWorld::getInstance().getItem(m_slot).isVisible != isVisible)
+  {
+    RenderWorld::getInstance().editItem(m_slot).isVisible = isVisible;
+  }
+}
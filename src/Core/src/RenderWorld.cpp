@@ -0,0 +1,95 @@
+#include "Core/RenderWorld.h"
+
+namespace
+{
+
+uint8_t const ALL_BUFFERS = (1u << RenderWorld::NUMBER_OF_BUFFERS) - 1u;
+
+} // namespace
+
+RenderWorld & RenderWorld::getInstance()
+{
+  static RenderWorld instance;
+  return instance;
+}
+
+RenderWorld::RenderWorld() = default;
+
+uint32_t RenderWorld::createItem()
+{
+  uint32_t slot = 0;
+  if (m_freeSlots.empty())
+  {
+    slot = static_cast<uint32_t>(m_items.size());
+    m_items.emplace_back();
+    m_dirtyMasks.push_back(0);
+  }
+  else
+  {
+    slot = m_freeSlots.back();
+    m_freeSlots.pop_back();
+  }
+  // a fresh item must reach both buffers even if it's never changed
+  editItem(slot) = DrawItem();
+  return slot;
+}
+
+void RenderWorld::destroyItem(uint32_t slot)
+{
+  // a reused slot is marked dirty again, so it can be recycled right away
+  editItem(slot).isVisible = false;
+  m_freeSlots.push_back(slot);
+}
+
+DrawItem & RenderWorld::editItem(uint32_t slot)
+{
+  if (m_dirtyMasks[slot] == 0)
+  {
+    m_dirtySlots.push_back(slot);
+  }
+  m_dirtyMasks[slot] = ALL_BUFFERS;
+  return m_items[slot];
+}
+
+DrawItem const & RenderWorld::getItem(uint32_t slot) const
+{
+  return m_items[slot];
+}
+
+void RenderWorld::markAllDirty()
+{
+  for (uint32_t slot = 0; slot < m_items.size(); ++slot)
+  {
+    editItem(slot);
+  }
+}
+
+size_t RenderWorld::getNumberOfSlots() const { return m_items.size(); }
+
+size_t RenderWorld::extract(RenderSnapshot & snapshot, size_t bufferIndex)
+{
+  uint8_t const bufferBit = static_cast<uint8_t>(1u << bufferIndex);
+  if (snapshot.items.size() < m_items.size())
+  {
+    snapshot.items.resize(m_items.size());
+  }
+  size_t numberOfCopies = 0;
+  size_t numberOfPending = 0;
+  for (uint32_t slot : m_dirtySlots)
+  {
+    uint8_t & mask = m_dirtyMasks[slot];
+    if ((mask & bufferBit) != 0)
+    {
+      snapshot.items[slot] = m_items[slot];
+      mask &= static_cast<uint8_t>(~bufferBit);
+      ++numberOfCopies;
+    }
+    // keep the slot listed until every buffer has seen the change
+    if (mask != 0)
+    {
+      m_dirtySlots[numberOfPending++] = slot;
+    }
+  }
+  m_dirtySlots.resize(numberOfPending);
+  return numberOfCopies;
+}
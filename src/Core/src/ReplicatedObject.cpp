@@ -0,0 +1,19 @@
+#include "Core/ReplicatedObject.h"
+
+namespace
+{
+
+/** The last network id that was assigned, zero is never used. */
+uint32_t lastNetworkId = 0;
+
+} // namespace
+
+ReplicatedObject::ReplicatedObject() : m_networkId(++lastNetworkId) {}
+
+ReplicatedObject::~ReplicatedObject() = default;
+
+Component * ReplicatedObject::clone() const { return new ReplicatedObject(); }
+
+uint32_t ReplicatedObject::getNetworkId() const { return m_networkId; }
+
+bool ReplicatedObject::isReplica() const { return m_isReplica; }
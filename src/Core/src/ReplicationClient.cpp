@@ -0,0 +1,255 @@
+#include "Core/ReplicationClient.h"
+#include "Core/ReplicatedObject.h"
+#include "Core/ReplicationTransport.h"
+#include "Core/SceneObject.h"
+#include "ReplicationSnapshot.h"
+#include <algorithm>
+#include <bit>
+#include <unordered_map>
+
+/********** Impl start ************/
+
+class ReplicationClient::Impl final
+{
+public:
+  explicit Impl(SceneObject * pRoot);
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  bool decode(uint8_t const * pData, size_t size);
+
+  uint32_t getSequence() const;
+
+  void update(ReplicationTransport & transport);
+
+  SceneObject * getObject(uint32_t networkId) const;
+
+  size_t getNumberOfObjects() const;
+
+private:
+  struct Replica
+  {
+    SceneObject * pObject;
+
+    uint32_t typeMask;
+
+    /** The component of every registered type in the mask. */
+    Component * components[ReplicationRegistry::MAXIMUM_TYPES];
+  };
+
+  /** Creates the replica of the object with the components of the mask. */
+  Replica createReplica(uint32_t networkId, uint32_t typeMask);
+
+  /** Sets all fields of the replica to the values of the snapshot. */
+  void applyValues(Replica const & replica, uint32_t const * pValues) const;
+
+  SceneObject * m_root;
+
+  /** The last snapshots, indexed by sequence modulo the history size. */
+  ReplicationSnapshot m_snapshots[SNAPSHOT_HISTORY]{};
+
+  uint32_t m_sequence{NO_BASELINE};
+
+  std::unordered_map<uint32_t, Replica> m_replicas{};
+
+  std::vector<uint32_t> m_changedObjects{};
+
+  std::vector<uint32_t> m_removedIds{};
+
+  std::vector<uint8_t> m_packet{};
+};
+
+ReplicationClient::Impl::Impl(SceneObject * pRoot) : m_root(pRoot) {}
+
+ReplicationClient::Impl::~Impl() = default;
+
+bool ReplicationClient::Impl::decode(uint8_t const * pData, size_t size)
+{
+  uint32_t sequence = NO_BASELINE;
+  uint32_t baseline = NO_BASELINE;
+  if (!decodeSequences(pData, size, sequence, baseline) ||
+      sequence <= m_sequence ||
+      (baseline != NO_BASELINE &&
+       (baseline >= sequence || sequence - baseline >= SNAPSHOT_HISTORY)))
+  {
+    return false;
+  }
+
+  ReplicationSnapshot & snapshot = m_snapshots[sequence % SNAPSHOT_HISTORY];
+  if (!decodeSnapshot(pData, size,
+                      baseline != NO_BASELINE
+                          ? &m_snapshots[baseline % SNAPSHOT_HISTORY]
+                          : nullptr,
+                      snapshot, m_changedObjects, m_removedIds))
+  {
+    snapshot.sequence = NO_BASELINE;
+    return false;
+  }
+  m_sequence = sequence;
+
+  if (baseline == NO_BASELINE)
+  {
+    // a full state lists no removals, objects that were removed while the
+    // client had no acked baseline are just missing
+    for (auto const & replica : m_replicas)
+    {
+      auto const found = std::lower_bound(
+          snapshot.objects.begin(), snapshot.objects.end(), replica.first,
+          [](SnapshotObject const & object, uint32_t networkId)
+          { return object.networkId < networkId; });
+      if (found == snapshot.objects.end() || found->networkId != replica.first)
+      {
+        m_removedIds.push_back(replica.first);
+      }
+    }
+  }
+
+  for (uint32_t networkId : m_removedIds)
+  {
+    auto const found = m_replicas.find(networkId);
+    if (found != m_replicas.end())
+    {
+      delete found->second.pObject;
+      m_replicas.erase(found);
+    }
+  }
+
+  for (uint32_t index : m_changedObjects)
+  {
+    SnapshotObject const & object = snapshot.objects[index];
+    auto found = m_replicas.find(object.networkId);
+    if (found != m_replicas.end() && found->second.typeMask != object.typeMask)
+    {
+      // components were added or removed, the replica is created anew
+      delete found->second.pObject;
+      m_replicas.erase(found);
+      found = m_replicas.end();
+    }
+    if (found == m_replicas.end())
+    {
+      found = m_replicas
+                  .emplace(object.networkId,
+                           createReplica(object.networkId, object.typeMask))
+                  .first;
+    }
+    applyValues(found->second, snapshot.values.data() + object.firstValue);
+  }
+  return true;
+}
+
+uint32_t ReplicationClient::Impl::getSequence() const { return m_sequence; }
+
+void ReplicationClient::Impl::update(ReplicationTransport & transport)
+{
+  bool hasDecoded = false;
+  while (transport.receive(m_packet))
+  {
+    hasDecoded = decode(m_packet.data(), m_packet.size()) || hasDecoded;
+  }
+  if (hasDecoded)
+  {
+    BitWriter writer(m_packet);
+    writer.write(m_sequence, 32);
+    writer.flush();
+    transport.send(m_packet.data(), m_packet.size());
+  }
+}
+
+SceneObject * ReplicationClient::Impl::getObject(uint32_t networkId) const
+{
+  auto const found = m_replicas.find(networkId);
+  return found != m_replicas.end() ? found->second.pObject : nullptr;
+}
+
+size_t ReplicationClient::Impl::getNumberOfObjects() const
+{
+  return m_replicas.size();
+}
+
+ReplicationClient::Impl::Replica
+ReplicationClient::Impl::createReplica(uint32_t networkId, uint32_t typeMask)
+{
+  ReplicationRegistry const & registry = ReplicationRegistry::getInstance();
+  Replica replica{new SceneObject(), typeMask, {}};
+  ReplicatedObject * pReplicated = new ReplicatedObject();
+  pReplicated->m_networkId = networkId;
+  pReplicated->m_isReplica = true;
+  replica.pObject->addComponent(pReplicated);
+  for (uint32_t mask = typeMask; mask != 0; mask &= mask - 1)
+  {
+    size_t const t = static_cast<size_t>(std::countr_zero(mask));
+    Component * pComponent = registry.getType(t).create();
+    if (!replica.pObject->addComponent(pComponent))
+    {
+      delete pComponent;
+      pComponent = nullptr;
+    }
+    replica.components[t] = pComponent;
+  }
+  if (m_root != nullptr)
+  {
+    m_root->addChild(replica.pObject);
+  }
+  return replica;
+}
+
+void ReplicationClient::Impl::applyValues(Replica const & replica,
+                                          uint32_t const * pValues) const
+{
+  ReplicationRegistry const & registry = ReplicationRegistry::getInstance();
+  for (uint32_t mask = replica.typeMask; mask != 0; mask &= mask - 1)
+  {
+    size_t const t = static_cast<size_t>(std::countr_zero(mask));
+    ReplicatedType const & type = registry.getType(t);
+    Component * pComponent = replica.components[t];
+    for (size_t f = 0; f < type.getNumberOfFields(); ++f, ++pValues)
+    {
+      if (pComponent != nullptr)
+      {
+        applyField(type.getField(f), *pComponent, *pValues);
+      }
+    }
+  }
+}
+
+/******************** Impl end *************************************/
+
+ReplicationClient::ReplicationClient(SceneObject * pRoot)
+    : m_impl(new Impl(pRoot))
+{
+}
+
+ReplicationClient::~ReplicationClient() = default;
+
+bool ReplicationClient::decode(uint8_t const * pData, size_t size)
+{
+  return m_impl->decode(pData, size);
+}
+
+uint32_t ReplicationClient::getSequence() const
+{
+  return m_impl->getSequence();
+}
+
+void ReplicationClient::update(ReplicationTransport & transport)
+{
+  m_impl->update(transport);
+}
+
+SceneObject * ReplicationClient::getObject(uint32_t networkId) const
+{
+  return m_impl->getObject(networkId);
+}
+
+size_t ReplicationClient::getNumberOfObjects() const
+{
+  return m_impl->getNumberOfObjects();
+}
@@ -0,0 +1,205 @@
+#include "Core/ReplicationRegistry.h"
+#include <algorithm>
+#include <cmath>
+#include <typeindex>
+
+ReplicatedType::ReplicatedType(std::type_info const & type,
+                               CreateFunction create)
+    : m_type(&type), m_create(create)
+{
+}
+
+ReplicatedType & ReplicatedType::addFloat(ReplicatedField::FloatGetter get,
+                                          ReplicatedField::FloatSetter set)
+{
+  ReplicatedField field;
+  field.type = FIELD_FLOAT;
+  field.numberOfBits = 32;
+  field.getFloat = get;
+  field.setFloat = set;
+  m_fields.push_back(field);
+  return *this;
+}
+
+ReplicatedType & ReplicatedType::addFloat(ReplicatedField::FloatGetter get,
+                                          ReplicatedField::FloatSetter set,
+                                          float minimum, float maximum,
+                                          float precision)
+{
+  // the number of steps of the given precision that cover the range
+  double const steps =
+      std::ceil((static_cast<double>(maximum) - minimum) / precision);
+  uint32_t numberOfBits = 1;
+  while (numberOfBits < 32 && std::ldexp(1.0, numberOfBits) <= steps)
+  {
+    ++numberOfBits;
+  }
+
+  ReplicatedField field;
+  field.type = FIELD_QUANTIZED_FLOAT;
+  field.numberOfBits = numberOfBits;
+  field.minimum = minimum;
+  field.maximum = std::max(maximum, minimum);
+  field.getFloat = get;
+  field.setFloat = set;
+  m_fields.push_back(field);
+  return *this;
+}
+
+ReplicatedType & ReplicatedType::addAngle(ReplicatedField::FloatGetter get,
+                                          ReplicatedField::FloatSetter set,
+                                          uint32_t numberOfBits)
+{
+  ReplicatedField field;
+  field.type = FIELD_ANGLE;
+  field.numberOfBits = std::clamp(numberOfBits, 1u, 32u);
+  field.getFloat = get;
+  field.setFloat = set;
+  m_fields.push_back(field);
+  return *this;
+}
+
+ReplicatedType &
+ReplicatedType::addInteger(ReplicatedField::IntegerGetter get,
+                           ReplicatedField::IntegerSetter set,
+                           uint32_t numberOfBits)
+{
+  ReplicatedField field;
+  field.type = FIELD_INTEGER;
+  field.numberOfBits = std::clamp(numberOfBits, 1u, 32u);
+  field.getInteger = get;
+  field.setInteger = set;
+  m_fields.push_back(field);
+  return *this;
+}
+
+ReplicatedType & ReplicatedType::addBool(ReplicatedField::IntegerGetter get,
+                                         ReplicatedField::IntegerSetter set)
+{
+  ReplicatedField field;
+  field.type = FIELD_BOOL;
+  field.numberOfBits = 1;
+  field.getInteger = get;
+  field.setInteger = set;
+  m_fields.push_back(field);
+  return *this;
+}
+
+std::type_info const & ReplicatedType::getType() const { return *m_type; }
+
+Component * ReplicatedType::create() const { return m_create(); }
+
+size_t ReplicatedType::getNumberOfFields() const { return m_fields.size(); }
+
+ReplicatedField const & ReplicatedType::getField(size_t index) const
+{
+  return m_fields[index];
+}
+
+/********** Impl start ************/
+
+class ReplicationRegistry::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  ReplicatedType * registerType(std::type_info const & type,
+                                ReplicatedType::CreateFunction create);
+
+  size_t getNumberOfTypes() const;
+
+  ReplicatedType const & getType(size_t index) const;
+
+  size_t findType(std::type_info const & type) const;
+
+private:
+  /** The types in the order of registration, which is their index. */
+  std::vector<std::unique_ptr<ReplicatedType>> m_types{};
+};
+
+ReplicationRegistry::Impl::Impl() = default;
+
+ReplicationRegistry::Impl::~Impl() = default;
+
+ReplicatedType *
+ReplicationRegistry::Impl::registerType(std::type_info const & type,
+                                        ReplicatedType::CreateFunction create)
+{
+  size_t const index = findType(type);
+  if (index != INVALID_TYPE)
+  {
+    return m_types[index].get();
+  }
+  if (m_types.size() == MAXIMUM_TYPES)
+  {
+    return nullptr;
+  }
+  m_types.emplace_back(new ReplicatedType(type, create));
+  return m_types.back().get();
+}
+
+size_t ReplicationRegistry::Impl::getNumberOfTypes() const
+{
+  return m_types.size();
+}
+
+ReplicatedType const & ReplicationRegistry::Impl::getType(size_t index) const
+{
+  return *m_types[index];
+}
+
+size_t ReplicationRegistry::Impl::findType(std::type_info const & type) const
+{
+  for (size_t i = 0; i < m_types.size(); ++i)
+  {
+    if (std::type_index(m_types[i]->getType()) == std::type_index(type))
+    {
+      return i;
+    }
+  }
+  return INVALID_TYPE;
+}
+
+/******************** Impl end *************************************/
+
+ReplicationRegistry & ReplicationRegistry::getInstance()
+{
+  static ReplicationRegistry instance;
+  return instance;
+}
+
+ReplicationRegistry::ReplicationRegistry() : m_impl(new Impl()) {}
+
+ReplicationRegistry::~ReplicationRegistry() = default;
+
+ReplicatedType *
+ReplicationRegistry::registerType(std::type_info const & type,
+                                  ReplicatedType::CreateFunction create)
+{
+  return m_impl->registerType(type, create);
+}
+
+size_t ReplicationRegistry::getNumberOfTypes() const
+{
+  return m_impl->getNumberOfTypes();
+}
+
+ReplicatedType const & ReplicationRegistry::getType(size_t index) const
+{
+  return m_impl->getType(index);
+}
+
+size_t ReplicationRegistry::findType(std::type_info const & type) const
+{
+  return m_impl->findType(type);
+}
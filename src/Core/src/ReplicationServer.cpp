@@ -0,0 +1,344 @@
+#include "Core/ReplicationServer.h"
+#include "Core/ComponentQuery.h"
+#include "Core/JobSystem.h"
+#include "Core/ReplicatedObject.h"
+#include "Core/ReplicationTransport.h"
+#include "Core/SceneObject.h"
+#include "ReplicationSnapshot.h"
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+
+/** Objects per capture job. */
+size_t const CAPTURE_GRAIN = 512;
+
+} // namespace
+
+/********** Impl start ************/
+
+class ReplicationServer::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  uint32_t captureSnapshot();
+
+  uint32_t getSequence() const;
+
+  size_t getNumberOfObjects() const;
+
+  uint32_t addClient(ReplicationTransport * pTransport);
+
+  void removeClient(uint32_t client);
+
+  void acknowledge(uint32_t client, uint32_t sequence);
+
+  uint32_t getAcknowledged(uint32_t client) const;
+
+  void encode(uint32_t client, std::vector<uint8_t> & packet) const;
+
+  void update();
+
+private:
+  struct Client
+  {
+    ReplicationTransport * pTransport;
+
+    /** The sequence of the baseline or NO_BASELINE. */
+    uint32_t acknowledged;
+
+    bool isUsed;
+
+    /** The packet of the last update. */
+    std::vector<uint8_t> packet;
+  };
+
+  /** A replicated object in the order of the snapshot. */
+  struct Entry
+  {
+    uint32_t networkId;
+
+    /** The match of the object in the query. */
+    uint32_t match;
+  };
+
+  /** All objects with an active replicated object component. */
+  ComponentQuery m_query{};
+
+  /** The last snapshots, indexed by sequence modulo the history size. */
+  ReplicationSnapshot m_snapshots[SNAPSHOT_HISTORY]{};
+
+  uint32_t m_sequence{NO_BASELINE};
+
+  std::vector<Client> m_clients{};
+
+  std::vector<Entry> m_entries{};
+
+  /** The components of every registered type of the captured objects. */
+  std::vector<Component *> m_components{};
+
+  std::vector<uint8_t> m_acknowledgement{};
+};
+
+ReplicationServer::Impl::Impl() { m_query.require<ReplicatedObject>(); }
+
+ReplicationServer::Impl::~Impl() = default;
+
+uint32_t ReplicationServer::Impl::captureSnapshot()
+{
+  ReplicationRegistry const & registry = ReplicationRegistry::getInstance();
+  size_t const numberOfTypes = registry.getNumberOfTypes();
+  uint32_t numberOfFields[ReplicationRegistry::MAXIMUM_TYPES];
+  for (size_t t = 0; t < numberOfTypes; ++t)
+  {
+    numberOfFields[t] =
+        static_cast<uint32_t>(registry.getType(t).getNumberOfFields());
+  }
+
+  // replicas of other servers' objects in the same process are skipped
+  m_entries.clear();
+  for (size_t i = 0; i < m_query.getNumberOfObjects(); ++i)
+  {
+    ReplicatedObject const * pReplicated =
+        m_query.getComponent<ReplicatedObject>(i, 0);
+    if (!pReplicated->isReplica())
+    {
+      m_entries.push_back(
+          Entry{pReplicated->getNetworkId(), static_cast<uint32_t>(i)});
+    }
+  }
+  std::sort(m_entries.begin(), m_entries.end(),
+            [](Entry const & a, Entry const & b) {
+              return a.networkId < b.networkId;
+            });
+
+  ++m_sequence;
+  if (m_sequence == NO_BASELINE)
+  {
+    m_sequence = 1;
+  }
+  ReplicationSnapshot & snapshot = m_snapshots[m_sequence % SNAPSHOT_HISTORY];
+  snapshot.sequence = m_sequence;
+  snapshot.objects.resize(m_entries.size());
+  m_components.resize(m_entries.size() * numberOfTypes);
+
+  // look up the components and their types
+  JobSystem::getInstance().parallelFor(
+      m_entries.size(), CAPTURE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t o = begin; o < end; ++o)
+        {
+          SceneObject * pObject = m_query.getObject(m_entries[o].match);
+          Component ** ppComponents = m_components.data() + o * numberOfTypes;
+          SnapshotObject & object = snapshot.objects[o];
+          object.networkId = m_entries[o].networkId;
+          object.typeMask = 0;
+          object.numberOfValues = 0;
+          for (size_t t = 0; t < numberOfTypes; ++t)
+          {
+            Component * pComponent =
+                pObject->getComponent(registry.getType(t).getType());
+            if (pComponent != nullptr && pComponent->isActive())
+            {
+              object.typeMask |= 1u << t;
+              object.numberOfValues += numberOfFields[t];
+            }
+            ppComponents[t] = pComponent;
+          }
+        }
+      });
+
+  uint32_t numberOfValues = 0;
+  for (SnapshotObject & object : snapshot.objects)
+  {
+    object.firstValue = numberOfValues;
+    numberOfValues += object.numberOfValues;
+  }
+  snapshot.values.resize(numberOfValues);
+
+  // quantize the fields
+  JobSystem::getInstance().parallelFor(
+      m_entries.size(), CAPTURE_GRAIN, [&](size_t begin, size_t end) {
+        for (size_t o = begin; o < end; ++o)
+        {
+          SnapshotObject const & object = snapshot.objects[o];
+          Component * const * ppComponents =
+              m_components.data() + o * numberOfTypes;
+          uint32_t * pValues = snapshot.values.data() + object.firstValue;
+          for (uint32_t mask = object.typeMask; mask != 0; mask &= mask - 1)
+          {
+            size_t const t = static_cast<size_t>(std::countr_zero(mask));
+            ReplicatedType const & type = registry.getType(t);
+            for (size_t f = 0; f < numberOfFields[t]; ++f)
+            {
+              *pValues++ = quantizeField(type.getField(f), *ppComponents[t]);
+            }
+          }
+        }
+      });
+  return m_sequence;
+}
+
+uint32_t ReplicationServer::Impl::getSequence() const { return m_sequence; }
+
+size_t ReplicationServer::Impl::getNumberOfObjects() const
+{
+  return m_sequence != NO_BASELINE
+             ? m_snapshots[m_sequence % SNAPSHOT_HISTORY].objects.size()
+             : 0;
+}
+
+uint32_t ReplicationServer::Impl::addClient(ReplicationTransport * pTransport)
+{
+  Client client{pTransport, NO_BASELINE, true, {}};
+  for (size_t i = 0; i < m_clients.size(); ++i)
+  {
+    if (!m_clients[i].isUsed)
+    {
+      m_clients[i] = client;
+      return static_cast<uint32_t>(i);
+    }
+  }
+  m_clients.push_back(client);
+  return static_cast<uint32_t>(m_clients.size() - 1);
+}
+
+void ReplicationServer::Impl::removeClient(uint32_t client)
+{
+  m_clients[client] = Client{nullptr, NO_BASELINE, false, {}};
+}
+
+void ReplicationServer::Impl::acknowledge(uint32_t client, uint32_t sequence)
+{
+  // acknowledgements may arrive out of order
+  Client & target = m_clients[client];
+  if (sequence != NO_BASELINE && sequence <= m_sequence &&
+      sequence > target.acknowledged)
+  {
+    target.acknowledged = sequence;
+  }
+}
+
+uint32_t ReplicationServer::Impl::getAcknowledged(uint32_t client) const
+{
+  return m_clients[client].acknowledged;
+}
+
+void ReplicationServer::Impl::encode(uint32_t client,
+                                     std::vector<uint8_t> & packet) const
+{
+  if (m_sequence == NO_BASELINE)
+  {
+    packet.clear();
+    return;
+  }
+  uint32_t const acknowledged = m_clients[client].acknowledged;
+  ReplicationSnapshot const & baseline =
+      m_snapshots[acknowledged % SNAPSHOT_HISTORY];
+  bool const hasBaseline = acknowledged != NO_BASELINE &&
+                           m_sequence - acknowledged < SNAPSHOT_HISTORY &&
+                           baseline.sequence == acknowledged;
+  encodeSnapshot(m_snapshots[m_sequence % SNAPSHOT_HISTORY],
+                 hasBaseline ? &baseline : nullptr, packet);
+}
+
+void ReplicationServer::Impl::update()
+{
+  for (size_t c = 0; c < m_clients.size(); ++c)
+  {
+    Client const & client = m_clients[c];
+    if (!client.isUsed || client.pTransport == nullptr)
+    {
+      continue;
+    }
+    while (client.pTransport->receive(m_acknowledgement))
+    {
+      BitReader reader(m_acknowledgement.data(), m_acknowledgement.size());
+      uint32_t sequence = NO_BASELINE;
+      if (reader.read(32, sequence))
+      {
+        acknowledge(static_cast<uint32_t>(c), sequence);
+      }
+    }
+  }
+
+  JobSystem::getInstance().parallelFor(
+      m_clients.size(), 1, [this](size_t begin, size_t end) {
+        for (size_t c = begin; c < end; ++c)
+        {
+          if (m_clients[c].isUsed && m_clients[c].pTransport != nullptr)
+          {
+            encode(static_cast<uint32_t>(c), m_clients[c].packet);
+          }
+        }
+      });
+
+  for (Client & client : m_clients)
+  {
+    if (client.isUsed && client.pTransport != nullptr &&
+        !client.packet.empty())
+    {
+      client.pTransport->send(client.packet.data(), client.packet.size());
+    }
+  }
+}
+
+/******************** Impl end *************************************/
+
+ReplicationServer::ReplicationServer() : m_impl(new Impl()) {}
+
+ReplicationServer::~ReplicationServer() = default;
+
+uint32_t ReplicationServer::captureSnapshot()
+{
+  return m_impl->captureSnapshot();
+}
+
+uint32_t ReplicationServer::getSequence() const
+{
+  return m_impl->getSequence();
+}
+
+size_t ReplicationServer::getNumberOfObjects() const
+{
+  return m_impl->getNumberOfObjects();
+}
+
+uint32_t ReplicationServer::addClient(ReplicationTransport * pTransport)
+{
+  return m_impl->addClient(pTransport);
+}
+
+void ReplicationServer::removeClient(uint32_t client)
+{
+  m_impl->removeClient(client);
+}
+
+void ReplicationServer::acknowledge(uint32_t client, uint32_t sequence)
+{
+  m_impl->acknowledge(client, sequence);
+}
+
+uint32_t ReplicationServer::getAcknowledged(uint32_t client) const
+{
+  return m_impl->getAcknowledged(client);
+}
+
+void ReplicationServer::encode(uint32_t client,
+                               std::vector<uint8_t> & packet) const
+{
+  m_impl->encode(client, packet);
+}
+
+void ReplicationServer::update() { m_impl->update(); }
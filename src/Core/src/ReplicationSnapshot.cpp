@@ -0,0 +1,526 @@
+#include "ReplicationSnapshot.h"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+
+double const TWO_PI = 6.283185307179586;
+
+/** Changes of at most this many bits after zigzag encoding are small. */
+uint32_t const SMALL_CHANGE_BITS = 7;
+
+/** The bits of the number of registered types in the packet header. */
+uint32_t const TYPE_COUNT_BITS = 6;
+
+uint32_t getBitMask(uint32_t numberOfBits)
+{
+  return numberOfBits >= 32 ? 0xffffffffu : (1u << numberOfBits) - 1;
+}
+
+/** Maps small positive and negative differences to small numbers. */
+uint32_t encodeChange(uint32_t value, uint32_t baseline)
+{
+  int32_t const difference = static_cast<int32_t>(value - baseline);
+  return (static_cast<uint32_t>(difference) << 1) ^
+         static_cast<uint32_t>(difference >> 31);
+}
+
+uint32_t decodeChange(uint32_t change, uint32_t baseline)
+{
+  uint32_t const difference = (change >> 1) ^ (0u - (change & 1));
+  return baseline + difference;
+}
+
+/** The bits of every field of the registered types. */
+struct FieldLayout
+{
+  FieldLayout()
+  {
+    ReplicationRegistry const & registry = ReplicationRegistry::getInstance();
+    numberOfTypes = static_cast<uint32_t>(registry.getNumberOfTypes());
+    for (uint32_t t = 0; t < numberOfTypes; ++t)
+    {
+      firstField[t] = static_cast<uint32_t>(bits.size());
+      ReplicatedType const & type = registry.getType(t);
+      for (size_t f = 0; f < type.getNumberOfFields(); ++f)
+      {
+        bits.push_back(type.getField(f).numberOfBits);
+      }
+    }
+    firstField[numberOfTypes] = static_cast<uint32_t>(bits.size());
+  }
+
+  /** Calls the function with the bits of all fields of the types. */
+  template <class TFunction>
+  void forEachField(uint32_t typeMask, TFunction const & function) const
+  {
+    for (uint32_t mask = typeMask; mask != 0; mask &= mask - 1)
+    {
+      uint32_t const type = static_cast<uint32_t>(std::countr_zero(mask));
+      for (uint32_t f = firstField[type]; f < firstField[type + 1]; ++f)
+      {
+        function(bits[f]);
+      }
+    }
+  }
+
+  uint32_t numberOfTypes{0};
+
+  uint32_t firstField[ReplicationRegistry::MAXIMUM_TYPES + 1]{};
+
+  std::vector<uint32_t> bits{};
+};
+
+bool haveEqualValues(ReplicationSnapshot const & a, SnapshotObject const & objectA,
+                     ReplicationSnapshot const & b, SnapshotObject const & objectB)
+{
+  return objectA.numberOfValues == objectB.numberOfValues &&
+         std::memcmp(a.values.data() + objectA.firstValue,
+                     b.values.data() + objectB.firstValue,
+                     objectA.numberOfValues * sizeof(uint32_t)) == 0;
+}
+
+} // namespace
+
+BitWriter::BitWriter(std::vector<uint8_t> & buffer) : m_buffer(buffer)
+{
+  m_buffer.clear();
+}
+
+void BitWriter::write(uint32_t value, uint32_t numberOfBits)
+{
+  m_bits |= static_cast<uint64_t>(value & getBitMask(numberOfBits))
+            << m_numberOfBits;
+  m_numberOfBits += numberOfBits;
+  while (m_numberOfBits >= 8)
+  {
+    m_buffer.push_back(static_cast<uint8_t>(m_bits));
+    m_bits >>= 8;
+    m_numberOfBits -= 8;
+  }
+}
+
+void BitWriter::writeVariable(uint32_t value)
+{
+  // a two bit prefix selects 4, 8, 16 or 32 bits
+  if (value < (1u << 4))
+  {
+    write(0, 2);
+    write(value, 4);
+  }
+  else if (value < (1u << 8))
+  {
+    write(1, 2);
+    write(value, 8);
+  }
+  else if (value < (1u << 16))
+  {
+    write(2, 2);
+    write(value, 16);
+  }
+  else
+  {
+    write(3, 2);
+    write(value, 32);
+  }
+}
+
+void BitWriter::flush()
+{
+  if (m_numberOfBits > 0)
+  {
+    m_buffer.push_back(static_cast<uint8_t>(m_bits));
+    m_bits = 0;
+    m_numberOfBits = 0;
+  }
+}
+
+BitReader::BitReader(uint8_t const * pData, size_t size)
+    : m_data(pData), m_end(pData + size)
+{
+}
+
+bool BitReader::read(uint32_t numberOfBits, uint32_t & value)
+{
+  while (m_numberOfBits < numberOfBits)
+  {
+    if (m_data == m_end)
+    {
+      return false;
+    }
+    m_bits |= static_cast<uint64_t>(*m_data++) << m_numberOfBits;
+    m_numberOfBits += 8;
+  }
+  value = static_cast<uint32_t>(m_bits) & getBitMask(numberOfBits);
+  m_bits >>= numberOfBits;
+  m_numberOfBits -= numberOfBits;
+  return true;
+}
+
+bool BitReader::readVariable(uint32_t & value)
+{
+  static uint32_t const sizes[4] = {4, 8, 16, 32};
+  uint32_t prefix = 0;
+  return read(2, prefix) && read(sizes[prefix], value);
+}
+
+uint32_t quantizeField(ReplicatedField const & field,
+                       Component const & component)
+{
+  uint32_t const mask = getBitMask(field.numberOfBits);
+  switch (field.type)
+  {
+  case FIELD_FLOAT:
+  {
+    float const value = field.getFloat(component);
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+  case FIELD_QUANTIZED_FLOAT:
+  {
+    if (field.maximum <= field.minimum)
+    {
+      return 0;
+    }
+    float const raw = field.getFloat(component);
+    // NaN would survive the clamp, non-finite values send the minimum
+    double const value = std::isfinite(raw)
+                             ? std::clamp(raw, field.minimum, field.maximum)
+                             : field.minimum;
+    double const scale = mask / (static_cast<double>(field.maximum) -
+                                 field.minimum);
+    // rounds to nearest, the value is never negative
+    return static_cast<uint32_t>((value - field.minimum) * scale + 0.5);
+  }
+  case FIELD_ANGLE:
+  {
+    float const raw = field.getFloat(component);
+    double turns = std::isfinite(raw) ? raw / TWO_PI : 0.0;
+    turns -= std::floor(turns);
+    double const steps = static_cast<double>(uint64_t(1) << field.numberOfBits);
+    return static_cast<uint32_t>(
+               static_cast<uint64_t>(turns * steps + 0.5)) &
+           mask;
+  }
+  case FIELD_INTEGER:
+  case FIELD_BOOL:
+    return field.getInteger(component) & mask;
+  }
+  return 0;
+}
+
+void applyField(ReplicatedField const & field, Component & component,
+                uint32_t value)
+{
+  switch (field.type)
+  {
+  case FIELD_FLOAT:
+  {
+    float result = 0.0f;
+    std::memcpy(&result, &value, sizeof(result));
+    field.setFloat(component, result);
+    break;
+  }
+  case FIELD_QUANTIZED_FLOAT:
+  {
+    double const step =
+        (static_cast<double>(field.maximum) - field.minimum) /
+        getBitMask(field.numberOfBits);
+    field.setFloat(component,
+                   static_cast<float>(field.minimum + value * step));
+    break;
+  }
+  case FIELD_ANGLE:
+  {
+    double angle = value * TWO_PI /
+                   static_cast<double>(uint64_t(1) << field.numberOfBits);
+    if (angle >= 0.5 * TWO_PI)
+    {
+      angle -= TWO_PI;
+    }
+    field.setFloat(component, static_cast<float>(angle));
+    break;
+  }
+  case FIELD_INTEGER:
+  case FIELD_BOOL:
+    field.setInteger(component, value);
+    break;
+  }
+}
+
+void encodeSnapshot(ReplicationSnapshot const & snapshot,
+                    ReplicationSnapshot const * pBaseline,
+                    std::vector<uint8_t> & packet)
+{
+  FieldLayout const layout;
+  BitWriter writer(packet);
+  writer.write(snapshot.sequence, 32);
+  writer.write(pBaseline != nullptr ? pBaseline->sequence : NO_BASELINE, 32);
+  writer.write(layout.numberOfTypes, TYPE_COUNT_BITS);
+
+  std::vector<SnapshotObject> const noObjects;
+  std::vector<SnapshotObject> const & baselineObjects =
+      pBaseline != nullptr ? pBaseline->objects : noObjects;
+
+  // the removed objects, both lists are sorted by id
+  uint32_t previousId = 0;
+  size_t current = 0;
+  for (SnapshotObject const & old : baselineObjects)
+  {
+    while (current < snapshot.objects.size() &&
+           snapshot.objects[current].networkId < old.networkId)
+    {
+      ++current;
+    }
+    if (current == snapshot.objects.size() ||
+        snapshot.objects[current].networkId != old.networkId)
+    {
+      writer.write(1, 1);
+      writer.writeVariable(old.networkId - previousId);
+      previousId = old.networkId;
+    }
+  }
+  writer.write(0, 1);
+
+  // the new and the changed objects
+  previousId = 0;
+  size_t baseline = 0;
+  for (SnapshotObject const & object : snapshot.objects)
+  {
+    while (baseline < baselineObjects.size() &&
+           baselineObjects[baseline].networkId < object.networkId)
+    {
+      ++baseline;
+    }
+    SnapshotObject const * pOld =
+        baseline < baselineObjects.size() &&
+                baselineObjects[baseline].networkId == object.networkId
+            ? &baselineObjects[baseline]
+            : nullptr;
+    if (pOld != nullptr && pOld->typeMask == object.typeMask &&
+        haveEqualValues(snapshot, object, *pBaseline, *pOld))
+    {
+      continue;
+    }
+
+    writer.write(1, 1);
+    writer.writeVariable(object.networkId - previousId);
+    previousId = object.networkId;
+    uint32_t const * pValues = snapshot.values.data() + object.firstValue;
+
+    if (pOld == nullptr || pOld->typeMask != object.typeMask)
+    {
+      // a new object or one that gained or lost components
+      writer.write(1, 1);
+      writer.write(object.typeMask, layout.numberOfTypes);
+      layout.forEachField(object.typeMask, [&](uint32_t numberOfBits) {
+        writer.write(*pValues++, numberOfBits);
+      });
+      continue;
+    }
+
+    writer.write(0, 1);
+    uint32_t const * pOldValues = pBaseline->values.data() + pOld->firstValue;
+    layout.forEachField(object.typeMask, [&](uint32_t numberOfBits) {
+      uint32_t const value = *pValues++;
+      uint32_t const oldValue = *pOldValues++;
+      if (value == oldValue)
+      {
+        writer.write(0, 1);
+        return;
+      }
+      writer.write(1, 1);
+      if (numberOfBits <= SMALL_CHANGE_BITS + 1)
+      {
+        writer.write(value, numberOfBits);
+        return;
+      }
+      uint32_t const change = encodeChange(value, oldValue);
+      if (change < (1u << SMALL_CHANGE_BITS))
+      {
+        writer.write(1, 1);
+        writer.write(change, SMALL_CHANGE_BITS);
+      }
+      else
+      {
+        writer.write(0, 1);
+        writer.write(value, numberOfBits);
+      }
+    });
+  }
+  writer.write(0, 1);
+  writer.flush();
+}
+
+bool decodeSequences(uint8_t const * pData, size_t size, uint32_t & sequence,
+                     uint32_t & baseline)
+{
+  BitReader reader(pData, size);
+  return reader.read(32, sequence) && reader.read(32, baseline);
+}
+
+bool decodeSnapshot(uint8_t const * pData, size_t size,
+                    ReplicationSnapshot const * pBaseline,
+                    ReplicationSnapshot & snapshot,
+                    std::vector<uint32_t> & changedObjects,
+                    std::vector<uint32_t> & removedIds)
+{
+  FieldLayout const layout;
+  BitReader reader(pData, size);
+  uint32_t sequence = 0;
+  uint32_t baselineSequence = 0;
+  uint32_t numberOfTypes = 0;
+  if (!reader.read(32, sequence) || !reader.read(32, baselineSequence) ||
+      !reader.read(TYPE_COUNT_BITS, numberOfTypes) ||
+      numberOfTypes != layout.numberOfTypes)
+  {
+    return false;
+  }
+  if (baselineSequence != NO_BASELINE &&
+      (pBaseline == nullptr || pBaseline->sequence != baselineSequence))
+  {
+    return false;
+  }
+  if (baselineSequence == NO_BASELINE)
+  {
+    pBaseline = nullptr;
+  }
+
+  snapshot.sequence = sequence;
+  snapshot.objects.clear();
+  snapshot.values.clear();
+  changedObjects.clear();
+  removedIds.clear();
+
+  uint32_t more = 0;
+  uint32_t previousId = 0;
+  while (reader.read(1, more) && more != 0)
+  {
+    uint32_t difference = 0;
+    if (!reader.readVariable(difference))
+    {
+      return false;
+    }
+    previousId += difference;
+    removedIds.push_back(previousId);
+  }
+
+  std::vector<SnapshotObject> const noObjects;
+  std::vector<SnapshotObject> const & baselineObjects =
+      pBaseline != nullptr ? pBaseline->objects : noObjects;
+  size_t baseline = 0;
+  size_t removed = 0;
+
+  // copies the unchanged objects of the baseline that come before the id
+  auto copyUnchanged = [&](uint64_t networkId) {
+    for (; baseline < baselineObjects.size() &&
+           baselineObjects[baseline].networkId < networkId;
+         ++baseline)
+    {
+      SnapshotObject const & old = baselineObjects[baseline];
+      while (removed < removedIds.size() && removedIds[removed] < old.networkId)
+      {
+        ++removed;
+      }
+      if (removed < removedIds.size() && removedIds[removed] == old.networkId)
+      {
+        continue;
+      }
+      SnapshotObject object = old;
+      object.firstValue = static_cast<uint32_t>(snapshot.values.size());
+      snapshot.values.insert(snapshot.values.end(),
+                             pBaseline->values.begin() + old.firstValue,
+                             pBaseline->values.begin() + old.firstValue +
+                                 old.numberOfValues);
+      snapshot.objects.push_back(object);
+    }
+  };
+
+  previousId = 0;
+  bool isValid = true;
+  while (isValid && reader.read(1, more) && more != 0)
+  {
+    uint32_t difference = 0;
+    uint32_t isNew = 0;
+    if (!reader.readVariable(difference) || !reader.read(1, isNew))
+    {
+      return false;
+    }
+    previousId += difference;
+    copyUnchanged(previousId);
+    SnapshotObject const * pOld =
+        baseline < baselineObjects.size() &&
+                baselineObjects[baseline].networkId == previousId
+            ? &baselineObjects[baseline++]
+            : nullptr;
+
+    SnapshotObject object;
+    object.networkId = previousId;
+    object.firstValue = static_cast<uint32_t>(snapshot.values.size());
+    if (isNew != 0)
+    {
+      if (!reader.read(layout.numberOfTypes, object.typeMask))
+      {
+        return false;
+      }
+      layout.forEachField(object.typeMask, [&](uint32_t numberOfBits) {
+        uint32_t value = 0;
+        isValid = reader.read(numberOfBits, value) && isValid;
+        snapshot.values.push_back(value);
+      });
+    }
+    else
+    {
+      if (pOld == nullptr)
+      {
+        return false;
+      }
+      object.typeMask = pOld->typeMask;
+      uint32_t const * pOldValues =
+          pBaseline->values.data() + pOld->firstValue;
+      layout.forEachField(object.typeMask, [&](uint32_t numberOfBits) {
+        uint32_t const oldValue = *pOldValues++;
+        uint32_t value = oldValue;
+        uint32_t isChanged = 0;
+        uint32_t isSmall = 0;
+        if (!reader.read(1, isChanged))
+        {
+          isValid = false;
+        }
+        else if (isChanged != 0 && numberOfBits <= SMALL_CHANGE_BITS + 1)
+        {
+          isValid = reader.read(numberOfBits, value) && isValid;
+        }
+        else if (isChanged != 0 && !reader.read(1, isSmall))
+        {
+          isValid = false;
+        }
+        else if (isChanged != 0 && isSmall != 0)
+        {
+          uint32_t change = 0;
+          isValid = reader.read(SMALL_CHANGE_BITS, change) && isValid;
+          value = decodeChange(change, oldValue) & getBitMask(numberOfBits);
+        }
+        else if (isChanged != 0)
+        {
+          isValid = reader.read(numberOfBits, value) && isValid;
+        }
+        snapshot.values.push_back(value);
+      });
+    }
+    object.numberOfValues =
+        static_cast<uint32_t>(snapshot.values.size()) - object.firstValue;
+    changedObjects.push_back(static_cast<uint32_t>(snapshot.objects.size()));
+    snapshot.objects.push_back(object);
+  }
+  if (!isValid || more != 0)
+  {
+    return false;
+  }
+  copyUnchanged(uint64_t(1) << 32);
+  return true;
+}
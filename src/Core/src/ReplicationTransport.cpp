@@ -0,0 +1,434 @@
+#include "Core/ReplicationTransport.h"
+#include <cstring>
+#include <deque>
+#include <mutex>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+
+#ifdef _WIN32
+using SocketHandle = SOCKET;
+
+SocketHandle const INVALID_HANDLE = INVALID_SOCKET;
+
+void closeSocket(SocketHandle handle) { closesocket(handle); }
+
+bool setNonBlocking(SocketHandle handle)
+{
+  u_long isNonBlocking = 1;
+  return ioctlsocket(handle, FIONBIO, &isNonBlocking) == 0;
+}
+
+/** Keeps Winsock initialized while the process runs. */
+struct Winsock
+{
+  Winsock()
+  {
+    WSADATA data;
+    WSAStartup(MAKEWORD(2, 2), &data);
+  }
+
+  ~Winsock() { WSACleanup(); }
+};
+#else
+using SocketHandle = int;
+
+SocketHandle const INVALID_HANDLE = -1;
+
+void closeSocket(SocketHandle handle) { close(handle); }
+
+bool setNonBlocking(SocketHandle handle)
+{
+  int const flags = fcntl(handle, F_GETFL, 0);
+  return flags >= 0 && fcntl(handle, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+/**
+ * Every datagram starts with the number of its packet, its index and the
+ * number of datagrams of the packet, in little endian.
+ */
+size_t const HEADER_SIZE = 8;
+
+/** The socket buffers hold the datagrams of a few large packets. */
+int const SOCKET_BUFFER_SIZE = 4 * 1024 * 1024;
+
+/** Both sides of an in-process connection, index 0 receives for a. */
+struct InProcessChannel
+{
+  std::mutex mutex{};
+  std::deque<std::vector<uint8_t>> queues[2]{};
+};
+
+void writeUint32(uint8_t * pTarget, uint32_t value)
+{
+  for (size_t i = 0; i < 4; ++i)
+  {
+    pTarget[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+uint32_t readUint32(uint8_t const * pSource)
+{
+  uint32_t value = 0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    value |= static_cast<uint32_t>(pSource[i]) << (8 * i);
+  }
+  return value;
+}
+
+} // namespace
+
+ReplicationTransport::~ReplicationTransport() = default;
+
+/********** Impl start ************/
+
+class InProcessTransport::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  bool send(uint8_t const * pData, size_t size);
+
+  bool receive(std::vector<uint8_t> & packet);
+
+  /** Shared by both endpoints, so either may be destroyed first. */
+  std::shared_ptr<InProcessChannel> m_channel{};
+
+  /** The queue of the channel this endpoint receives from. */
+  size_t m_side{0};
+};
+
+InProcessTransport::Impl::Impl() = default;
+
+InProcessTransport::Impl::~Impl() = default;
+
+bool InProcessTransport::Impl::send(uint8_t const * pData, size_t size)
+{
+  if (!m_channel)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_channel->mutex);
+  m_channel->queues[1 - m_side].emplace_back(pData, pData + size);
+  return true;
+}
+
+bool InProcessTransport::Impl::receive(std::vector<uint8_t> & packet)
+{
+  if (!m_channel)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(m_channel->mutex);
+  std::deque<std::vector<uint8_t>> & queue = m_channel->queues[m_side];
+  if (queue.empty())
+  {
+    return false;
+  }
+  packet.swap(queue.front());
+  queue.pop_front();
+  return true;
+}
+
+class UdpTransport::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  bool open(uint16_t port);
+
+  bool setPeer(char const * address, uint16_t port);
+
+  uint16_t getPort() const;
+
+  bool send(uint8_t const * pData, size_t size);
+
+  bool receive(std::vector<uint8_t> & packet);
+
+private:
+  void close();
+
+  /** Starts putting together the packet with the given datagrams. */
+  void startPacket(uint32_t packet, uint16_t numberOfDatagrams);
+
+  SocketHandle m_socket{INVALID_HANDLE};
+
+  sockaddr_in m_peer{};
+
+  bool m_hasPeer{false};
+
+  uint32_t m_nextPacket{1};
+
+  /** The packet that is being put together or zero. */
+  uint32_t m_packet{0};
+
+  std::vector<uint8_t> m_payload{};
+
+  std::vector<bool> m_isReceived{};
+
+  size_t m_numberOfReceived{0};
+
+  /** The size of the payload, known once the last datagram arrived. */
+  size_t m_size{0};
+
+  std::vector<uint8_t> m_datagram{};
+};
+
+UdpTransport::Impl::Impl() : m_datagram(HEADER_SIZE + MAXIMUM_PAYLOAD) {}
+
+UdpTransport::Impl::~Impl() { close(); }
+
+bool UdpTransport::Impl::open(uint16_t port)
+{
+#ifdef _WIN32
+  static Winsock winsock;
+#endif
+  close();
+  m_socket = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+  if (m_socket == INVALID_HANDLE)
+  {
+    return false;
+  }
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  int const bufferSize = SOCKET_BUFFER_SIZE;
+  setsockopt(m_socket, SOL_SOCKET, SO_RCVBUF,
+             reinterpret_cast<char const *>(&bufferSize), sizeof(bufferSize));
+  setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF,
+             reinterpret_cast<char const *>(&bufferSize), sizeof(bufferSize));
+  if (bind(m_socket, reinterpret_cast<sockaddr const *>(&address),
+           sizeof(address)) != 0 ||
+      !setNonBlocking(m_socket))
+  {
+    close();
+    return false;
+  }
+  return true;
+}
+
+bool UdpTransport::Impl::setPeer(char const * address, uint16_t port)
+{
+  m_peer = sockaddr_in{};
+  m_peer.sin_family = AF_INET;
+  m_peer.sin_port = htons(port);
+  m_hasPeer = inet_pton(AF_INET, address, &m_peer.sin_addr) == 1;
+  return m_hasPeer;
+}
+
+uint16_t UdpTransport::Impl::getPort() const
+{
+  if (m_socket == INVALID_HANDLE)
+  {
+    return 0;
+  }
+  sockaddr_in address{};
+  socklen_t size = sizeof(address);
+  if (getsockname(m_socket, reinterpret_cast<sockaddr *>(&address), &size) !=
+      0)
+  {
+    return 0;
+  }
+  return ntohs(address.sin_port);
+}
+
+bool UdpTransport::Impl::send(uint8_t const * pData, size_t size)
+{
+  size_t const numberOfDatagrams =
+      size == 0 ? 1 : (size + MAXIMUM_PAYLOAD - 1) / MAXIMUM_PAYLOAD;
+  if (m_socket == INVALID_HANDLE || !m_hasPeer || numberOfDatagrams > 0xffff)
+  {
+    return false;
+  }
+
+  uint32_t const packet = m_nextPacket++;
+  if (m_nextPacket == 0)
+  {
+    m_nextPacket = 1;
+  }
+  for (size_t i = 0; i < numberOfDatagrams; ++i)
+  {
+    size_t const offset = i * MAXIMUM_PAYLOAD;
+    size_t const payloadSize =
+        size - offset < MAXIMUM_PAYLOAD ? size - offset : MAXIMUM_PAYLOAD;
+    writeUint32(m_datagram.data(), packet);
+    writeUint32(m_datagram.data() + 4, static_cast<uint32_t>(
+                                           i | numberOfDatagrams << 16));
+    if (payloadSize > 0)
+    {
+      std::memcpy(m_datagram.data() + HEADER_SIZE, pData + offset,
+                  payloadSize);
+    }
+    if (sendto(m_socket, reinterpret_cast<char const *>(m_datagram.data()),
+               static_cast<int>(HEADER_SIZE + payloadSize), 0,
+               reinterpret_cast<sockaddr const *>(&m_peer),
+               sizeof(m_peer)) < 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool UdpTransport::Impl::receive(std::vector<uint8_t> & packet)
+{
+  if (m_socket == INVALID_HANDLE)
+  {
+    return false;
+  }
+  while (true)
+  {
+    auto const received =
+        recvfrom(m_socket, reinterpret_cast<char *>(m_datagram.data()),
+                 static_cast<int>(m_datagram.size()), 0, nullptr, nullptr);
+    if (received < 0)
+    {
+      return false;
+    }
+    if (static_cast<size_t>(received) < HEADER_SIZE)
+    {
+      continue;
+    }
+
+    uint32_t const number = readUint32(m_datagram.data());
+    uint32_t const position = readUint32(m_datagram.data() + 4);
+    uint16_t const index = static_cast<uint16_t>(position & 0xffff);
+    uint16_t const numberOfDatagrams = static_cast<uint16_t>(position >> 16);
+    if (index >= numberOfDatagrams)
+    {
+      continue;
+    }
+    // datagrams of older packets are dropped, a newer packet replaces the
+    // incomplete one
+    if (number != m_packet)
+    {
+      if (m_packet != 0 && static_cast<int32_t>(number - m_packet) < 0)
+      {
+        continue;
+      }
+      startPacket(number, numberOfDatagrams);
+    }
+    if (m_isReceived.size() != numberOfDatagrams || m_isReceived[index])
+    {
+      continue;
+    }
+
+    size_t const payloadSize = static_cast<size_t>(received) - HEADER_SIZE;
+    std::memcpy(m_payload.data() + index * MAXIMUM_PAYLOAD,
+                m_datagram.data() + HEADER_SIZE, payloadSize);
+    m_isReceived[index] = true;
+    ++m_numberOfReceived;
+    if (index + 1u == numberOfDatagrams)
+    {
+      m_size = index * MAXIMUM_PAYLOAD + payloadSize;
+    }
+    if (m_numberOfReceived == numberOfDatagrams)
+    {
+      packet.assign(m_payload.begin(), m_payload.begin() + m_size);
+      m_isReceived.clear();
+      return true;
+    }
+  }
+}
+
+void UdpTransport::Impl::close()
+{
+  if (m_socket != INVALID_HANDLE)
+  {
+    closeSocket(m_socket);
+    m_socket = INVALID_HANDLE;
+  }
+}
+
+void UdpTransport::Impl::startPacket(uint32_t packet,
+                                     uint16_t numberOfDatagrams)
+{
+  m_packet = packet;
+  m_payload.resize(numberOfDatagrams * MAXIMUM_PAYLOAD);
+  m_isReceived.assign(numberOfDatagrams, false);
+  m_numberOfReceived = 0;
+  m_size = 0;
+}
+
+/******************** Impl end *************************************/
+
+InProcessTransport::InProcessTransport() : m_impl(new Impl()) {}
+
+InProcessTransport::~InProcessTransport() = default;
+
+void InProcessTransport::connect(InProcessTransport & a, InProcessTransport & b)
+{
+  std::shared_ptr<InProcessChannel> channel(new InProcessChannel());
+  a.m_impl->m_channel = channel;
+  a.m_impl->m_side = 0;
+  b.m_impl->m_channel = channel;
+  b.m_impl->m_side = 1;
+}
+
+bool InProcessTransport::send(uint8_t const * pData, size_t size)
+{
+  return m_impl->send(pData, size);
+}
+
+bool InProcessTransport::receive(std::vector<uint8_t> & packet)
+{
+  return m_impl->receive(packet);
+}
+
+UdpTransport::UdpTransport() : m_impl(new Impl()) {}
+
+UdpTransport::~UdpTransport() = default;
+
+bool UdpTransport::open(uint16_t port) { return m_impl->open(port); }
+
+bool UdpTransport::setPeer(char const * address, uint16_t port)
+{
+  return m_impl->setPeer(address, port);
+}
+
+uint16_t UdpTransport::getPort() const { return m_impl->getPort(); }
+
+bool UdpTransport::send(uint8_t const * pData, size_t size)
+{
+  return m_impl->send(pData, size);
+}
+
+bool UdpTransport::receive(std::vector<uint8_t> & packet)
+{
+  return m_impl->receive(packet);
+}
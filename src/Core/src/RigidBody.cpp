@@ -0,0 +1,155 @@
+#include "Core/RigidBody.h"
+#include "Core/Collider.h"
+#include "Core/RenderComponent.h"
+#include "Core/SceneObject.h"
+#include <cstring>
+
+RigidBody::RigidBody() : m_slot(PhysicsWorld::getInstance().createBody(this))
+{
+}
+
+RigidBody::~RigidBody() { PhysicsWorld::getInstance().destroyBody(m_slot); }
+
+void RigidBody::update(double)
+{
+  RenderComponent * pRender =
+      getSceneObject()->getComponent<RenderComponent>();
+  if (pRender == nullptr || m_type == BODY_STATIC)
+    return;
+  BodyMotion const motion =
+      PhysicsWorld::getInstance().getInterpolatedMotion(m_slot);
+  pRender->setPosition(Vector2(motion.positionX, motion.positionY));
+  pRender->setRotation(motion.angle);
+}
+
+Component * RigidBody::clone() const
+{
+  RigidBody * pCopy = new RigidBody();
+  pCopy->m_type = m_type;
+  pCopy->m_density = m_density;
+  PhysicsWorld & world = PhysicsWorld::getInstance();
+  world.editMotion(pCopy->m_slot) = world.getMotion(m_slot);
+  world.setDefinition(pCopy->m_slot, world.getDefinition(m_slot));
+  return pCopy;
+}
+
+size_t RigidBody::getStateSize() const { return sizeof(BodyMotion); }
+
+void RigidBody::saveState(void * pState) const
+{
+  std::memcpy(pState, &PhysicsWorld::getInstance().getMotion(m_slot),
+              sizeof(BodyMotion));
+}
+
+void RigidBody::loadState(void const * pState)
+{
+  // the restored motion is rendered as it is, not interpolated from the
+  // simulation that was rolled back
+  PhysicsWorld & world = PhysicsWorld::getInstance();
+  std::memcpy(&world.editMotion(m_slot), pState, sizeof(BodyMotion));
+  world.teleport(m_slot);
+}
+
+void RigidBody::setType(BodyType type)
+{
+  m_type = type;
+  updateDefinition();
+}
+
+BodyType RigidBody::getType() const { return m_type; }
+
+void RigidBody::setDensity(float density)
+{
+  m_density = density;
+  updateDefinition();
+}
+
+float RigidBody::getDensity() const { return m_density; }
+
+void RigidBody::setPosition(Vector2 const & position)
+{
+  PhysicsWorld & world = PhysicsWorld::getInstance();
+  BodyMotion & motion = world.editMotion(m_slot);
+  motion.positionX = position.x();
+  motion.positionY = position.y();
+  world.teleport(m_slot);
+  markStateChanged();
+}
+
+Vector2 RigidBody::getPosition() const
+{
+  BodyMotion const & motion = PhysicsWorld::getInstance().getMotion(m_slot);
+  return Vector2(motion.positionX, motion.positionY);
+}
+
+void RigidBody::setAngle(float angle)
+{
+  PhysicsWorld & world = PhysicsWorld::getInstance();
+  world.editMotion(m_slot).angle = angle;
+  world.teleport(m_slot);
+  markStateChanged();
+}
+
+float RigidBody::getAngle() const
+{
+  return PhysicsWorld::getInstance().getMotion(m_slot).angle;
+}
+
+void RigidBody::setVelocity(Vector2 const & velocity)
+{
+  BodyMotion & motion = PhysicsWorld::getInstance().editMotion(m_slot);
+  motion.velocityX = velocity.x();
+  motion.velocityY = velocity.y();
+  markStateChanged();
+}
+
+Vector2 RigidBody::getVelocity() const
+{
+  BodyMotion const & motion = PhysicsWorld::getInstance().getMotion(m_slot);
+  return Vector2(motion.velocityX, motion.velocityY);
+}
+
+void RigidBody::setAngularVelocity(float angularVelocity)
+{
+  PhysicsWorld::getInstance().editMotion(m_slot).angularVelocity =
+      angularVelocity;
+  markStateChanged();
+}
+
+float RigidBody::getAngularVelocity() const
+{
+  return PhysicsWorld::getInstance().getMotion(m_slot).angularVelocity;
+}
+
+void RigidBody::applyImpulse(Vector2 const & impulse)
+{
+  PhysicsWorld::getInstance().applyImpulse(m_slot, impulse);
+  markStateChanged();
+}
+
+void RigidBody::updateDefinition()
+{
+  BodyDefinition definition;
+  definition.type = m_type;
+  definition.density = m_density;
+  Collider const * pCollider = m_sceneObject != nullptr
+                                   ? m_sceneObject->getComponent<Collider>()
+                                   : nullptr;
+  if (pCollider != nullptr && pCollider->isActive())
+  {
+    definition.shape = pCollider->getShape();
+    definition.halfWidth = pCollider->getHalfExtents().x();
+    definition.halfHeight = pCollider->getHalfExtents().y();
+    definition.friction = pCollider->getFriction();
+    definition.restitution = pCollider->getRestitution();
+  }
+  PhysicsWorld::getInstance().setDefinition(m_slot, definition);
+}
+
+uint32_t RigidBody::getSlot() const { return m_slot; }
+
+void RigidBody::onActivationChanged()
+{
+  updateDefinition();
+  PhysicsWorld::getInstance().setEnabled(m_slot, isActive());
+}
@@ -1,87 +1,50 @@
 #include "Core/SceneObject.h"
+#include "ComponentIndex.h"
 #include "Core/Component.h"
+#include "Core/MemoryStats.h"
+#include "SceneObjectImpl.h"
+#include "ScenePools.h"
+#include "SceneVersions.h"
 #include <algorithm>
+#include <new>
 #include <string>
 #include <typeinfo>
-#include <unordered_map>
 #include <vector>
 
 /********** Impl start ************/
 
-class SceneObject::Impl final
+namespace
 {
-public:
-  Impl(SceneObject * d);
 
-  ~Impl();
-
-  Impl(Impl const &) = delete;
-
-  Impl & operator=(Impl const &) = delete;
-
-  Impl(Impl &&) = delete;
-
-  Impl & operator=(Impl &&) = delete;
-
-  bool addComponent(Component * pComponent);
-
-  void removeComponent(Component * pComponent);
-
-  SceneObject * getParent();
-
-  SceneObject const * getParent() const;
-
-  bool addChild(SceneObject * pChild);
-
-  void update(double deltaTime);
-
-  void render() const;
-
-  size_t getNumberOfChildren() const;
-
-  bool isLeafNode() const;
-
-  SceneObject * getChild(size_t index);
-
-  SceneObject const * getChild(size_t index) const;
-
-  void setEnabled(bool isEnabled);
-
-  bool isEnabled() const;
-
-private:
-  /**
-   * Removes the child from this scene object committing ownership to the
-   * caller. Only call this, if you know what you're doing.
-   */
-  void removeChild(SceneObject * child);
-
-  /** Checks if the given node is a descendant of this scene object. */
-  bool isNodeDescendant(SceneObject const * pNode) const;
-
-  /** The parent scene object. */
-  SceneObject * m_parent{nullptr};
-
-  /** The children scene objects. */
-  std::vector<SceneObject *> m_children{};
+MemoryCategory & getSceneObjectMemory()
+{
+  static MemoryCategory & category =
+      MemoryStats::getInstance().getObjectType("SceneObject");
+  return category;
+}
 
-  /**
-   * The map of all components. The key is a unique identifier
-   * of the component class. Thus only one instance of one
-   * specific component type is allowed, which is part of the concept.
-   */
-  std::unordered_map<size_t, Component *> m_components{};
+} // namespace
 
-  /**
-   * If a scene object is disabled then its components as well as its children
-   * are neither updated nor rendered.
-   */
-  bool m_isEnabled{true};
+SceneObject::Impl::Impl(SceneObject * d, bool isAccounted) : m_d(d)
+{
+  m_accountedBytes = getOwnMemoryUsage();
+  if (isAccounted)
+  {
+    getSceneObjectMemory().recordAllocation(m_accountedBytes);
+  }
+}
 
-  SceneObject * m_d;
-};
+void * SceneObject::Impl::operator new(size_t size)
+{
+  static_assert(alignof(Impl) <= PoolAllocator::GRANULARITY,
+                "the scene object pool aligns to 16 bytes");
+  return getSceneObjectPool().allocate(size);
+}
 
-SceneObject::Impl::Impl(SceneObject * d) : m_d(d) {}
+void SceneObject::Impl::operator delete(void * p, size_t size)
+{
+  getSceneObjectPool().deallocate(p, size);
+}
 
 SceneObject::Impl::~Impl()
 {
@@ -90,9 +53,14 @@ SceneObject::Impl::~Impl()
     m_parent->m_impl->removeChild(m_d);
   }
 
+  ComponentIndex & index = ComponentIndex::getInstance();
+  index.onObjectDestroyed(*m_d);
   for (auto & component : m_components)
   {
+    index.remove(*component.second);
+    detachMemory(component.second);
     component.second->m_sceneObject = nullptr; // detach component
+    component.second->updateSchedulerRegistration();
     delete component.second;                   // delete component
   }
   m_components.clear();
@@ -103,6 +71,8 @@ SceneObject::Impl::~Impl()
     delete child;                      // delete node
   }
   m_children.clear();
+
+  getSceneObjectMemory().recordDeallocation(m_accountedBytes);
 }
 
 bool SceneObject::Impl::addComponent(Component * pComponent)
@@ -111,26 +81,52 @@ bool SceneObject::Impl::addComponent(Component * pComponent)
   if (pComponent == nullptr || pComponent->m_sceneObject != nullptr)
     return false;
   // insert the component if there isn't a component of the same type yet.
-  auto infoPair = m_components.insert(std::pair<size_t, Component *>(
-      typeid(*pComponent).hash_code(), pComponent));
-  // if insertion was successfull set this as the owner
-  if (infoPair.second)
-  {
-    infoPair.first->second->m_sceneObject = m_d;
-  }
-  return infoPair.second;
+  size_t const typeId = typeid(*pComponent).hash_code();
+  if (getComponent(typeId) != nullptr)
+    return false;
+  // set this as the owner
+  SceneVersions::markStructureChanged(*m_d);
+  m_components.push_back(std::make_pair(typeId, pComponent));
+  pComponent->m_sceneObject = m_d;
+  attachMemory(pComponent);
+  ComponentIndex::getInstance().attach(*pComponent, typeId);
+  updateMemoryUsage();
+  pComponent->updateSchedulerRegistration();
+  pComponent->onActivationChanged();
+  return true;
 }
 
 void SceneObject::Impl::removeComponent(Component * pComponent)
 {
-  auto id = typeid(*pComponent).hash_code();
-  auto cIter = m_components.find(id);
-  if (cIter != std::end(m_components) && cIter->second == pComponent)
+  // while the component is destroyed typeid only yields the base class, so
+  // it's found by its address
+  auto cIter = std::find_if(m_components.begin(), m_components.end(),
+                            [pComponent](auto const & entry) {
+                              return entry.second == pComponent;
+                            });
+  if (cIter != std::end(m_components))
   {
+    SceneVersions::markStructureChanged(*m_d);
     m_components.erase(cIter);
+    detachMemory(pComponent);
+    ComponentIndex::getInstance().detach(*pComponent, *m_d);
+    pComponent->m_sceneObject = nullptr;
+    pComponent->updateSchedulerRegistration();
+    updateMemoryUsage();
+    pComponent->onActivationChanged();
   }
 }
 
+Component * SceneObject::Impl::getComponent(size_t typeId) const
+{
+  for (auto const & component : m_components)
+  {
+    if (component.first == typeId)
+      return component.second;
+  }
+  return nullptr;
+}
+
 SceneObject * SceneObject::Impl::getParent() { return m_parent; }
 
 SceneObject const * SceneObject::Impl::getParent() const { return m_parent; }
@@ -154,17 +150,21 @@ bool SceneObject::Impl::addChild(SceneObject * pChild)
     }
     return false;
   }
+  SceneVersions::markStructureChanged(*m_d);
   pChild->m_impl->m_parent = m_d;
   m_children.push_back(pChild);
+  updateMemoryUsage();
+  pChild->m_impl->notifyActivationChanged();
   return true;
 }
 
 void SceneObject::Impl::update(double deltaTime)
 {
   // HINT: no need to update transform
+  // components with an update frequency are updated by the update scheduler
   for (auto iter = m_components.begin(); iter != m_components.end(); ++iter)
   {
-    if (iter->second->isEnabled())
+    if (iter->second->isEnabled() && iter->second->getUpdateFrequency() == 0.0)
     {
       iter->second->update(deltaTime);
     }
@@ -207,10 +207,45 @@ SceneObject const * SceneObject::Impl::getChild(size_t index) const
   return m_children[index];
 }
 
-void SceneObject::Impl::setEnabled(bool isEnabled) { m_isEnabled = isEnabled; }
+void SceneObject::Impl::setEnabled(bool isEnabled)
+{
+  if (m_isEnabled != isEnabled)
+  {
+    m_isEnabled = isEnabled;
+    SceneVersions::markActivationChanged(*m_d);
+    notifyActivationChanged();
+  }
+}
 
 bool SceneObject::Impl::isEnabled() const { return m_isEnabled; }
 
+bool SceneObject::Impl::isEnabledInHierarchy() const
+{
+  SceneObject const * pCurrentNode = m_d;
+  while (pCurrentNode != nullptr && pCurrentNode->m_impl->m_isEnabled)
+  {
+    pCurrentNode = pCurrentNode->m_impl->m_parent;
+  }
+  return pCurrentNode == nullptr;
+}
+
+size_t SceneObject::Impl::getMemoryUsage(bool includeDescendants) const
+{
+  size_t bytes = getOwnMemoryUsage();
+  for (auto const & component : m_components)
+  {
+    bytes += component.second->getAllocationSize();
+  }
+  if (includeDescendants)
+  {
+    for (SceneObject const * pChild : m_children)
+    {
+      bytes += pChild->m_impl->getMemoryUsage(true);
+    }
+  }
+  return bytes;
+}
+
 void SceneObject::Impl::removeChild(SceneObject * child)
 {
 
@@ -222,8 +257,10 @@ void SceneObject::Impl::removeChild(SceneObject * child)
   }
   if (iter != last)
   {
+    SceneVersions::markStructureChanged(*m_d);
     m_children.erase(iter);
     child->m_impl->m_parent = nullptr;
+    child->m_impl->notifyActivationChanged();
   }
 }
 
@@ -239,12 +276,95 @@ bool SceneObject::Impl::isNodeDescendant(SceneObject const * pNode) const
   return pCurrentNode == m_d;
 }
 
+void SceneObject::Impl::notifyActivationChanged()
+{
+  ComponentIndex::getInstance().onObjectChanged(*m_d);
+  for (auto & component : m_components)
+  {
+    component.second->onActivationChanged();
+  }
+  for (SceneObject * pChild : m_children)
+  {
+    pChild->m_impl->notifyActivationChanged();
+  }
+}
+
+void SceneObject::Impl::updateMemoryUsage()
+{
+  size_t const bytes = getOwnMemoryUsage();
+  if (bytes != m_accountedBytes)
+  {
+    getSceneObjectMemory().recordResize(static_cast<int64_t>(bytes) -
+                                        static_cast<int64_t>(m_accountedBytes));
+    m_accountedBytes = bytes;
+  }
+}
+
+size_t SceneObject::Impl::getOwnMemoryUsage() const
+{
+  return sizeof(SceneObject) + sizeof(Impl) + m_children.getHeapSize() +
+         m_components.getHeapSize();
+}
+
+void SceneObject::Impl::attachMemory(Component * pComponent)
+{
+  MemoryCategory & category =
+      MemoryStats::getInstance().getComponentType(typeid(*pComponent));
+  category.recordAllocation(pComponent->getAllocationSize());
+  pComponent->m_memoryCategory = &category;
+}
+
+void SceneObject::Impl::detachMemory(Component * pComponent)
+{
+  if (pComponent->m_memoryCategory != nullptr)
+  {
+    pComponent->m_memoryCategory->recordDeallocation(
+        pComponent->getAllocationSize());
+    pComponent->m_memoryCategory = nullptr;
+  }
+}
+
+void SceneObject::Impl::createObjects(size_t count, SceneObject ** ppObjects)
+{
+  if (count == 0)
+    return;
+  // reused, prefabs create the objects of one instance at a time
+  thread_local std::vector<void *> blocks;
+  blocks.resize(2 * count);
+  PoolAllocator & pool = getSceneObjectPool();
+  pool.allocate(sizeof(SceneObject), count, blocks.data());
+  pool.allocate(sizeof(Impl), count, blocks.data() + count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    SceneObject * pObject = static_cast<SceneObject *>(blocks[i]);
+    Impl * pImpl = ::new (blocks[count + i]) Impl(pObject, false);
+    ppObjects[i] = ::new (blocks[i]) SceneObject(pImpl);
+  }
+  // empty objects hold the same bytes
+  getSceneObjectMemory().recordAllocations(
+      count, count * ppObjects[0]->m_impl->m_accountedBytes);
+}
+
 /******************** Impl end *************************************/
 
 SceneObject::SceneObject() : m_impl(new Impl(this)) {}
 
+SceneObject::SceneObject(Impl * pImpl) : m_impl(pImpl) {}
+
 SceneObject::~SceneObject() = default;
 
+void * SceneObject::operator new(size_t size)
+{
+  static_assert(alignof(SceneObject) <= PoolAllocator::GRANULARITY,
+                "the scene object pool aligns to 16 bytes");
+  return getSceneObjectPool().allocate(size);
+}
+
+void SceneObject::operator delete(void * p, size_t size)
+{
+  getSceneObjectPool().deallocate(p, size);
+}
+
 bool SceneObject::addComponent(Component * pComponent)
 {
   return m_impl->addComponent(pComponent);
@@ -255,6 +375,16 @@ void SceneObject::removeComponent(Component * pComponent)
   return m_impl->removeComponent(pComponent);
 }
 
+Component * SceneObject::getComponent(std::type_info const & type)
+{
+  return m_impl->getComponent(type.hash_code());
+}
+
+Component const * SceneObject::getComponent(std::type_info const & type) const
+{
+  return m_impl->getComponent(type.hash_code());
+}
+
 SceneObject * SceneObject::getParent() { return m_impl->getParent(); }
 
 SceneObject const * SceneObject::getParent() const
@@ -291,3 +421,13 @@ SceneObject const * SceneObject::getChild(size_t index) const
 void SceneObject::setEnabled(bool isEnabled) { m_impl->setEnabled(isEnabled); }
 
 bool SceneObject::isEnabled() const { return m_impl->isEnabled(); }
+
+bool SceneObject::isEnabledInHierarchy() const
+{
+  return m_impl->isEnabledInHierarchy();
+}
+
+size_t SceneObject::getMemoryUsage(bool includeDescendants) const
+{
+  return m_impl->getMemoryUsage(includeDescendants);
+}
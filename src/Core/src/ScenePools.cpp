@@ -0,0 +1,13 @@
+#include "ScenePools.h"
+
+PoolAllocator & getSceneObjectPool()
+{
+  static PoolAllocator pool("SceneObject pool");
+  return pool;
+}
+
+PoolAllocator & getComponentPool()
+{
+  static PoolAllocator pool("Component pool");
+  return pool;
+}
@@ -0,0 +1,489 @@
+#include "Core/SceneSnapshot.h"
+#include "Core/Component.h"
+#include "Core/SceneObject.h"
+#include "SceneObjectImpl.h"
+#include "SceneVersions.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+
+/** The alignment of every state in the buffer. */
+size_t const STATE_ALIGNMENT = 16;
+
+} // namespace
+
+/********** Impl start ************/
+
+class SceneSnapshot::Impl final
+{
+public:
+  Impl();
+
+  ~Impl();
+
+  Impl(Impl const &) = delete;
+
+  Impl & operator=(Impl const &) = delete;
+
+  Impl(Impl &&) = delete;
+
+  Impl & operator=(Impl &&) = delete;
+
+  void capture(SceneObject & root);
+
+  bool restore();
+
+  bool isEmpty() const;
+
+  size_t getNumberOfObjects() const;
+
+  size_t getNumberOfComponents() const;
+
+  size_t getStateSize() const;
+
+  size_t getNumberOfCopiedStates() const;
+
+private:
+  struct ObjectEntry
+  {
+    SceneObject * pObject;
+
+    /** The index of the parent entry, unused for the root. */
+    uint32_t parent;
+
+    /** The children are the entries [firstChild, firstChild + number). */
+    uint32_t firstChild;
+
+    uint32_t numberOfChildren;
+
+    uint32_t firstComponent;
+
+    uint32_t numberOfComponents;
+
+    bool isEnabled;
+
+    /** The versions of the object the entry matches. */
+    uint64_t structureVersion;
+
+    uint64_t subtreeStructureVersion;
+
+    uint64_t subtreeActivationVersion;
+  };
+
+  struct ComponentEntry
+  {
+    Component * pComponent;
+
+    /** The state version of the saved state, zero if none is saved yet. */
+    uint64_t version;
+
+    /** The range of the state in the buffer. */
+    size_t offset;
+
+    size_t size;
+
+    bool isEnabled;
+  };
+
+  /**
+   * Collects the hierarchy and the flags in breadth first order and lays
+   * out the buffer.
+   */
+  void buildLayout(SceneObject & root);
+
+  /**
+   * Writes the entries whose subtree changed in structure or in the flags
+   * since their versions were stored to m_changed, parents first.
+   */
+  void findChanged(bool isStructure);
+
+  /** Captures the flags of the subtrees that changed. */
+  void captureFlags();
+
+  /** Sets the flags that differ from the captured ones. */
+  void restoreFlags();
+
+  /**
+   * Puts objects and components back where they were when captured. Only
+   * the objects whose children or components changed are touched.
+   */
+  void restoreStructure();
+
+  /**
+   * Gives the object of the entry its captured children and components.
+   * Objects that were added are appended to m_added.
+   */
+  void restoreObject(uint32_t index);
+
+  /** Stores the versions of the objects that changed in their entries. */
+  void storeVersions();
+
+  std::vector<ObjectEntry> m_objects{};
+
+  std::vector<ComponentEntry> m_components{};
+
+  /** The entry of every captured object. */
+  std::unordered_map<SceneObject const *, uint32_t> m_objectIndices{};
+
+  /** The object entry every captured component belongs to. */
+  std::unordered_map<Component const *, uint32_t> m_componentObjects{};
+
+  /** The states of all components. */
+  std::vector<unsigned char> m_states{};
+
+  size_t m_numberOfCopiedStates{0};
+
+  /** Buffers of restore, kept to avoid allocations. */
+  std::vector<uint32_t> m_changed{};
+  std::vector<SceneObject *> m_added{};
+  std::vector<SceneObject *> m_moved{};
+  std::vector<Component *> m_removed{};
+};
+
+SceneSnapshot::Impl::Impl() = default;
+
+SceneSnapshot::Impl::~Impl() = default;
+
+void SceneSnapshot::Impl::capture(SceneObject & root)
+{
+  if (m_objects.empty() || m_objects.front().pObject != &root ||
+      m_objects.front().subtreeStructureVersion !=
+          root.m_impl->m_subtreeStructureVersion)
+  {
+    buildLayout(root);
+  }
+  else if (m_objects.front().subtreeActivationVersion !=
+           root.m_impl->m_subtreeActivationVersion)
+  {
+    captureFlags();
+  }
+
+  m_numberOfCopiedStates = 0;
+  for (ComponentEntry & entry : m_components)
+  {
+    if (entry.size != 0 && entry.version != entry.pComponent->m_stateVersion)
+    {
+      entry.pComponent->saveState(m_states.data() + entry.offset);
+      entry.version = entry.pComponent->m_stateVersion;
+      ++m_numberOfCopiedStates;
+    }
+  }
+}
+
+bool SceneSnapshot::Impl::restore()
+{
+  if (m_objects.empty())
+  {
+    return false;
+  }
+  SceneObject::Impl const & root = *m_objects.front().pObject->m_impl;
+  if (m_objects.front().subtreeStructureVersion !=
+      root.m_subtreeStructureVersion)
+  {
+    restoreStructure();
+  }
+  if (m_objects.front().subtreeActivationVersion !=
+      root.m_subtreeActivationVersion)
+  {
+    restoreFlags();
+  }
+  storeVersions();
+
+  m_numberOfCopiedStates = 0;
+  for (ComponentEntry const & entry : m_components)
+  {
+    if (entry.size != 0 && entry.version != entry.pComponent->m_stateVersion)
+    {
+      entry.pComponent->loadState(m_states.data() + entry.offset);
+      entry.pComponent->m_stateVersion = entry.version;
+      ++m_numberOfCopiedStates;
+    }
+  }
+  return true;
+}
+
+bool SceneSnapshot::Impl::isEmpty() const { return m_objects.empty(); }
+
+size_t SceneSnapshot::Impl::getNumberOfObjects() const
+{
+  return m_objects.size();
+}
+
+size_t SceneSnapshot::Impl::getNumberOfComponents() const
+{
+  return m_components.size();
+}
+
+size_t SceneSnapshot::Impl::getStateSize() const { return m_states.size(); }
+
+size_t SceneSnapshot::Impl::getNumberOfCopiedStates() const
+{
+  return m_numberOfCopiedStates;
+}
+
+void SceneSnapshot::Impl::buildLayout(SceneObject & root)
+{
+  m_objects.clear();
+  m_components.clear();
+  m_objectIndices.clear();
+  m_componentObjects.clear();
+  m_objects.push_back(ObjectEntry{&root, 0, 0, 0, 0, 0, true, 0, 0, 0});
+  size_t stateSize = 0;
+  for (size_t i = 0; i < m_objects.size(); ++i)
+  {
+    ObjectEntry & entry = m_objects[i];
+    SceneObject::Impl const & object = *entry.pObject->m_impl;
+    uint32_t const index = static_cast<uint32_t>(i);
+    m_objectIndices.emplace(entry.pObject, index);
+    entry.firstChild = static_cast<uint32_t>(m_objects.size());
+    entry.numberOfChildren = static_cast<uint32_t>(object.m_children.size());
+    entry.firstComponent = static_cast<uint32_t>(m_components.size());
+    entry.numberOfComponents =
+        static_cast<uint32_t>(object.m_components.size());
+    entry.isEnabled = object.m_isEnabled;
+    entry.structureVersion = object.m_structureVersion;
+    entry.subtreeStructureVersion = object.m_subtreeStructureVersion;
+    entry.subtreeActivationVersion = object.m_subtreeActivationVersion;
+    for (auto const & component : object.m_components)
+    {
+      // the version zero makes the next capture save every state
+      size_t const size = component.second->getStateSize();
+      m_components.push_back(ComponentEntry{component.second, 0, stateSize,
+                                            size,
+                                            component.second->m_isEnabled});
+      m_componentObjects.emplace(component.second, index);
+      stateSize += (size + STATE_ALIGNMENT - 1) & ~(STATE_ALIGNMENT - 1);
+    }
+    // entry is invalidated by the push_back
+    for (SceneObject * pChild : object.m_children)
+    {
+      m_objects.push_back(
+          ObjectEntry{pChild, index, 0, 0, 0, 0, true, 0, 0, 0});
+    }
+  }
+  m_states.resize(stateSize);
+}
+
+void SceneSnapshot::Impl::findChanged(bool isStructure)
+{
+  auto const isChanged = [isStructure](ObjectEntry const & entry)
+  {
+    SceneObject::Impl const & object = *entry.pObject->m_impl;
+    return isStructure ? entry.subtreeStructureVersion !=
+                             object.m_subtreeStructureVersion
+                       : entry.subtreeActivationVersion !=
+                             object.m_subtreeActivationVersion;
+  };
+
+  // every change below an entry reaches the entry, through the objects it
+  // is attached to or through the parent it was removed from
+  m_changed.clear();
+  if (isChanged(m_objects.front()))
+  {
+    m_changed.push_back(0);
+  }
+  for (size_t i = 0; i < m_changed.size(); ++i)
+  {
+    ObjectEntry const & entry = m_objects[m_changed[i]];
+    for (uint32_t c = 0; c < entry.numberOfChildren; ++c)
+    {
+      if (isChanged(m_objects[entry.firstChild + c]))
+      {
+        m_changed.push_back(entry.firstChild + c);
+      }
+    }
+  }
+}
+
+void SceneSnapshot::Impl::captureFlags()
+{
+  findChanged(false);
+  for (uint32_t index : m_changed)
+  {
+    ObjectEntry & entry = m_objects[index];
+    entry.isEnabled = entry.pObject->m_impl->m_isEnabled;
+    entry.subtreeActivationVersion =
+        entry.pObject->m_impl->m_subtreeActivationVersion;
+    for (uint32_t c = 0; c < entry.numberOfComponents; ++c)
+    {
+      ComponentEntry & component = m_components[entry.firstComponent + c];
+      component.isEnabled = component.pComponent->m_isEnabled;
+    }
+  }
+}
+
+void SceneSnapshot::Impl::restoreFlags()
+{
+  // setting a flag notifies the subtree, which is fine for the few flags
+  // that usually change between capture and restore
+  findChanged(false);
+  for (uint32_t index : m_changed)
+  {
+    ObjectEntry const & entry = m_objects[index];
+    if (entry.pObject->m_impl->m_isEnabled != entry.isEnabled)
+    {
+      entry.pObject->m_impl->setEnabled(entry.isEnabled);
+    }
+    for (uint32_t c = 0; c < entry.numberOfComponents; ++c)
+    {
+      ComponentEntry const & component = m_components[entry.firstComponent + c];
+      if (component.pComponent->m_isEnabled != component.isEnabled)
+      {
+        component.pComponent->setEnabled(component.isEnabled);
+      }
+    }
+  }
+}
+
+void SceneSnapshot::Impl::restoreStructure()
+{
+  findChanged(true);
+  m_added.clear();
+  for (uint32_t index : m_changed)
+  {
+    ObjectEntry const & entry = m_objects[index];
+    if (entry.structureVersion != entry.pObject->m_impl->m_structureVersion)
+    {
+      restoreObject(index);
+    }
+  }
+  // the captured objects were taken out of the added ones before
+  for (SceneObject * pObject : m_added)
+  {
+    delete pObject;
+  }
+}
+
+void SceneSnapshot::Impl::restoreObject(uint32_t index)
+{
+  ObjectEntry const & entry = m_objects[index];
+  SceneObject::Impl & object = *entry.pObject->m_impl;
+
+  // children captured somewhere else are linked again by their parent
+  for (SceneObject * pChild : object.m_children)
+  {
+    auto const found = m_objectIndices.find(pChild);
+    if (found == m_objectIndices.end())
+    {
+      m_added.push_back(pChild);
+    }
+    if (found == m_objectIndices.end() ||
+        m_objects[found->second].parent != index)
+    {
+      pChild->m_impl->m_parent = nullptr;
+    }
+  }
+  object.m_children.clear();
+  m_moved.clear();
+  for (uint32_t c = 0; c < entry.numberOfChildren; ++c)
+  {
+    SceneObject * pChild = m_objects[entry.firstChild + c].pObject;
+    SceneObject * pParent = pChild->m_impl->m_parent;
+    if (pParent != entry.pObject)
+    {
+      if (pParent != nullptr)
+      {
+        pParent->m_impl->removeChild(pChild);
+      }
+      pChild->m_impl->m_parent = entry.pObject;
+      m_moved.push_back(pChild);
+    }
+    object.m_children.push_back(pChild);
+  }
+
+  // components captured somewhere else are detached, added ones destroyed
+  m_removed.clear();
+  for (auto const & component : object.m_components)
+  {
+    auto const found = m_componentObjects.find(component.second);
+    if (found == m_componentObjects.end() || found->second != index)
+    {
+      m_removed.push_back(component.second);
+    }
+  }
+  for (Component * pComponent : m_removed)
+  {
+    if (m_componentObjects.count(pComponent) != 0)
+    {
+      object.removeComponent(pComponent);
+    }
+    else
+    {
+      delete pComponent;
+    }
+  }
+  for (uint32_t c = 0; c < entry.numberOfComponents; ++c)
+  {
+    ComponentEntry const & component = m_components[entry.firstComponent + c];
+    Component * pComponent = component.pComponent;
+    if (pComponent->m_sceneObject != entry.pObject)
+    {
+      if (pComponent->m_sceneObject != nullptr)
+      {
+        pComponent->m_sceneObject->removeComponent(pComponent);
+      }
+      // the flag may have changed while the component was detached
+      pComponent->m_isEnabled = component.isEnabled;
+      object.addComponent(pComponent);
+    }
+  }
+
+  SceneVersions::markStructureChanged(*entry.pObject);
+  object.updateMemoryUsage();
+  for (SceneObject * pChild : m_moved)
+  {
+    // flags that changed while the child was elsewhere are restored too
+    SceneVersions::markActivationChanged(*pChild);
+    pChild->m_impl->notifyActivationChanged();
+  }
+}
+
+void SceneSnapshot::Impl::storeVersions()
+{
+  findChanged(true);
+  for (uint32_t index : m_changed)
+  {
+    ObjectEntry & entry = m_objects[index];
+    entry.structureVersion = entry.pObject->m_impl->m_structureVersion;
+    entry.subtreeStructureVersion =
+        entry.pObject->m_impl->m_subtreeStructureVersion;
+  }
+  findChanged(false);
+  for (uint32_t index : m_changed)
+  {
+    m_objects[index].subtreeActivationVersion =
+        m_objects[index].pObject->m_impl->m_subtreeActivationVersion;
+  }
+}
+
+/******************** Impl end *************************************/
+
+SceneSnapshot::SceneSnapshot() : m_impl(new Impl()) {}
+
+SceneSnapshot::~SceneSnapshot() = default;
+
+void SceneSnapshot::capture(SceneObject & root) { m_impl->capture(root); }
+
+bool SceneSnapshot::restore() { return m_impl->restore(); }
+
+bool SceneSnapshot::isEmpty() const { return m_impl->isEmpty(); }
+
+size_t SceneSnapshot::getNumberOfObjects() const
+{
+  return m_impl->getNumberOfObjects();
+}
+
+size_t SceneSnapshot::getNumberOfComponents() const
+{
+  return m_impl->getNumberOfComponents();
+}
+
+size_t SceneSnapshot::getStateSize() const { return m_impl->getStateSize(); }
+
+size_t SceneSnapshot::getNumberOfCopiedStates() const
+{
+  return m_impl->getNumberOfCopiedStates();
+}
@@ -0,0 +1,30 @@
+#include "SceneVersions.h"
+#include "SceneObjectImpl.h"
+
+namespace
+{
+
+uint64_t lastVersion = 0;
+
+} // namespace
+
+void SceneVersions::markStructureChanged(SceneObject & object)
+{
+  uint64_t const version = ++lastVersion;
+  object.m_impl->m_structureVersion = version;
+  for (SceneObject * pObject = &object; pObject != nullptr;
+       pObject = pObject->m_impl->m_parent)
+  {
+    pObject->m_impl->m_subtreeStructureVersion = version;
+  }
+}
+
+void SceneVersions::markActivationChanged(SceneObject & object)
+{
+  uint64_t const version = ++lastVersion;
+  for (SceneObject * pObject = &object; pObject != nullptr;
+       pObject = pObject->m_impl->m_parent)
+  {
+    pObject->m_impl->m_subtreeActivationVersion = version;
+  }
+}
@@ -0,0 +1,110 @@
+#include "Core/TimerWheel.h"
+
+namespace
+{
+
+/** Returns the index of the highest set bit, the value must not be zero. */
+size_t getHighestBit(uint64_t value)
+{
+  size_t index = 0;
+  while (value >>= 1)
+  {
+    ++index;
+  }
+  return index;
+}
+
+/** Returns the mask of the ticks covered by the given number of wheels. */
+uint64_t getRangeMask(size_t numberOfLevels)
+{
+  return (uint64_t(1) << (numberOfLevels * TimerWheel::BITS_PER_LEVEL)) - 1;
+}
+
+} // namespace
+
+TimerWheel::TimerWheel() = default;
+
+void TimerWheel::schedule(TimerNode & timer, uint64_t expiry)
+{
+  timer.expiry = expiry;
+  if (expiry <= m_currentTick)
+  {
+    m_due.push_back(timer);
+  }
+  else
+  {
+    insert(timer);
+  }
+}
+
+void TimerWheel::advance(uint64_t tick, TimerList & expired)
+{
+  m_due.spliceTo(expired);
+  uint64_t const levelMask = SLOTS_PER_LEVEL - 1;
+  while (m_currentTick < tick)
+  {
+    ++m_currentTick;
+
+    // on a wrap of the inner wheels the next slot of the outer ones is due,
+    // outer wheels first since their timers may cascade into the inner ones
+    size_t levels = 0;
+    while (levels + 1 < NUMBER_OF_LEVELS &&
+           (m_currentTick & getRangeMask(levels + 1)) == 0)
+    {
+      ++levels;
+    }
+    if (levels + 1 == NUMBER_OF_LEVELS &&
+        (m_currentTick & getRangeMask(NUMBER_OF_LEVELS)) == 0)
+    {
+      cascade(m_overflow);
+    }
+    for (size_t level = levels; level > 0; --level)
+    {
+      size_t const slot =
+          (m_currentTick >> (level * BITS_PER_LEVEL)) & levelMask;
+      cascade(m_wheels[level][slot]);
+    }
+    m_wheels[0][m_currentTick & levelMask].spliceTo(expired);
+  }
+}
+
+uint64_t TimerWheel::getCurrentTick() const { return m_currentTick; }
+
+void TimerWheel::insert(TimerNode & timer)
+{
+  // the timer goes to the wheel of the highest group of bits in which its
+  // expiry differs from the current tick
+  uint64_t const difference = timer.expiry ^ m_currentTick;
+  if (difference == 0)
+  {
+    m_wheels[0][timer.expiry & (SLOTS_PER_LEVEL - 1)].push_back(timer);
+    return;
+  }
+  size_t const level = getHighestBit(difference) / BITS_PER_LEVEL;
+  if (level >= NUMBER_OF_LEVELS)
+  {
+    m_overflow.push_back(timer);
+    return;
+  }
+  size_t const slot =
+      (timer.expiry >> (level * BITS_PER_LEVEL)) & (SLOTS_PER_LEVEL - 1);
+  m_wheels[level][slot].push_back(timer);
+}
+
+void TimerWheel::cascade(TimerList & slot)
+{
+  TimerList timers;
+  slot.spliceTo(timers);
+  while (!timers.empty())
+  {
+    TimerNode & timer = timers.pop_front();
+    if (timer.expiry <= m_currentTick)
+    {
+      m_wheels[0][m_currentTick & (SLOTS_PER_LEVEL - 1)].push_back(timer);
+    }
+    else
+    {
+      insert(timer);
+    }
+  }
+}
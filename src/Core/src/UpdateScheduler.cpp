@@ -0,0 +1,223 @@
+#include "Core/UpdateScheduler.h"
+#include "Core/Component.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+/** Position of entries that wait in the deferred list. */
+uint32_t const DEFERRED_BUCKET = 0xffffffffu;
+
+/** The budget is checked every so many updates to keep timing cheap. */
+size_t const BUDGET_CHECK_INTERVAL = 8;
+
+} // namespace
+
+UpdateScheduler & UpdateScheduler::getInstance()
+{
+  static UpdateScheduler instance;
+  return instance;
+}
+
+UpdateScheduler::UpdateScheduler() : m_buckets(NUMBER_OF_BUCKETS) {}
+
+void UpdateScheduler::update(double deltaTime)
+{
+  Clock::time_point const start = Clock::now();
+  m_time += deltaTime;
+  if (deltaTime > 0.0)
+  {
+    m_averageDeltaTime = 0.9 * m_averageDeltaTime + 0.1 * deltaTime;
+  }
+  ++m_frame;
+  m_statistics = UpdateSchedulerStatistics();
+
+  // postponed entries first so that they can't starve
+  std::vector<uint32_t> due;
+  due.swap(m_deferred);
+  std::vector<uint32_t> & bucket = m_buckets[m_frame % NUMBER_OF_BUCKETS];
+  due.insert(due.end(), bucket.begin(), bucket.end());
+  bucket.clear();
+  for (uint32_t entryIndex : due)
+  {
+    m_entries[entryIndex].bucket = DEFERRED_BUCKET;
+  }
+
+  Clock::duration const budget =
+      std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(m_frameBudget));
+  for (size_t i = 0; i < due.size(); ++i)
+  {
+    uint32_t const entryIndex = due[i];
+    if (m_frameBudget > 0.0 && i % BUDGET_CHECK_INTERVAL == 0 && i > 0 &&
+        Clock::now() - start > budget)
+    {
+      // keep the remaining ones, they get more time next frame
+      for (size_t j = i; j < due.size(); ++j)
+      {
+        if (m_entries[due[j]].pComponent != nullptr &&
+            m_entries[due[j]].bucket == DEFERRED_BUCKET)
+        {
+          m_entries[due[j]].position = static_cast<uint32_t>(m_deferred.size());
+          m_deferred.push_back(due[j]);
+        }
+      }
+      m_statistics.numberOfDeferred = m_deferred.size();
+      break;
+    }
+
+    // an earlier update may have removed or rescheduled the entry
+    Entry & entry = m_entries[entryIndex];
+    if (entry.pComponent == nullptr || entry.bucket != DEFERRED_BUCKET)
+      continue;
+    Component * pComponent = entry.pComponent;
+    double const elapsed = m_time - entry.lastUpdateTime;
+    entry.lastUpdateTime = m_time;
+    insert(entryIndex, getInterval(entry));
+    // inactive components don't accumulate time, like in the frame update
+    if (pComponent->isActive())
+    {
+      pComponent->update(elapsed);
+      ++m_statistics.numberOfUpdates;
+    }
+  }
+  m_statistics.updateSeconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+void UpdateScheduler::setFrameBudget(double seconds)
+{
+  m_frameBudget = std::max(seconds, 0.0);
+}
+
+double UpdateScheduler::getFrameBudget() const { return m_frameBudget; }
+
+void UpdateScheduler::setFrequencyFunction(FrequencyFunction const & function)
+{
+  m_frequencyFunction = function;
+}
+
+size_t UpdateScheduler::getNumberOfComponents() const
+{
+  return m_entries.size() - m_freeEntries.size();
+}
+
+UpdateSchedulerStatistics const & UpdateScheduler::getStatistics() const
+{
+  return m_statistics;
+}
+
+void UpdateScheduler::add(Component * pComponent)
+{
+  uint32_t entryIndex = 0;
+  if (m_freeEntries.empty())
+  {
+    entryIndex = static_cast<uint32_t>(m_entries.size());
+    m_entries.emplace_back();
+  }
+  else
+  {
+    entryIndex = m_freeEntries.back();
+    m_freeEntries.pop_back();
+  }
+  Entry & entry = m_entries[entryIndex];
+  entry.pComponent = pComponent;
+  entry.lastUpdateTime = m_time;
+  entry.interval = 0;
+  entry.bucket = DEFERRED_BUCKET;
+  entry.position = INVALID_ENTRY;
+  pComponent->m_updateEntry = entryIndex;
+  insert(entryIndex, getInterval(entry));
+}
+
+void UpdateScheduler::remove(Component * pComponent)
+{
+  uint32_t const entryIndex = pComponent->m_updateEntry;
+  unlink(entryIndex);
+  m_entries[entryIndex].pComponent = nullptr;
+  m_freeEntries.push_back(entryIndex);
+  pComponent->m_updateEntry = INVALID_ENTRY;
+}
+
+void UpdateScheduler::reschedule(Component * pComponent)
+{
+  uint32_t const entryIndex = pComponent->m_updateEntry;
+  Entry & entry = m_entries[entryIndex];
+  uint32_t const interval = getInterval(entry);
+  if (interval != entry.interval)
+  {
+    unlink(entryIndex);
+    insert(entryIndex, interval);
+  }
+}
+
+uint32_t UpdateScheduler::getInterval(Entry const & entry) const
+{
+  Component const & component = *entry.pComponent;
+  double frequency = component.getUpdateFrequency();
+  if (m_frequencyFunction)
+  {
+    frequency = m_frequencyFunction(component, frequency);
+  }
+  double const frames =
+      frequency > 0.0 ? std::round(1.0 / (frequency * m_averageDeltaTime))
+                      : double(NUMBER_OF_BUCKETS - 1);
+  return static_cast<uint32_t>(
+      std::clamp(frames, 1.0, double(NUMBER_OF_BUCKETS - 1)));
+}
+
+void UpdateScheduler::insert(uint32_t entryIndex, uint32_t interval)
+{
+  Entry & entry = m_entries[entryIndex];
+  uint64_t frame = m_frame + interval;
+  if (interval != entry.interval)
+  {
+    // a new interval gets a new phase: the least loaded frame in reach
+    size_t smallestLoad = static_cast<size_t>(-1);
+    for (uint64_t candidate = m_frame + 1; candidate <= m_frame + interval;
+         ++candidate)
+    {
+      size_t const load = m_buckets[candidate % NUMBER_OF_BUCKETS].size();
+      if (load < smallestLoad)
+      {
+        smallestLoad = load;
+        frame = candidate;
+      }
+    }
+    entry.interval = interval;
+  }
+  std::vector<uint32_t> & bucket = m_buckets[frame % NUMBER_OF_BUCKETS];
+  entry.bucket = static_cast<uint32_t>(frame % NUMBER_OF_BUCKETS);
+  entry.position = static_cast<uint32_t>(bucket.size());
+  bucket.push_back(entryIndex);
+}
+
+void UpdateScheduler::unlink(uint32_t entryIndex)
+{
+  Entry & entry = m_entries[entryIndex];
+  std::vector<uint32_t> * pList = nullptr;
+  if (entry.bucket != DEFERRED_BUCKET)
+  {
+    pList = &m_buckets[entry.bucket];
+  }
+  else if (entry.position < m_deferred.size() &&
+           m_deferred[entry.position] == entryIndex)
+  {
+    pList = &m_deferred;
+  }
+  if (pList != nullptr)
+  {
+    // swap with the last one so that removal is constant time
+    std::vector<uint32_t> & list = *pList;
+    uint32_t const lastIndex = list.back();
+    list[entry.position] = lastIndex;
+    m_entries[lastIndex].position = entry.position;
+    list.pop_back();
+  }
+  entry.bucket = DEFERRED_BUCKET;
+  entry.position = INVALID_ENTRY;
+}
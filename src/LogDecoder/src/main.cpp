@@ -0,0 +1,118 @@
+#include <Core/LogReader.h>
+#include <Core/Logger.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+void printUsage()
+{
+  std::cout << "Usage: LogDecoder [options] <file>\n"
+               "Prints a binary log file as text.\n"
+               "Options:\n"
+               "  --severity <name>  only messages of at least the severity\n"
+               "  --category <name>  only messages of the category, can be\n"
+               "                     given several times\n";
+}
+
+bool findSeverity(std::string const & name, LogSeverity & severity)
+{
+  for (int s = 0; s < NUMBER_OF_SEVERITIES; ++s)
+  {
+    if (name == getSeverityName(static_cast<LogSeverity>(s)))
+    {
+      severity = static_cast<LogSeverity>(s);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool findCategory(std::string const & name, LogCategory & category)
+{
+  for (int c = 0; c < NUMBER_OF_CATEGORIES; ++c)
+  {
+    if (name == getCategoryName(static_cast<LogCategory>(c)))
+    {
+      category = static_cast<LogCategory>(c);
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace
+
+int main(int argc, char ** argv)
+{
+  std::vector<std::string> arguments(argv + 1, argv + argc);
+  LogSeverity minimumSeverity = SEVERITY_TRACE;
+  uint32_t categories = 0;
+  std::string filename;
+  for (size_t i = 0; i < arguments.size(); ++i)
+  {
+    std::string const & argument = arguments[i];
+    bool const hasValue = i + 1 < arguments.size();
+    if (argument == "--severity" && hasValue)
+    {
+      if (!findSeverity(arguments[++i], minimumSeverity))
+      {
+        std::cout << "Unknown severity '" << arguments[i] << "'." << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    else if (argument == "--category" && hasValue)
+    {
+      LogCategory category = CATEGORY_GENERAL;
+      if (!findCategory(arguments[++i], category))
+      {
+        std::cout << "Unknown category '" << arguments[i] << "'." << std::endl;
+        return EXIT_FAILURE;
+      }
+      categories |= 1u << category;
+    }
+    else if (filename.empty() && argument.rfind("--", 0) != 0)
+    {
+      filename = argument;
+    }
+    else
+    {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (filename.empty())
+  {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+  if (categories == 0)
+  {
+    categories = (1u << NUMBER_OF_CATEGORIES) - 1;
+  }
+
+  LogReader reader;
+  if (!reader.open(filename))
+  {
+    std::cout << "'" << filename << "' is not a log file." << std::endl;
+    return EXIT_FAILURE;
+  }
+  LogEntry entry;
+  while (reader.read(entry))
+  {
+    if (entry.severity >= minimumSeverity &&
+        ((categories >> entry.category) & 1) != 0)
+    {
+      std::cout << LogReader::formatEntry(entry) << '\n';
+    }
+  }
+  std::cout.flush();
+  if (reader.isTruncated())
+  {
+    std::cout << "The log ends with an incomplete record." << std::endl;
+  }
+  return EXIT_SUCCESS;
+}
@@ -3,28 +3,41 @@
 #include <GLFW/glfw3.h>
 #include <Core/SceneObject.h>
 #include <Core/Component.h>
+#include <Core/Behavior.h>
+#include <Core/UpdateScheduler.h>
+#include <Core/FramePipeline.h>
+#include <Core/PhysicsWorld.h>
+#include <Core/Logger.h>
 #include "InputManager.h"
+#include <atomic>
 #include <chrono>
-#include <iostream>
+#include <memory>
 #include <string>
 #include <thread>
 
 using namespace MyGame;
 
+// The framebuffer size is set by the event thread and applied by the renderer
+std::atomic<int> framebufferWidth{0};
+std::atomic<int> framebufferHeight{0};
+std::atomic<bool> isFramebufferResized{false};
+
 bool initGL(int width, int height)
 {
   glViewport(0, 0, width, height);
   return true;
 }
 
-void errorCallback(int /*error*/, const char * description)
+void errorCallback(int error, const char * description)
 {
-  std::cout << "GLFW Error: " << description << std::endl;
+  CORE_LOG_ERROR(CATEGORY_RENDERING, "GLFW error {}: {}", error, description);
 }
 
 void resizeCallback(GLFWwindow * /*pWindow*/, int width, int height)
 {
-  glViewport(0, 0, width, height);
+  framebufferWidth = width;
+  framebufferHeight = height;
+  isFramebufferResized = true;
 }
 
 int main(void)
@@ -34,7 +47,8 @@ int main(void)
   glfwSetErrorCallback(errorCallback);
   if (glfwInit() == false)
   {
-    std::cout << "GLFW initialization failed." << std::endl;
+    CORE_LOG_ERROR(CATEGORY_RENDERING, "GLFW initialization failed.");
+    Logger::getInstance().flush();
     system("pause");
     exit(EXIT_FAILURE);
   }
@@ -48,8 +62,9 @@ int main(void)
   window = glfwCreateWindow(width, height, "Hello World", NULL, NULL);
   if (!window)
   {
-    std::cout << "GLFW couldn't create a window." << std::endl;
+    CORE_LOG_ERROR(CATEGORY_RENDERING, "GLFW couldn't create a window.");
     glfwTerminate();
+    Logger::getInstance().flush();
     system("pause");
     exit(EXIT_FAILURE);
   }
@@ -59,14 +74,14 @@ int main(void)
 
   // Make the window's context current
   glfwMakeContextCurrent(window);
-  glfwSwapInterval(0);
 
   // Initialize GLEW
   glewExperimental = GL_TRUE;
   if (glewInit() != GLEW_OK)
   {
-    std::cout << "GLEW initialization failed." << std::endl;
+    CORE_LOG_ERROR(CATEGORY_RENDERING, "GLEW initialization failed.");
     glfwTerminate();
+    Logger::getInstance().flush();
     system("pause");
     exit(EXIT_FAILURE);
   }
@@ -74,8 +89,9 @@ int main(void)
   // Initialize G3dLib
   if (initGL(width, height) == false)
   {
-    std::cout << "G3dLib initialization failed." << std::endl;
+    CORE_LOG_ERROR(CATEGORY_RENDERING, "G3dLib initialization failed.");
     glfwTerminate();
+    Logger::getInstance().flush();
     system("pause");
     exit(EXIT_FAILURE);
   }
@@ -85,6 +101,43 @@ int main(void)
   size_t fpsIndex = 0;
   std::vector<double> fpsVector(100, 0.0);
 
+  // The scene
+  std::unique_ptr<SceneObject> pRoot(new SceneObject());
+
+  // The render thread takes over the context and draws the snapshot of
+  // frame N while this thread already updates frame N+1.
+  glfwMakeContextCurrent(nullptr);
+  bool isContextCurrent = false;
+  std::atomic<bool> isStopping{false};
+  std::unique_ptr<FramePipeline> pPipeline(new FramePipeline(
+      [window, &isContextCurrent,
+       &isStopping](RenderSnapshot const & /*snapshot*/) {
+        if (isStopping)
+        {
+          // the last frame hands the context back before it's destroyed
+          glfwMakeContextCurrent(nullptr);
+          isContextCurrent = false;
+          return;
+        }
+        if (!isContextCurrent)
+        {
+          glfwMakeContextCurrent(window);
+          glfwSwapInterval(0);
+          isContextCurrent = true;
+        }
+        if (isFramebufferResized.exchange(false))
+        {
+          glViewport(0, 0, framebufferWidth, framebufferHeight);
+        }
+
+        // render
+        //pRenderer->render(snapshot);
+
+        // Swap front and back buffers
+        glfwSwapBuffers(window);
+      },
+      true));
+
   // Loop until the user closes the window
   double lastTime = glfwGetTime();
   double currentTime = 0.0;
@@ -95,13 +148,13 @@ int main(void)
     glfwPollEvents();
 
     // update
-    //pRoot->update(deltaTime);
-
-    // render
-    //pRenderer->render(pRoot.get());
+    PhysicsWorld::getInstance().update(deltaTime);
+    pRoot->update(deltaTime);
+    UpdateScheduler::getInstance().update(deltaTime);
+    BehaviorScheduler::getInstance().update(deltaTime);
 
-    // Swap front and back buffers
-    glfwSwapBuffers(window);
+    // hand the frame to the render thread
+    pPipeline->submitFrame();
 
     // Reset inputs
     InputManager::getInstance().resetFrame();
@@ -130,6 +183,12 @@ int main(void)
     std::this_thread::sleep_for(std::chrono::milliseconds(5));
   }
 
+  // The render thread releases the context and is stopped before the
+  // context is destroyed
+  isStopping = true;
+  pPipeline->submitFrame();
+  pPipeline.reset();
+  pRoot.reset();
   glfwTerminate();
-  exit(EXIT_SUCCESS);
+  return EXIT_SUCCESS;
 }
\ No newline at end of file